@@ -57,21 +57,27 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
 #include "getopt.h"
 #include "trace_io_cfg.h"
 #include "trace_io_tcp.h"
+#include "trace_io_ts.h"
+#include "trace_io_map.h"
+#include "trace_io_shm.h"
+#if TRACE_IO_FLUSHER_EN == 1
+#include <pthread.h>
+#endif
 
 /* ----------------------------- Local macros ------------------------------ */
 /* ------------------------------- Constants ------------------------------- */
-/*
- *  \brief
- *  This macro represents the number of timestamp clock ticks per second.
- *  Dividing a count of timestamp ticks by this macro yields the number
- *  of seconds.
- */
-#define BSP_TS_RATE_HZ              CLOCKS_PER_SEC
-
-#define TRACE_CFG_CONSOLE_OPTIONS   "t:f:p:h"
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+#define TRACE_CFG_CONSOLE_OPTIONS   "t:f:p:s:m:x:h"
+#else
+#define TRACE_CFG_CONSOLE_OPTIONS   "t:f:p:s:h"
+#endif
 
 /* ---------------------------- Local data types --------------------------- */
 /* ---------------------------- Global variables --------------------------- */
@@ -83,24 +89,195 @@ static const char *helpMessage =
     "\t -f File name for binary trace output\n"
     "\t -t ipaddr of TCP trace client\n"
     "\t -p port of TCP trace client\n"
+    "\t -s Name of shared memory for trace output, instead of -f and -t\n"
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    "\t -m File name of the flight recorder, whose previous file is kept\n"
+    "\t    with the suffix .1\n"
+    "\t -x Extract the flight recorder file into the -f file and exit\n"
+#endif
     "\t -h (help)\n"
 };
 
 static TRACE_CFG_ST config =
 {
-    "", TCP_TRC_IP_ADDR_DFT, TCP_TRC_PORT_DFT
+    "", TCP_TRC_IP_ADDR_DFT, TCP_TRC_PORT_DFT, TRACE_IO_MAP_NAME_DFT, ""
 };
 
-static FILE *ftbin = NULL;
+static int ftbin = -1;
 static int tsock;
+static int toShm;
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+static RKH_TRC_MAP_T *trcmap;
+#endif
+
+#if TRACE_IO_FLUSHER_EN == 1
+/* 
+ * While the flusher thread writes one buffer, rkh_trc_flush() fills the 
+ * other one. Both are switched by the flusher, under outMutex.
+ */
+static rui8_t buf[2][TRACE_IO_SIZEOF_BUF];
+static int fill;            /* index of the buffer being filled */
+static int nFill;           /* bytes in the buffer being filled */
+static int nOut;            /* bytes being written, 0 if the flusher is idle */
+static int stop;
+static pthread_t flusher;
+static pthread_mutex_t outMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t outCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t takenCond = PTHREAD_COND_INITIALIZER;
+#endif
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+static void
+writeAll(int fd, struct iovec *iov, int cnt)
+{
+    ssize_t n;
+
+    while (cnt != 0)
+    {
+        n = writev(fd, iov, cnt);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;                     /* the trace output is lost */
+        }
+
+        /* skips what was written, it could be part of a block */
+        while ((cnt != 0) && ((size_t)n >= iov->iov_len))
+        {
+            n -= (ssize_t)iov->iov_len;
+            ++iov;
+            --cnt;
+        }
+        if (cnt != 0)
+        {
+            iov->iov_base = (char *)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+}
+
+/* Writes the blocks to the trace file and the socket, in one call each */
+static void
+output(const struct iovec *iov, int cnt)
+{
+    struct iovec pending[2];
+
+    if (ftbin >= 0)
+    {
+        memcpy(pending, iov, cnt * sizeof(struct iovec));
+        writeAll(ftbin, pending, cnt);
+    }
+    memcpy(pending, iov, cnt * sizeof(struct iovec));
+    writeAll(tsock, pending, cnt);
+}
+
+#if TRACE_IO_FLUSHER_EN == 1
+static void *
+flusherThread(void *arg)
+{
+    struct iovec iov;
+
+    (void)arg;
+    pthread_mutex_lock(&outMutex);
+    FOREVER
+    {
+        while ((nFill == 0) && (stop == 0))
+        {
+            pthread_cond_wait(&outCond, &outMutex);
+        }
+        if (nFill == 0)
+        {
+            break;                      /* stopped and nothing left */
+        }
+
+        /* takes the filled buffer, rkh_trc_flush() goes on with the other */
+        nOut = nFill;
+        iov.iov_base = buf[fill];
+        iov.iov_len = (size_t)nOut;
+        fill ^= 1;
+        nFill = 0;
+        pthread_cond_signal(&takenCond);
+
+        pthread_mutex_unlock(&outMutex);
+        output(&iov, 1);
+        pthread_mutex_lock(&outMutex);
+        nOut = 0;
+    }
+    pthread_mutex_unlock(&outMutex);
+    return NULL;
+}
+
+/* 
+ * Copies as much of the trace stream as fits in the buffer being filled, 
+ * leaving the rest in the stream. It must be called with outMutex held. 
+ * Returns true if the stream was emptied.
+ */
+static rbool_t
+fillBuffer(void)
+{
+    rui8_t *blk;
+    TRCQTY_T nbytes;
+    rbool_t empty;
+    RKH_SR_ALLOC();
+
+    empty = RKH_FALSE;
+    RKH_ENTER_CRITICAL_();
+    while ((empty == RKH_FALSE) && (nFill < TRACE_IO_SIZEOF_BUF))
+    {
+        nbytes = (TRCQTY_T)RKH_CFG_TRC_SIZEOF_STREAM;
+        if (nbytes > (TRACE_IO_SIZEOF_BUF - nFill))
+        {
+            nbytes = (TRCQTY_T)(TRACE_IO_SIZEOF_BUF - nFill);
+        }
+        blk = rkh_trc_get_block(&nbytes);
+        if (blk == (rui8_t *)0)
+        {
+            empty = RKH_TRUE;
+        }
+        else
+        {
+            memcpy(&buf[fill][nFill], blk, nbytes);
+            nFill += nbytes;
+        }
+    }
+    RKH_EXIT_CRITICAL_();
+    return empty;
+}
+#endif
+
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+static void
+extract(const char *name)
+{
+    long n;
+
+    if (strlen(config.ftbinName) == 0)
+    {
+        printf("Missing the file of the extracted trace, see -f\n");
+        exit(EXIT_FAILURE);
+    }
+    if ((n = trace_io_map_extract(name, config.ftbinName)) < 0)
+    {
+        printf("Can't extract the flight recorder %s\n", name);
+        exit(EXIT_FAILURE);
+    }
+    printf("%ld bytes extracted into %s\n", n, config.ftbinName);
+    exit(EXIT_SUCCESS);
+}
+#endif
+
 /* ---------------------------- Global functions --------------------------- */
 void
 trace_io_setConfig(int argc, char **argv)
 {
     int c;
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    char *xName = NULL;
+#endif
 
     while ((c = getopt(argc, argv, opts)) != EOF)
         switch (c)
@@ -117,21 +294,66 @@ trace_io_setConfig(int argc, char **argv)
                 config.tcpPort= (short)atoi(optarg);
                 break;
 
+            case 's':
+                strncpy(config.shmName, optarg, FTBIN_NAME_STR_LEN);
+                break;
+
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+            case 'm':
+                strncpy(config.mapName, optarg, FTBIN_NAME_STR_LEN);
+                break;
+
+            case 'x':
+                xName = optarg;
+                break;
+#endif
+
             case '?':
             case 'h':
                 printf(helpMessage);
                 break;
         }
+
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    if (xName != NULL)
+    {
+        extract(xName);
+    }
+#endif
 }
 
 void
 rkh_trc_open(void)
 {
+    rui64_t tsRateHz;
+
+    tsRateHz = trace_io_ts_init();
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    if ((trcmap = trace_io_map_open(config.mapName)) == NULL)
+    {
+        printf("Can't map the flight recorder %s\n", config.mapName);
+        exit(EXIT_FAILURE);
+    }
+    rkh_trcStream_map(trcmap);
+#endif
     rkh_trc_init();
 
+    if (strlen(config.shmName) != 0)
+    {
+        if (trace_io_shm_open(config.shmName, TRACE_IO_SHM_SIZE) < 0)
+        {
+            printf("Can't create shared memory %s\n", config.shmName);
+            exit(EXIT_FAILURE);
+        }
+        toShm = 1;
+        RKH_TRC_SEND_CFG(tsRateHz);
+        return;
+    }
+
     if (strlen(config.ftbinName) != 0)
     {
-        if ((ftbin = fopen(config.ftbinName, "w+b")) == NULL)
+        if ((ftbin = open(config.ftbinName, O_WRONLY | O_CREAT | O_TRUNC, 
+                          0644)) < 0)
         {
             printf("Can't open trace file %s\n", config.ftbinName);
             exit(EXIT_FAILURE);
@@ -145,40 +367,136 @@ rkh_trc_open(void)
         exit(EXIT_FAILURE);
     }
 
-    RKH_TRC_SEND_CFG(BSP_TS_RATE_HZ);
+#if TRACE_IO_FLUSHER_EN == 1
+    stop = 0;
+    if (pthread_create(&flusher, NULL, flusherThread, NULL) != 0)
+    {
+        printf("Can't create the trace flusher thread\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+
+    RKH_TRC_SEND_CFG(tsRateHz);
 }
 
 void
 rkh_trc_close(void)
 {
-    if (ftbin != NULL)
+    if (toShm != 0)
+    {
+        trace_io_shm_flush();
+        trace_io_shm_close(config.shmName);
+        toShm = 0;
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+        trace_io_map_close(trcmap);
+#endif
+        return;
+    }
+
+#if TRACE_IO_FLUSHER_EN == 1
+    /* 
+     * The stream could be longer than a buffer, thus it hands the buffers 
+     * over to the flusher until the stream is empty
+     */
+    pthread_mutex_lock(&outMutex);
+    while (fillBuffer() == RKH_FALSE)
+    {
+        pthread_cond_signal(&outCond);
+        while (nFill != 0)
+        {
+            pthread_cond_wait(&takenCond, &outMutex);
+        }
+    }
+    stop = 1;                           /* it writes what is left and ends */
+    pthread_cond_signal(&outCond);
+    pthread_mutex_unlock(&outMutex);
+    pthread_join(flusher, NULL);
+#endif
+
+    if (ftbin >= 0)
     {
-        fclose(ftbin);
+        close(ftbin);
+        ftbin = -1;
     }
 
     trace_io_tcp_close(tsock);
+
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    trace_io_map_close(trcmap);
+#endif
 }
 
-RKH_TS_T
-rkh_trc_getts(void)
+#if TRACE_IO_FLUSHER_EN == 1
+void
+rkh_trc_flush(void)
 {
-    return (RKH_TS_T)clock();
-}
+    if (toShm != 0)
+    {
+        trace_io_shm_flush();
+        return;
+    }
 
+    /* 
+     * What does not fit in the buffer is left in the stream for the next 
+     * call, then it wakes the flusher up. It never waits for the trace 
+     * output.
+     */
+    pthread_mutex_lock(&outMutex);
+    (void)fillBuffer();
+    if ((nFill != 0) && (nOut == 0))
+    {
+        pthread_cond_signal(&outCond);
+    }
+    pthread_mutex_unlock(&outMutex);
+}
+#else
 void
 rkh_trc_flush(void)
 {
-	rui8_t *d;
+    struct iovec iov;
+    rui8_t out[RKH_CFG_TRC_SIZEOF_STREAM];
+    rui8_t *blk;
+    TRCQTY_T nbytes;
+    int cnt;
+    RKH_SR_ALLOC();
+
+    if (toShm != 0)
+    {
+        trace_io_shm_flush();
+        return;
+    }
 
-	while( ( d = rkh_trc_get() ) != ( rui8_t* )0 )
-	{
-        if (ftbin != NULL)
+    /* 
+     * The blocks taken from the trace stream can be overwritten by new 
+     * records as soon as the critical section ends, thus they are copied 
+     * before, at most two, before and after the end of the stream.
+     */
+    FOREVER
+    {
+        iov.iov_base = out;
+        iov.iov_len = 0;
+        RKH_ENTER_CRITICAL_();
+        for (cnt = 0; cnt < 2; ++cnt)
         {
-            fwrite(d, 1, 1, ftbin);
+            nbytes = (TRCQTY_T)(RKH_CFG_TRC_SIZEOF_STREAM - iov.iov_len);
+            blk = rkh_trc_get_block(&nbytes);
+            if (blk == (rui8_t *)0)
+            {
+                break;
+            }
+            memcpy(&out[iov.iov_len], blk, nbytes);
+            iov.iov_len += nbytes;
         }
-        trace_io_tcp_send(tsock, *d);
-	}
+        RKH_EXIT_CRITICAL_();
+
+        if (iov.iov_len == 0)
+        {
+            break;
+        }
+        output(&iov, 1);
+    }
 }
 #endif
+#endif
 
 /* ------------------------------ File footer ------------------------------ */
@@ -67,12 +67,51 @@ extern "C" {
 #define TCP_TRC_IP_ADDR_DFT         "127.0.0.1"
 #define TCP_TRC_PORT_DFT             6602
 
+/*
+ *  If TRACE_IO_FLUSHER_EN is set to 1, rkh_trc_flush() only copies the 
+ *  trace stream into a buffer, which is written to the file and the socket 
+ *  by a dedicated thread, while the next one is being filled. Otherwise, 
+ *  rkh_trc_flush() writes the trace stream by itself.
+ */
+#define TRACE_IO_FLUSHER_EN         1
+
+/*
+ *  Size [in bytes] of each buffer of the flusher thread.
+ */
+#define TRACE_IO_SIZEOF_BUF         4096
+
+/*
+ *  Source of the trace timestamp, see rkh_trc_getts(). 
+ *  TRACE_IO_TS_MONOTONIC counts nanoseconds of CLOCK_MONOTONIC with a 
+ *  64 bits timestamp, otherwise microseconds. TRACE_IO_TS_TSC counts the 
+ *  time stamp counter of x86 CPUs, whose rate is calibrated against 
+ *  CLOCK_MONOTONIC when the trace is opened.
+ */
+#define TRACE_IO_TS_MONOTONIC       0
+#define TRACE_IO_TS_TSC             1
+#define TRACE_IO_TS_SRC             TRACE_IO_TS_MONOTONIC
+
+/*
+ *  Default file name of the flight recorder, that is, the file mapped 
+ *  into memory as the trace stream if RKH_CFG_TRC_STREAM_MAP_EN is 
+ *  enabled.
+ */
+#define TRACE_IO_MAP_NAME_DFT       "rkhtrc.map"
+
+/*
+ *  Size [in bytes] of the ring of the shared memory segment, a power of 2. 
+ *  See trace_io_shm.h.
+ */
+#define TRACE_IO_SHM_SIZE           1048576ul
+
 /* ------------------------------- Data types ------------------------------ */
 typedef struct
 {
     char ftbinName[FTBIN_NAME_STR_LEN];
     char tcpIpAddr[TCP_IPADDR_STR_LEN];
     short tcpPort;
+    char mapName[FTBIN_NAME_STR_LEN];
+    char shmName[FTBIN_NAME_STR_LEN];
 } TRACE_CFG_ST;
 
 /* -------------------------- External variables --------------------------- */
@@ -0,0 +1,221 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       trace_io_map.c
+ *  \brief      Trace stream mapped into a file for 80x86 OS Linux
+ *
+ *  \ingroup    bsp
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/*
+ *  (1) The file is shared with the page cache of the kernel, which writes 
+ *      it back by itself. Thus, the records survive a crash of the 
+ *      process, such as a signal or a failed assertion, but not a crash 
+ *      of the system.
+ *  (2) The file left by a previous run is the recording of its crash, if 
+ *      any, thus it is kept as the file of the same name followed by 
+ *      TRACE_IO_MAP_PREV_SUFFIX, instead of being overwritten. Only the 
+ *      last previous recording is kept.
+ */
+
+/* ----------------------------- Include files ----------------------------- */
+#define _GNU_SOURCE                     /* ftruncate(), mmap() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rkh.h"
+
+#if ((RKH_CFG_TRC_EN == 1) && (RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED))
+#include "trace_io_map.h"
+
+/* ----------------------------- Local macros ------------------------------ */
+/* ------------------------------- Constants ------------------------------- */
+#define TRACE_IO_MAP_PREV_SUFFIX    ".1"
+
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+static RKH_TRC_MAP_T *
+mapFile(const char *name, int flags, int prot)
+{
+    int fd;
+    void *map;
+
+    if ((fd = open(name, flags, 0644)) < 0)
+    {
+        return (RKH_TRC_MAP_T *)0;
+    }
+    if (((flags & O_CREAT) != 0) && 
+        (ftruncate(fd, (off_t)sizeof(RKH_TRC_MAP_T)) < 0))
+    {
+        close(fd);
+        return (RKH_TRC_MAP_T *)0;
+    }
+    map = mmap(NULL, sizeof(RKH_TRC_MAP_T), prot, MAP_SHARED, fd, 0);
+    close(fd);                          /* the mapping keeps the file */
+    return (map == MAP_FAILED) ? (RKH_TRC_MAP_T *)0 : (RKH_TRC_MAP_T *)map;
+}
+
+/* 
+ * Keeps the recording left by a previous run, see Note (2). Returns 0 if 
+ * there is no recording or it was kept, otherwise -1.
+ */
+static int
+keepPrevious(const char *name)
+{
+    struct stat st;
+    char prev[PATH_MAX];
+    int n;
+
+    if (stat(name, &st) < 0)
+    {
+        return 0;                       /* there is no previous file */
+    }
+    if (st.st_size == 0)
+    {
+        return 0;
+    }
+    n = snprintf(prev, sizeof(prev), "%s" TRACE_IO_MAP_PREV_SUFFIX, name);
+    if ((n < 0) || ((size_t)n >= sizeof(prev)))
+    {
+        return -1;
+    }
+    return rename(name, prev);
+}
+
+/* ---------------------------- Global functions --------------------------- */
+RKH_TRC_MAP_T *
+trace_io_map_open(const char *name)
+{
+    if (keepPrevious(name) < 0)
+    {
+        return (RKH_TRC_MAP_T *)0;
+    }
+    return mapFile(name, O_RDWR | O_CREAT | O_TRUNC, PROT_READ | PROT_WRITE);
+}
+
+void
+trace_io_map_close(RKH_TRC_MAP_T *map)
+{
+    msync(map, sizeof(RKH_TRC_MAP_T), MS_SYNC);
+    munmap(map, sizeof(RKH_TRC_MAP_T));
+}
+
+long
+trace_io_map_extract(const char *name, const char *out)
+{
+    struct stat st;
+    RKH_TRC_MAP_T *map;
+    rui8_t *stm, *first, *last;
+    rui32_t n;
+    FILE *f;
+    long nOut;
+
+    if ((stat(name, &st) < 0) || 
+        ((size_t)st.st_size != sizeof(RKH_TRC_MAP_T)) ||
+        ((map = mapFile(name, O_RDONLY, PROT_READ)) == (RKH_TRC_MAP_T *)0))
+    {
+        return -1;
+    }
+    if ((map->magic != RKH_TRC_MAP_MAGIC) || 
+        (map->size != RKH_CFG_TRC_SIZEOF_STREAM) || 
+        (map->head >= RKH_CFG_TRC_SIZEOF_STREAM))
+    {
+        munmap(map, sizeof(RKH_TRC_MAP_T));
+        return -1;
+    }
+
+    /* puts the bytes in order, the oldest ones follow the head */
+    stm = (rui8_t *)malloc(RKH_CFG_TRC_SIZEOF_STREAM);
+    if (stm == (rui8_t *)0)
+    {
+        munmap(map, sizeof(RKH_TRC_MAP_T));
+        return -1;
+    }
+    n = 0;
+    if (map->lap != 0)
+    {
+        n = RKH_CFG_TRC_SIZEOF_STREAM - map->head;
+        memcpy(stm, &map->stream[map->head], n);
+    }
+    memcpy(&stm[n], map->stream, map->head);
+    n += map->head;
+    munmap(map, sizeof(RKH_TRC_MAP_T));
+
+    /* leaves out the pieces of records at both ends */
+    first = memchr(stm, RKH_FLG, n);
+    last = &stm[n];
+    while ((last != stm) && (*(last - 1) != RKH_FLG))
+    {
+        --last;
+    }
+
+    nOut = -1;
+    if ((f = fopen(out, "wb")) != NULL)
+    {
+        nOut = 0;
+        if ((first != NULL) && (first < last))
+        {
+            nOut = (long)fwrite(first, 1, (size_t)(last - first), f);
+        }
+        if (fclose(f) != 0)
+        {
+            nOut = -1;
+        }
+    }
+    free(stm);
+    return nOut;
+}
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
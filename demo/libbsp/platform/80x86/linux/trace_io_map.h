@@ -0,0 +1,119 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       trace_io_map.h
+ *  \brief      Trace stream mapped into a file for 80x86 OS Linux
+ *
+ *  \ingroup    bsp
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Module -------------------------------- */
+#ifndef __TRACE_IO_MAP_H__
+#define __TRACE_IO_MAP_H__
+
+/* ----------------------------- Include files ----------------------------- */
+#include "rkh.h"
+
+/* ---------------------- External C language linkage ---------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------------- Macros -------------------------------- */
+/* -------------------------------- Constants ------------------------------ */
+/* ------------------------------- Data types ------------------------------ */
+/* -------------------------- External variables --------------------------- */
+/* -------------------------- Function prototypes -------------------------- */
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Creates the file of the flight recorder and maps it into memory, as 
+ *  the memory of the trace stream. The records written into the stream 
+ *  remain in the file after the process ends, even if it crashes, without 
+ *  writing them explicitly. A previous non-empty file, which could hold 
+ *  the recording of a crash, is renamed after its name followed by ".1" 
+ *  before, replacing the one of an older run.
+ *
+ *  \param[in] name	file name.
+ *
+ *  \return
+ *  Pointer to the mapped memory, or NULL if it could not be created or 
+ *  the previous file could not be kept.
+ */
+RKH_TRC_MAP_T *trace_io_map_open(const char *name);
+
+/**
+ *  \brief
+ *  Writes the mapped memory back to its file and unmaps it.
+ *
+ *  \param[in] map	pointer returned by trace_io_map_open().
+ */
+void trace_io_map_close(RKH_TRC_MAP_T *map);
+
+/**
+ *  \brief
+ *  Extracts the most recent records kept in a flight recorder file, as 
+ *  a trace stream in the usual format, from its first flag byte to its 
+ *  last one. The file must be written by a program built with the same 
+ *  trace configuration.
+ *
+ *  \param[in] name	file name of the flight recorder.
+ *  \param[in] out	file name of the extracted trace stream.
+ *
+ *  \return
+ *  Number of extracted bytes, or -1 if the file is not valid or the 
+ *  stream could not be written.
+ */
+long trace_io_map_extract(const char *name, const char *out);
+#endif
+
+/* -------------------- External C language linkage end -------------------- */
+#ifdef __cplusplus
+}
+#endif
+
+/* ------------------------------ Module end ------------------------------- */
+#endif
+
+/* ------------------------------ File footer ------------------------------ */
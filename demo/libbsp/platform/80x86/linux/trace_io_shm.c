@@ -0,0 +1,282 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       trace_io_shm.c
+ *  \brief      Trace output through shared memory for 80x86 OS Linux
+ *
+ *  \ingroup    bsp
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/*
+ *  (1) See the layout of the segment in trace_io_shm.h. The head and the 
+ *      tail are accessed by means of the __atomic built-in functions of 
+ *      GCC, since there is no other way of ordering the memory accesses 
+ *      of two processes in C89.
+ *  (2) A segment is taken over only if it is ready and its producer is 
+ *      not running, since the one that is still being created by another 
+ *      producer has no magic yet. The consumers attached to a segment 
+ *      taken over keep reading the removed one.
+ */
+
+/* ----------------------------- Include files ----------------------------- */
+#define _GNU_SOURCE                     /* shm_open(), ftruncate(), mmap() */
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rkh.h"
+
+#if RKH_CFG_TRC_EN == 1
+#include "trace_io_shm.h"
+
+/* ----------------------------- Local macros ------------------------------ */
+#define RING(shm_)          ((rui8_t *)((shm_) + 1))
+#define LOAD(p_)            __atomic_load_n((p_), __ATOMIC_ACQUIRE)
+#define STORE(p_, v_)       __atomic_store_n((p_), (v_), __ATOMIC_RELEASE)
+
+/* ------------------------------- Constants ------------------------------- */
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+static TRACE_IO_SHM_T *shmOut;
+static rui64_t head;        /* written within the critical section */
+
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+static TRACE_IO_SHM_T *
+mapSegment(int fd, size_t size, int prot)
+{
+    void *shm;
+
+    shm = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+    close(fd);                          /* the mapping keeps the segment */
+    return (shm == MAP_FAILED) ? (TRACE_IO_SHM_T *)0 : (TRACE_IO_SHM_T *)shm;
+}
+
+/* True if the segment was left by a producer that is not running */
+static rbool_t
+isStale(const char *name)
+{
+    int fd;
+    struct stat st;
+    TRACE_IO_SHM_T *shm;
+    rbool_t stale;
+
+    if ((fd = shm_open(name, O_RDONLY, 0)) < 0)
+    {
+        return (rbool_t)(errno == ENOENT);  /* it has just been removed */
+    }
+    if ((fstat(fd, &st) < 0) || 
+        ((size_t)st.st_size < sizeof(TRACE_IO_SHM_T)))
+    {
+        close(fd);
+        return RKH_FALSE;
+    }
+    if ((shm = mapSegment(fd, sizeof(TRACE_IO_SHM_T), PROT_READ)) == 
+        (TRACE_IO_SHM_T *)0)
+    {
+        return RKH_FALSE;
+    }
+    stale = (rbool_t)((LOAD(&shm->magic) == TRACE_IO_SHM_MAGIC) &&  /* (2) */
+                      (kill((pid_t)shm->pid, 0) < 0) && (errno == ESRCH));
+    munmap(shm, sizeof(TRACE_IO_SHM_T));
+    return stale;
+}
+
+/* ---------------------------- Global functions --------------------------- */
+int
+trace_io_shm_open(const char *name, rui32_t size)
+{
+    int fd;
+    size_t len;
+
+    if ((size == 0) || ((size & (size - 1)) != 0))
+    {
+        return -1;
+    }
+
+    len = sizeof(TRACE_IO_SHM_T) + size;
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if ((fd < 0) && (errno == EEXIST) && isStale(name))
+    {
+        shm_unlink(name);               /* left by a dead producer */
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)len) < 0)
+    {
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    if ((shmOut = mapSegment(fd, len, PROT_READ | PROT_WRITE)) == 
+        (TRACE_IO_SHM_T *)0)
+    {
+        shm_unlink(name);
+        return -1;
+    }
+
+    /* a new segment is filled with zeros */
+    head = 0;
+    shmOut->size = size;
+    shmOut->pid = (rui64_t)getpid();
+    STORE(&shmOut->magic, TRACE_IO_SHM_MAGIC);
+    return 0;
+}
+
+void
+trace_io_shm_flush(void)
+{
+    rui8_t *blk;
+    TRCQTY_T nbytes;
+    rui32_t room, pos, nTail;
+    RKH_SR_ALLOC();
+
+    /* 
+     * Takes from the trace stream only what fits into the ring, the rest 
+     * waits there for the consumer. Since several threads can flush the 
+     * trace, the room is computed from the head they share within the 
+     * critical section.
+     */
+    RKH_ENTER_CRITICAL_();
+    room = (rui32_t)(shmOut->size - (head - LOAD(&shmOut->tail)));
+    while (room != 0)
+    {
+        nbytes = (room > RKH_CFG_TRC_SIZEOF_STREAM) ? 
+                     (TRCQTY_T)RKH_CFG_TRC_SIZEOF_STREAM : (TRCQTY_T)room;
+        blk = rkh_trc_get_block(&nbytes);
+        if (blk == (rui8_t *)0)
+        {
+            break;
+        }
+
+        pos = (rui32_t)(head & (shmOut->size - 1));
+        nTail = (rui32_t)(shmOut->size - pos);
+        if (nTail > nbytes)
+        {
+            nTail = nbytes;
+        }
+        memcpy(&RING(shmOut)[pos], blk, nTail);
+        memcpy(RING(shmOut), &blk[nTail], nbytes - nTail);
+        head += nbytes;
+        room -= nbytes;
+    }
+    STORE(&shmOut->head, head);
+    RKH_EXIT_CRITICAL_();
+}
+
+void
+trace_io_shm_close(const char *name)
+{
+    munmap(shmOut, sizeof(TRACE_IO_SHM_T) + shmOut->size);
+    shm_unlink(name);
+}
+
+TRACE_IO_SHM_T *
+trace_io_shm_attach(const char *name)
+{
+    int fd;
+    struct stat st;
+    TRACE_IO_SHM_T *shm;
+
+    if ((fd = shm_open(name, O_RDWR, 0)) < 0)
+    {
+        return (TRACE_IO_SHM_T *)0;
+    }
+    if ((fstat(fd, &st) < 0) || 
+        ((size_t)st.st_size <= sizeof(TRACE_IO_SHM_T)))
+    {
+        close(fd);
+        return (TRACE_IO_SHM_T *)0;
+    }
+    if ((shm = mapSegment(fd, (size_t)st.st_size, PROT_READ | PROT_WRITE)) 
+        == (TRACE_IO_SHM_T *)0)
+    {
+        return (TRACE_IO_SHM_T *)0;
+    }
+    if ((LOAD(&shm->magic) != TRACE_IO_SHM_MAGIC) || 
+        ((sizeof(TRACE_IO_SHM_T) + shm->size) != (size_t)st.st_size))
+    {
+        munmap(shm, (size_t)st.st_size);
+        return (TRACE_IO_SHM_T *)0;
+    }
+    return shm;
+}
+
+rui32_t
+trace_io_shm_read(TRACE_IO_SHM_T *shm, rui8_t *buf, rui32_t n)
+{
+    rui64_t tail, pending;
+    rui32_t pos, nTail;
+
+    tail = shm->tail;                   /* the consumer is the only writer */
+    pending = LOAD(&shm->head) - tail;
+    if (n > pending)
+    {
+        n = (rui32_t)pending;
+    }
+
+    pos = (rui32_t)(tail & (shm->size - 1));
+    nTail = (rui32_t)(shm->size - pos);
+    if (nTail > n)
+    {
+        nTail = n;
+    }
+    memcpy(buf, &RING(shm)[pos], nTail);
+    memcpy(&buf[nTail], RING(shm), n - nTail);
+
+    STORE(&shm->tail, tail + n);
+    return n;
+}
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
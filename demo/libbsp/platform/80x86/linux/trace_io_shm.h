@@ -0,0 +1,182 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       trace_io_shm.h
+ *  \brief      Trace output through shared memory for 80x86 OS Linux
+ *
+ *  \ingroup    bsp
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/*
+ *  Layout of the shared memory segment
+ *  -----------------------------------
+ *
+ *  The segment is a POSIX shared memory object, /dev/shm/<name>, which 
+ *  holds a ring of trace bytes written by one process (the producer) and 
+ *  read by another one (the consumer). All fields are 64 bits unsigned 
+ *  integers in the byte order of the host.
+ *
+ *  Offset  Field   Written by  Description
+ *  ------  ------  ----------  ---------------------------------------------
+ *       0  magic   producer    TRACE_IO_SHM_MAGIC once the segment is ready
+ *       8  size    producer    Size of the ring in bytes, a power of 2
+ *      16  pid     producer    Process ID of the producer
+ *      64  head    producer    Number of bytes ever written into the ring
+ *     128  tail    consumer    Number of bytes ever read from the ring
+ *     192  ring    producer    Trace bytes, in the format of the stream
+ *
+ *  The byte number i of the stream is at ring[i % size]. The bytes from 
+ *  tail to head are pending, and the producer never writes over them, 
+ *  thus a slow consumer does not corrupt the stream, the trace records 
+ *  are kept in the trace stream instead. head and tail are on their own 
+ *  cache lines.
+ *
+ *  The producer writes the bytes and then stores head with release 
+ *  semantics. The consumer loads head with acquire semantics, reads the 
+ *  pending bytes and then stores tail with release semantics. Neither 
+ *  side makes a system call nor waits for the other one, thus the 
+ *  consumer polls head.
+ */
+
+/* --------------------------------- Module -------------------------------- */
+#ifndef __TRACE_IO_SHM_H__
+#define __TRACE_IO_SHM_H__
+
+/* ----------------------------- Include files ----------------------------- */
+#include "rkh.h"
+
+/* ---------------------- External C language linkage ---------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------------- Macros -------------------------------- */
+/* -------------------------------- Constants ------------------------------ */
+/* "RKHTRSHM" */
+#define TRACE_IO_SHM_MAGIC          0x4D48535254484B52ull
+
+/* ------------------------------- Data types ------------------------------ */
+/*
+ *  Header of the shared memory segment, the ring follows it.
+ */
+typedef struct TRACE_IO_SHM_T
+{
+    rui64_t magic;
+    rui64_t size;
+    rui64_t pid;
+    rui8_t pad0[40];
+    rui64_t head;
+    rui8_t pad1[56];
+    rui64_t tail;
+    rui8_t pad2[56];
+} TRACE_IO_SHM_T;
+
+/* -------------------------- External variables --------------------------- */
+/* -------------------------- Function prototypes -------------------------- */
+/**
+ *  \brief
+ *  Creates the shared memory segment of the trace output, as the 
+ *  producer. A previous segment of the same name is replaced only if 
+ *  its producer is no longer running.
+ *
+ *  \param[in] name	name of the segment, such as "/rkhtrc".
+ *  \param[in] size	size of the ring in bytes, a power of 2.
+ *
+ *  \return
+ *  0 if the segment was created, otherwise -1, such as when another 
+ *  running producer owns the segment.
+ */
+int trace_io_shm_open(const char *name, rui32_t size);
+
+/**
+ *  \brief
+ *  Moves the trace stream into the ring, as much as it is free. It makes 
+ *  no system call.
+ */
+void trace_io_shm_flush(void);
+
+/**
+ *  \brief
+ *  Removes the shared memory segment. The consumers attached to it can 
+ *  read the pending bytes.
+ *
+ *  \param[in] name	name of the segment.
+ */
+void trace_io_shm_close(const char *name);
+
+/**
+ *  \brief
+ *  Attaches to the shared memory segment of a producer, as the consumer.
+ *
+ *  \param[in] name	name of the segment.
+ *
+ *  \return
+ *  Pointer to the segment, or NULL if it does not exist or it is not 
+ *  ready.
+ */
+TRACE_IO_SHM_T *trace_io_shm_attach(const char *name);
+
+/**
+ *  \brief
+ *  Reads the pending bytes of the ring, as the consumer.
+ *
+ *  \param[in] shm	pointer returned by trace_io_shm_attach().
+ *  \param[in] buf	buffer to store the read bytes.
+ *  \param[in] n		size of the buffer.
+ *
+ *  \return
+ *  Number of read bytes, 0 if there is no pending byte.
+ */
+rui32_t trace_io_shm_read(TRACE_IO_SHM_T *shm, rui8_t *buf, rui32_t n);
+
+/* -------------------- External C language linkage end -------------------- */
+#ifdef __cplusplus
+}
+#endif
+
+/* ------------------------------ Module end ------------------------------- */
+#endif
+
+/* ------------------------------ File footer ------------------------------ */
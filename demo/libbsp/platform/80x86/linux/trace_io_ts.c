@@ -0,0 +1,153 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       trace_io_ts.c
+ *  \brief      High resolution trace timestamp for 80x86 OS Linux
+ *
+ *  \ingroup    bsp
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/*
+ *  (1) The timestamp wraps around as any other one, thus only the 
+ *      difference between two timestamps is meaningful. The 32 bits 
+ *      timestamp of microseconds wraps around every 71 minutes.
+ *  (2) The time stamp counter of the current x86 CPUs runs at a constant 
+ *      rate, regardless of the frequency scaling of the cores.
+ */
+
+/* ----------------------------- Include files ----------------------------- */
+#define _GNU_SOURCE                     /* clock_gettime(), nanosleep() */
+#include <time.h>
+
+#include "rkh.h"
+
+#if RKH_CFG_TRC_EN == 1
+#include "trace_io_cfg.h"
+#include "trace_io_ts.h"
+#if TRACE_IO_TS_SRC == TRACE_IO_TS_TSC
+#include <x86intrin.h>
+#endif
+
+/* ----------------------------- Local macros ------------------------------ */
+/* ------------------------------- Constants ------------------------------- */
+#define NSEC_PER_SEC                1000000000ul
+
+#if TRACE_IO_TS_SRC == TRACE_IO_TS_TSC
+    #if !defined(__i386__) && !defined(__x86_64__)
+    #error "TRACE_IO_TS_TSC requires a x86 CPU"
+    #endif
+
+    /* 
+     * Right shift of the counter, thus a 32 bits timestamp wraps around 
+     * every several minutes instead of every second
+     */
+    #if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+        #define TSC_SHIFT           0
+    #else
+        #define TSC_SHIFT           10
+    #endif
+
+    /* Interval to calibrate the counter rate [in nanoseconds] */
+    #define TSC_CAL_NSEC            20000000ul
+#elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+    #define TS_RATE_HZ              NSEC_PER_SEC
+#else
+    #define TS_RATE_HZ              1000000ul
+#endif
+
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+#if TRACE_IO_TS_SRC == TRACE_IO_TS_TSC
+static rui64_t
+nsec(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((rui64_t)t.tv_sec * NSEC_PER_SEC) + (rui64_t)t.tv_nsec;
+}
+#endif
+
+/* ---------------------------- Global functions --------------------------- */
+rui64_t
+trace_io_ts_init(void)
+{
+#if TRACE_IO_TS_SRC == TRACE_IO_TS_TSC
+    struct timespec d;
+    rui64_t t0, c0, t1, c1;
+
+    /* measures the rate of the counter against CLOCK_MONOTONIC */
+    d.tv_sec = 0;
+    d.tv_nsec = TSC_CAL_NSEC;
+    t0 = nsec();
+    c0 = __rdtsc();
+    nanosleep(&d, NULL);
+    t1 = nsec();
+    c1 = __rdtsc();
+    return (((c1 - c0) * NSEC_PER_SEC) / (t1 - t0)) >> TSC_SHIFT;
+#else
+    return TS_RATE_HZ;
+#endif
+}
+
+RKH_TS_T
+rkh_trc_getts(void)
+{
+#if TRACE_IO_TS_SRC == TRACE_IO_TS_TSC
+    return (RKH_TS_T)(__rdtsc() >> TSC_SHIFT);
+#else
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (RKH_TS_T)(((RKH_TS_T)t.tv_sec * TS_RATE_HZ) + 
+                      ((RKH_TS_T)t.tv_nsec / (NSEC_PER_SEC / TS_RATE_HZ)));
+#endif
+}
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
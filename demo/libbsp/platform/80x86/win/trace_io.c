@@ -175,6 +175,9 @@ rkh_trc_flush(void)
         nbytes = 128;
 
         RKH_ENTER_CRITICAL_();
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+        rkh_trc_merge();
+#endif
         blk = rkh_trc_get_block(&nbytes);
         RKH_EXIT_CRITICAL_();
 
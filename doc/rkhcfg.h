@@ -113,6 +113,97 @@ extern "C" {
  */
 #define RKH_CFG_FWK_MAX_EVT_POOL        0u
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_FWK_EVT_SCLASS_EN is set to 1 then the event pool
+ *  registration builds a size-class table, so that rkh_fwk_ae() finds the
+ *  best-fit pool with one array load instead of scanning the pool list.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_FWK_EVT_SCLASS_EN       RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the granularity [in bytes] of the event size classes.
+ *  See #RKH_CFG_FWK_EVT_SCLASS_EN.
+ *
+ *  \type       Integer
+ *  \range      [1..255]
+ *  \default    8
+ */
+#define RKH_CFG_FWK_EVT_SCLASS_GRAN     8u
+
+/**
+ *  \brief
+ *  Specify the number of event size classes. Events greater than
+ *  #RKH_CFG_FWK_EVT_SCLASS_NUM * #RKH_CFG_FWK_EVT_SCLASS_GRAN bytes are
+ *  looked up by scanning the remaining pools.
+ *  See #RKH_CFG_FWK_EVT_SCLASS_EN.
+ *
+ *  \type       Integer
+ *  \range      [1..255]
+ *  \default    32
+ */
+#define RKH_CFG_FWK_EVT_SCLASS_NUM      32u
+
+/**
+ *  \brief
+ *  If the buffer manager is enabled (RKH_ENABLED) then RKH allows to
+ *  allocate buffer-descriptor events, whose large payload lives in a
+ *  separately refcounted buffer, allocated from a set of size-classed
+ *  buffer pools. Thus, forwarding, publishing or deferring them shares
+ *  the payload instead of copying it. It requires
+ *  RKH_CFG_FWK_DYN_EVT_EN and RKH_CFG_MP_EN.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_FWK_BUF_EN              RKH_DISABLED
+
+/**
+ *  \brief
+ *  If the buffer manager is enabled (RKH_ENABLED), this macro
+ *  determines the maximum number of buffer pools to be registered by
+ *  means of rkh_buf_registerPool().
+ *
+ *  \type       Integer
+ *  \range      [1..255]
+ *  \default    4
+ */
+#define RKH_CFG_FWK_MAX_BUF_POOL        4u
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_FWK_EVT_AFFINITY_EN is set to 1 then RKH allows to
+ *  register local event pools bound to an active object or a worker
+ *  core, by means of rkh_fwk_registerLocalEvtPool(). Thus,
+ *  rkh_fwk_ae() prefers the local pools of its caller, and
+ *  rkh_fwk_gc() returns each block to its origin pool. The port must
+ *  provide rkh_fwk_getAffinity().
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_FWK_EVT_AFFINITY_EN     RKH_DISABLED
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_FWK_EVT_AFFINITY_EN is set to 1, this macro
+ *  determines the maximum number of local event pools to be
+ *  registered, in addition to the #RKH_CFG_FWK_MAX_EVT_POOL global
+ *  ones.
+ *
+ *  \type       Integer
+ *  \range      [1..254]
+ *  \default    4
+ */
+#define RKH_CFG_FWK_MAX_LOCAL_EVT_POOL  4u
+
 /**
  *  \brief
  *  Specify the size of the event signal. The valid values [in bits] are
@@ -150,6 +241,33 @@ extern "C" {
  */
 #define RKH_CFG_FWK_SIZEOF_EVT_SIZE     8u
 
+/**
+ *  \brief
+ *  Specify the size of the reference counter of dynamic events. The
+ *  valid values [in bits] are 8, 16 or 32. Default is 8. See #RKH_NREF_T
+ *  type. Widen it when an event can be published to many subscribers
+ *  and deferred at the same time.
+ *
+ *  \type       Integer
+ *  \range      [8, 16, 32]
+ *  \default    8
+ */
+#define RKH_CFG_FWK_SIZEOF_NREF         8u
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_FWK_ATOMIC_NREF_EN is set to 1 then the reference
+ *  counter of dynamic events is changed by means of atomic operations,
+ *  see RKH_NREF_INC() and RKH_NREF_DEC(), instead of the critical section.
+ *  Thus, rkh_fwk_gc() and rkh_fwk_reserve() do not serialize on the
+ *  global lock in multi-thread ports.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_FWK_ATOMIC_NREF_EN      RKH_DISABLED
+
 /**
  *  \brief
  *  If the #RKH_CFG_FWK_DEFER_EVT_EN is set to 1 and the dynamic event
@@ -200,6 +318,60 @@ extern "C" {
  */
 #define RKH_CFG_FWK_MAX_SUBS_CHANNELS   16
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_FWK_TOPIC_EN is set to 1 then the publish-subscribe
+ *  module includes the topic registry. Topics are identified by 16 or
+ *  32-bit IDs, are hashed into a table of buckets and only cost memory
+ *  when subscribed. Each subscription is a node provided by the
+ *  application, thus any number of subscriptions is allowed, and it
+ *  can match a single topic or a whole prefix of topics.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_FWK_TOPIC_EN            RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the size of the topic ID in bits when the topic registry
+ *  is enabled. See #RKH_CFG_FWK_TOPIC_EN.
+ *
+ *  \type       Enumerated
+ *  \range      16, 32
+ *  \default    16
+ */
+#define RKH_CFG_FWK_SIZEOF_TOPIC        16
+
+/**
+ *  \brief
+ *  Specify the number of buckets of the topic registry as a power of
+ *  two, 2^RKH_CFG_FWK_TOPIC_HASH_BITS. Publishing a topic only visits
+ *  the subscriptions hashed into its bucket and the prefix ones, thus
+ *  it should be sized according to the number of subscribed topics.
+ *  See #RKH_CFG_FWK_TOPIC_EN.
+ *
+ *  \type       Integer
+ *  \range      [1..16]
+ *  \default    6u
+ */
+#define RKH_CFG_FWK_TOPIC_HASH_BITS     6u
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_FWK_PUBSUB_FILTER_EN is set to 1 then a subscription
+ *  can carry a content filter, a signal range and an optional
+ *  predicate, which is evaluated when the event is published. Thus,
+ *  rejected events are never posted to the subscriber. It costs a
+ *  filter pointer per channel and active object.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_FWK_PUBSUB_FILTER_EN    RKH_DISABLED
+
 /**
  *  \brief
  *  If the #RKH_CFG_HOOK_DISPATCH_EN is set to 1, RKH will invoke the
@@ -303,6 +475,31 @@ extern "C" {
  */
 #define RKH_CFG_HOOK_PUT_TRCEVT_EN        RKH_DISABLED
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_HOOK_EVTPOOL_LOW_EN is set to 1, RKH will invoke the
+ *  rkh_hook_evtPoolLow() function when an allocation leaves an event pool
+ *  with exactly #RKH_CFG_HOOK_EVTPOOL_LOW_NFREE free blocks, thus the
+ *  application can shed load before the pool runs out.
+ *  When this is set the application must provide the hook function.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_HOOK_EVTPOOL_LOW_EN     RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the number of free blocks of an event pool that triggers the
+ *  rkh_hook_evtPoolLow() function. See #RKH_CFG_HOOK_EVTPOOL_LOW_EN.
+ *
+ *  \type       Integer
+ *  \range      [0..2^32-1]
+ *  \default    1
+ */
+#define RKH_CFG_HOOK_EVTPOOL_LOW_NFREE  1u
+
 /**
  *  \brief
  *  Specify the frequency of the framework tick interrupt (number of ticks
@@ -336,6 +533,21 @@ extern "C" {
  */
 #define RKH_CFG_SMA_GET_INFO_EN         RKH_ENABLED
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_SMA_SCRATCH_EN is set to 1 then each active object
+ *  can own a scratch arena, from which short-lived events are
+ *  allocated by bumping a pointer, by means of RKH_ALLOC_SCRATCH_EVT().
+ *  The arena is released all at once when the active object completes
+ *  its RTC steps, i.e. its event queue becomes empty. It requires
+ *  RKH_CFGPORT_NATIVE_EQUEUE_EN.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_SMA_SCRATCH_EN          RKH_DISABLED
+
 /**
  *  \brief
  *  If the #RKH_CFG_SMA_PPRO_EN is set to 1 then RKH allows to reference a
@@ -999,6 +1211,149 @@ extern "C" {
  */
 #define RKH_CFG_TRC_SIZEOF_STREAM       128u
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_TRC_BLOCK_ENC_EN is set to 1 then the trace record
+ *  fields are stored in a small record buffer, which is escaped and
+ *  checksummed in a single pass and then committed to the trace
+ *  stream as a block, instead of putting every byte into the stream
+ *  one at a time. The stream format does not change.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_BLOCK_ENC_EN        RKH_DISABLED
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_TRC_LOCAL_EN is set to 1 then each active object
+ *  writes its trace records into its own lane, a small ring written
+ *  without locking, and the records of the remaining threads go to a
+ *  shared lane. The flusher merges the lanes in timestamp order into
+ *  the trace stream by means of rkh_trc_merge(), thus the stream
+ *  format does not change. It requires a multi-thread port, which
+ *  provides rkh_trc_getLane(). Currently, only the win32_mt port
+ *  does it.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_LOCAL_EN            RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the size [in bytes] of every trace lane, see
+ *  #RKH_CFG_TRC_LOCAL_EN. A record that does not fit in its lane
+ *  is discarded as a whole.
+ *
+ *  \type       Integer
+ *  \range      [16..32768]
+ *  \default    128
+ */
+#define RKH_CFG_TRC_SIZEOF_LOCAL_STREAM 128u
+
+/**
+ *  \brief
+ *  Overflow policy of the trace stream, which admits or discards
+ *  whole records. If the #RKH_CFG_TRC_OVF_DROP_NEWEST_EN is set to 1
+ *  then a record that does not fit into the stream is discarded,
+ *  otherwise the oldest records are removed to make room for it.
+ *  In both cases the lost records are counted and reported by
+ *  means of a RKH_TE_FWK_TRCLOST record.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_OVF_DROP_NEWEST_EN  RKH_DISABLED
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_TRC_STREAM_MAP_EN is set to 1 then the memory
+ *  of the trace stream is provided by the platform by means of
+ *  rkh_trcStream_map(), such as a file mapped into memory on a
+ *  hosted system. A header at the beginning of that memory keeps
+ *  the position of the stream, thus its most recent records can
+ *  be recovered after a crash. See RKH_TRC_MAP_T. In this case
+ *  #RKH_CFG_TRC_SIZEOF_STREAM can be larger than 2048 bytes.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_STREAM_MAP_EN       RKH_DISABLED
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_TRC_COMPACT_EN is set to 1 then RKH will use the
+ *  compact encoding of the trace records. The timestamp is sent as
+ *  the LEB128 varint of its difference from the previous record,
+ *  signals and addresses as LEB128 varints, and the objects already
+ *  sent as symbols as small interned IDs. It requires
+ *  #RKH_CFG_TRC_NSEQ_EN, since the timestamp is absolute in the
+ *  records whose sequence number is 0.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_COMPACT_EN          RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the maximum number of symbols interned by the compact
+ *  encoding, see #RKH_CFG_TRC_COMPACT_EN. It must be a power of 2.
+ *  The objects that do not fit are sent by their address.
+ *
+ *  \type       Integer
+ *  \range      [8..256]
+ *  \default    32
+ */
+#define RKH_CFG_TRC_SIZEOF_SYMTBL       32u
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_TRC_SYMDICT_EN is set to 1 then the symbols
+ *  registered before the framework starts, such as objects, signals,
+ *  active objects and states, are collected into a dictionary
+ *  instead of being sent and flushed one by one. The dictionary is
+ *  sent as a few RKH_TE_FWK_SYMDICT records, see RKH_TR_FWK_SYMDICT().
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_SYMDICT_EN          RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the maximum number of symbols collected into the
+ *  dictionary, see #RKH_CFG_TRC_SYMDICT_EN. They are sent in as many
+ *  RKH_TE_FWK_SYMDICT records as needed to fit into the trace stream.
+ *
+ *  \type       Integer
+ *  \range      [1..255]
+ *  \default    32
+ */
+#define RKH_CFG_TRC_SIZEOF_SYMDICT      32u
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_TRC_PROFILE_EN is set to 1 then the trace
+ *  records are pruned at compile time according to the filter
+ *  profile of the application, the \c rkhtrcprof.h file. The records
+ *  left out by the profile are removed by the compiler, and the
+ *  remaining ones only check the runtime filters if
+ *  #RKH_CFG_TRC_RTFIL_EN is set to 1. See RKH_TRC_PROFILE_ISON().
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_TRC_PROFILE_EN          RKH_DISABLED
+
 /** @} doxygen end group definition */
 
 /**
@@ -1118,6 +1473,20 @@ extern "C" {
  */
 #define RKH_CFG_QUE_PUT_LIFO_EN          RKH_ENABLED
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_QUE_OVF_POLICY_EN is set to 1 then RKH allows to
+ *  attach an overflow policy (drop-newest, drop-oldest or bounded
+ *  blocking) and a high-watermark callback to every queue, instead of
+ *  raising an assertion when it becomes full.
+ *  See rkh_queue_setOverflow() and rkh_queue_setHighWmark() functions.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_QUE_OVF_POLICY_EN       RKH_DISABLED
+
 /** @} doxygen end group definition */
 
 /**
@@ -1170,6 +1539,18 @@ extern "C" {
  */
 #define RKH_CFG_MP_SIZEOF_NBLOCK        8u
 
+/**
+ *  \brief
+ *  Specify size of the memory pool storage size. The valid values [in
+ *  bits] are 16 or 32. Default is 16, which limits a pool to 64 KB.
+ *  See #RKH_MPSS_T type.
+ *
+ *  \type       Integer
+ *  \range      [16, 32]
+ *  \default    16
+ */
+#define RKH_CFG_MP_SIZEOF_SSIZE         16u
+
 /**
  *  \brief
  *  If the #RKH_CFG_MP_GET_BSIZE_EN is set to 1 then RKH will include the
@@ -1221,6 +1602,50 @@ extern "C" {
  */
 #define RKH_CFG_MP_GET_INFO_EN          RKH_ENABLED
 
+/**
+ *  \brief
+ *  If the #RKH_CFG_MP_MAG_EN is set to 1 then every memory pool keeps
+ *  a magazine (a small LIFO stash of free blocks) per active object
+ *  thread, refilled and drained in batches from the shared free list.
+ *  Thus, most of allocations are thread-local and do not enter the
+ *  critical section. It is only useful on multi-thread ports, which
+ *  must provide rkh_memPool_getMagSlot().
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_MP_MAG_EN               RKH_DISABLED
+
+/**
+ *  \brief
+ *  Specify the maximum number of blocks held in each magazine. Half of
+ *  it is moved from or to the shared free list at once.
+ *  See #RKH_CFG_MP_MAG_EN.
+ *
+ *  \type       Integer
+ *  \range      [2, 255]
+ *  \default    8u
+ */
+#define RKH_CFG_MP_MAG_SIZE             8u
+
+/**
+ *  \brief
+ *  If the #RKH_CFG_MP_LOCKFREE_EN is set to 1 then the free list of
+ *  every memory pool is a lock-free stack (Treiber stack) with a
+ *  tagged head to avoid the ABA problem, and its counters are updated
+ *  atomically. Thus, rkh_memPool_get() and rkh_memPool_put() never
+ *  enter the critical section, except to emit their trace records when
+ *  #RKH_CFG_TRC_MP_EN is set. It requires #RKH_CFG_MP_REDUCED_EN set
+ *  to 0 and a compare-and-swap primitive, by default the GCC atomic
+ *  builtins, so it is intended for hosted targets.
+ *
+ *  \type       Boolean
+ *  \range      
+ *  \default    RKH_DISABLED
+ */
+#define RKH_CFG_MP_LOCKFREE_EN          RKH_DISABLED
+
 /** @} doxygen end group definition */
 
 /**
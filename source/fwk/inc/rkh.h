@@ -115,6 +115,7 @@
 #include "rkhfwk_cast.h"
 #include "rkhfwk_version.h"
 #include "rkhfwk_dynevt.h"
+#include "rkhfwk_buf.h"
 #include "rkhfwk_sched.h"
 
 /* ---------------------- External C language linkage ---------------------- */
@@ -78,7 +78,48 @@ extern "C" {
 
 #define RKH_CAST_EVT(e)       ((RKH_EVT_T *)(e))
 
-#if RKH_CFG_FWK_DYN_EVT_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Gets the pool ID of an event, from 1 on for a dynamic event or 0 for a 
+ *  static one. Unlike the raw RKH_EVT_T::pool member, it never includes 
+ *  the #RKH_BUFEVT_FLAG of a buffer-descriptor event.
+ *
+ *  \ingroup apiEvt
+ */
+#if RKH_CFG_FWK_BUF_EN == RKH_ENABLED
+    #define RKH_EVT_POOL_ID(e) \
+        (rui8_t)(RKH_CAST_EVT(e)->pool & (rui8_t)~RKH_BUFEVT_FLAG)
+#else
+    #define RKH_EVT_POOL_ID(e) \
+        (rui8_t)(RKH_CAST_EVT(e)->pool)
+#endif
+
+/**
+ *  \brief
+ *  Atomically increments or decrements the reference counter pointed by 
+ *  \a p_, returning the new value. They are used only when 
+ *  #RKH_CFG_FWK_ATOMIC_NREF_EN is set to 1. By default, they are 
+ *  implemented by means of the GCC __sync builtins, however a port can 
+ *  define them (i.e. in rkht.h) with its own atomic primitives.
+ */
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+    #ifndef RKH_NREF_INC
+    #define RKH_NREF_INC(p_)    __sync_add_and_fetch((p_), 1)
+    #endif
+
+    #ifndef RKH_NREF_DEC
+    #define RKH_NREF_DEC(p_)    __sync_sub_and_fetch((p_), 1)
+    #endif
+#endif
+
+#if RKH_CFG_FWK_DYN_EVT_EN == RKH_ENABLED && \
+    RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+    #define RKH_INC_REF(evt) \
+        if (RKH_CAST_EVT(evt)->pool != 0) \
+        { \
+            (void)RKH_NREF_INC(&RKH_CAST_EVT(evt)->nref); \
+        }
+#elif RKH_CFG_FWK_DYN_EVT_EN == RKH_ENABLED
     #define RKH_INC_REF(evt) \
         if (RKH_CAST_EVT(evt)->pool != 0) \
         { \
@@ -90,6 +131,14 @@ extern "C" {
 #endif
 
 /* -------------------------------- Constants ------------------------------ */
+/**
+ *  \brief
+ *  Flag of the RKH_EVT_T::pool member that marks a buffer-descriptor 
+ *  event, thus rkh_fwk_gc() releases its payload buffer before recycling 
+ *  it.
+ */
+#define RKH_BUFEVT_FLAG         0x80u
+
 /* ------------------------------- Data types ------------------------------ */
 /**
  *  Defines the size of event. The valid values [in bits] are 8, 16 or 32. 
@@ -122,6 +171,19 @@ typedef rui32_t RKH_ES_T;
 typedef rui8_t RKH_ES_T;
 #endif
 
+/**
+ *  Defines the data type of the reference counter of dynamic events. The 
+ *  valid values [in bits] are 8, 16 or 32. Default is 8. This type is 
+ *  configurable via the preprocessor switch RKH_CFG_FWK_SIZEOF_NREF.
+ */
+#if RKH_CFG_FWK_SIZEOF_NREF == 16
+typedef rui16_t RKH_NREF_T;
+#elif RKH_CFG_FWK_SIZEOF_NREF == 32
+typedef rui32_t RKH_NREF_T;
+#else
+typedef rui8_t RKH_NREF_T;
+#endif
+
 /**
  *  \brief
  *  Represents events without parameters.
@@ -178,7 +240,7 @@ typedef struct RKH_EVT_T
      *  \brief
      *  Attribute of dynamic events.
      */
-    rui8_t nref;
+    RKH_NREF_T nref;
 
     /**
      *  \brief
@@ -0,0 +1,276 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+
+/**
+ *  \file       rkhfwk_buf.h
+ *  \ingroup    fwk
+ *  \brief      Specifies the interface of the zero-copy buffer manager.
+ *  \details    A buffer-descriptor event (RKH_BUFEVT_T) is a dynamic event 
+ *              that references a payload buffer allocated from a set of 
+ *              size-classed buffer pools. The payload buffer has its own 
+ *              reference counter, thus several events (views) can share 
+ *              it, and it is released through the rkh_fwk_gc() lifecycle 
+ *              of the last event that references it.
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.16  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/* --------------------------------- Module -------------------------------- */
+#ifndef __RKHFWK_BUF_H__
+#define __RKHFWK_BUF_H__
+
+/* ----------------------------- Include files ----------------------------- */
+#include "rkhitl.h"
+
+/* ---------------------- External C language linkage ---------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------------- Macros -------------------------------- */
+/**
+ *  \brief
+ *  Perform cast to pointer to RKH buffer-descriptor event structure 
+ *  (RKH_BUFEVT_T*).
+ *
+ *  \ingroup apiEvt
+ */
+#define RKH_BUFEVT_CAST(e_)     ((RKH_BUFEVT_T *)(e_))
+
+/**
+ *  \brief
+ *	This macro dynamically creates a new buffer-descriptor event of type 
+ *	\a et, which must derive from RKH_BUFEVT_T, with a payload buffer of 
+ *	at least \a len bytes. 
+ *
+ *	The payload buffer is allocated from the smallest buffer pool that 
+ *	fits it, spilling over to the larger ones when it is empty. The 
+ *	descriptor itself is allocated from the registered event pools.
+ *
+ *  \param[in] et		type of event
+ *  \param[in] e		event signal
+ *  \param[in] len_		payload size [in bytes]
+ *  \param[in] sender_	pointer to the actor that request a memory block.
+ *
+ *  \return
+ *  Pointer to the event or NULL if either there is no free payload buffer 
+ *  or no free event block.
+ *
+ *  \usage
+ *	\code
+ *	FRAME_T *frm = RKH_ALLOC_BUFEVT(FRAME_T, FRAME_RCVD, 1500, me);
+ *	if (frm != (FRAME_T *)0)
+ *	{
+ *	    rx(frm->base.data, frm->base.len);
+ *	    RKH_SMA_POST_FIFO(parser, RKH_UPCAST(RKH_EVT_T, frm), me);
+ *	}
+ *	\endcode
+ *
+ *  \ingroup apiEvt
+ */
+#define RKH_ALLOC_BUFEVT(et, e, len_, sender_) \
+    (et *)rkh_buf_ae((RKH_ES_T)sizeof(et), (RKH_SIG_T)(e), (len_), sender_)
+
+/**
+ *  \brief
+ *	This macro creates a new buffer-descriptor event of type \a et that 
+ *	refers to the slice [\a off_, \a off_ + \a len_) of the payload of 
+ *	\a src_, without copying it.
+ *
+ *  \param[in] et		type of event
+ *  \param[in] e		event signal
+ *  \param[in] src_		source buffer-descriptor event
+ *  \param[in] off_		offset of the slice within the \a src_ view
+ *  \param[in] len_		size of the slice [in bytes]
+ *  \param[in] sender_	pointer to the actor that request a memory block.
+ *
+ *  \ingroup apiEvt
+ */
+#define RKH_BUFEVT_VIEW(et, e, src_, off_, len_, sender_) \
+    (et *)rkh_buf_view((RKH_ES_T)sizeof(et), (RKH_SIG_T)(e), \
+                       RKH_BUFEVT_CAST(src_), (off_), (len_), sender_)
+
+/* -------------------------------- Constants ------------------------------ */
+/* ------------------------------- Data types ------------------------------ */
+/**
+ *  \brief
+ *  Opaque payload buffer, which is shared by one or more 
+ *  buffer-descriptor events.
+ */
+typedef struct RKHBuf RKHBuf;
+
+/**
+ *  \brief
+ *  Represents a buffer-descriptor event, a dynamic event whose payload 
+ *  lives in a separately refcounted buffer. Forwarding, publishing or 
+ *  deferring it shares the payload instead of copying it.
+ *
+ *  \ingroup apiEvt
+ */
+typedef struct RKH_BUFEVT_T
+{
+    /**
+     *  \brief
+     *  Base event.
+     */
+    RKH_EVT_T evt;
+
+    /**
+     *  \brief
+     *  Payload buffer referenced by this event.
+     */
+    RKHBuf *buf;
+
+    /**
+     *  \brief
+     *  Points to the first byte of this view of the payload.
+     */
+    rui8_t *data;
+
+    /**
+     *  \brief
+     *  Size of this view of the payload [in bytes].
+     */
+    rui32_t len;
+} RKH_BUFEVT_T;
+
+/* -------------------------- External variables --------------------------- */
+/* -------------------------- Function prototypes -------------------------- */
+/**
+ *  \brief
+ *  Initializes the buffer manager.
+ *
+ *  \ingroup apiEvt
+ */
+void rkh_buf_init(void);
+
+/**
+ *  \brief
+ *  Registers a new payload buffer pool. The buffer pools must be 
+ *  registered in the ascending order of the buffer size.
+ *
+ *  \param[in] sstart   storage start. Pointer to memory from which the 
+ *                      buffers are allocated.
+ *  \param[in] ssize	storage size [in bytes]. It must fit RKH_MPSS_T.
+ *  \param[in] bsize	buffer size [in bytes], including a small header. 
+ *                      It must fit RKH_MPBS_T.
+ *
+ *  \note
+ *  Large buffers usually require to set RKH_CFG_MP_SIZEOF_BSIZE and 
+ *  RKH_CFG_MP_SIZEOF_SSIZE to 32.
+ *
+ *  \ingroup apiEvt
+ */
+void rkh_buf_registerPool(void *sstart, rui32_t ssize, rui32_t bsize);
+
+/**
+ *  \brief
+ *  Allocates a buffer-descriptor event and its payload buffer.
+ *
+ *  \param[in] esize    size of the descriptor event [in bytes].
+ *  \param[in] e        event signal.
+ *  \param[in] len      size of the payload [in bytes].
+ *  \param[in] sender	pointer to the actor that request a memory block.
+ *
+ *  \return
+ *  Pointer to the event or NULL if there is no free buffer or event.
+ *
+ *  \note
+ *  This function is internal to RKH and the user application should not call 
+ *  it. Instead, use #RKH_ALLOC_BUFEVT() macro.
+ *
+ *  \ingroup apiEvt
+ */
+RKH_BUFEVT_T *rkh_buf_ae(RKH_ES_T esize, RKH_SIG_T e, rui32_t len, 
+                         const void *const sender);
+
+/**
+ *  \brief
+ *  Allocates a buffer-descriptor event that shares the payload buffer of 
+ *  \a src, referring to a slice of its view.
+ *
+ *  \param[in] esize    size of the descriptor event [in bytes].
+ *  \param[in] e        event signal.
+ *  \param[in] src      source buffer-descriptor event.
+ *  \param[in] offset   offset of the slice within the \a src view.
+ *  \param[in] len      size of the slice [in bytes].
+ *  \param[in] sender	pointer to the actor that request a memory block.
+ *
+ *  \return
+ *  Pointer to the event or NULL if there is no free event.
+ *
+ *  \note
+ *  This function is internal to RKH and the user application should not call 
+ *  it. Instead, use #RKH_BUFEVT_VIEW() macro.
+ *
+ *  \ingroup apiEvt
+ */
+RKH_BUFEVT_T *rkh_buf_view(RKH_ES_T esize, RKH_SIG_T e, 
+                           const RKH_BUFEVT_T *src, rui32_t offset, 
+                           rui32_t len, const void *const sender);
+
+/**
+ *  \brief
+ *  Releases the payload buffer referenced by \a be, returning it to its 
+ *  pool when it is not referenced anymore.
+ *
+ *  \param[in] be       buffer-descriptor event.
+ *
+ *  \note
+ *  This function is internal to RKH and the user application should not call 
+ *  it. It is invoked by rkh_fwk_gc() when recycling a buffer-descriptor 
+ *  event.
+ *
+ *  \ingroup apiEvt
+ */
+void rkh_buf_release(RKH_BUFEVT_T *be);
+
+/* -------------------- External C language linkage end -------------------- */
+#ifdef __cplusplus
+}
+#endif
+
+/* ------------------------------ Module end ------------------------------- */
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
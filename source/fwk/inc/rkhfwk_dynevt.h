@@ -108,6 +108,38 @@ extern "C" {
         (void)0
 #endif
 
+/**
+ *  \brief
+ *	This macro is like RKH_ALLOC_EVT() but it does not assert when the 
+ *	event pools run out of blocks. It first tries the best-fit pool, then 
+ *	it spills over to the larger ones and finally returns NULL, so the 
+ *	caller must check the returned pointer.
+ *
+ *  \param[in] et		type of event
+ *  \param[in] e		event signal
+ *  \param[in] sender_	pointer to the actor that request a memory block. 
+ *
+ *  \usage
+ *	\code
+ *	MYEVT_T *mye = RKH_ALLOC_EVT_TRY(MYEVT_T, DATA, me);
+ *	if (mye == (MYEVT_T *)0)
+ *	{
+ *	    ++dropped;              // shed load
+ *	    return;
+ *	}
+ *	...
+ *	\endcode
+ *
+ *  \ingroup apiEvt
+ */
+#if RKH_CFG_FWK_DYN_EVT_EN == RKH_ENABLED
+    #define RKH_ALLOC_EVT_TRY(et, e, sender_) \
+        (et *)rkh_fwk_ae_try((RKH_ES_T)sizeof(et),(RKH_SIG_T)(e), sender_)
+#else
+    #define RKH_ALLOC_EVT_TRY(et, e, sender_) \
+        (void)0
+#endif
+
 /**
  *  \brief
  *  Recycle a dynamic event.
@@ -309,6 +341,13 @@ extern "C" {
     MK_EVT_STRUCT(ev_sig)
 
 /* -------------------------------- Constants ------------------------------ */
+/**
+ *  \brief
+ *  Value returned by rkh_fwk_getAffinity() when the caller is not bound to 
+ *  any local event pool, thus its events are allocated from the global ones.
+ */
+#define RKH_EVT_NO_AFFINITY     0xFF
+
 /* ------------------------------- Data types ------------------------------ */
 /* -------------------------- External variables --------------------------- */
 /* -------------------------- Function prototypes -------------------------- */
@@ -422,6 +461,11 @@ void rkh_fwk_registerEvtPool(void *sstart, rui32_t ssize, RKH_ES_T esize);
  *  \note
  *  This function is internal to RKH and the user application should not call 
  *  it. Instead, use #RKH_ALLOC_EVT() macro.
+ *  \note
+ *  When the best-fit pool is empty it spills over to the next larger ones 
+ *  and it asserts only if all of them are empty. If 
+ *  #RKH_CFG_FWK_EVT_SCLASS_EN is set to 1 the best-fit pool is found in 
+ *  constant time.
  *
  *  \sa rkh_put_fifo(), rkh_put_lifo(), rkh_alloc_event(),
  *  rkh_set_static_event() and rkh_fwk_gc().
@@ -430,6 +474,91 @@ void rkh_fwk_registerEvtPool(void *sstart, rui32_t ssize, RKH_ES_T esize);
  */
 RKH_EVT_T *rkh_fwk_ae(RKH_ES_T esize, RKH_SIG_T e, const void *const sender);
 
+/**
+ *  \brief
+ *  Tries to allocate an event from the previously created event pools. 
+ *
+ *  As rkh_fwk_ae(), when the best-fit pool is empty it spills over to the 
+ *  next larger pools but, if all of them are empty, it returns NULL 
+ *  instead of asserting. It also returns NULL when no registered pool fits 
+ *  \a esize. Every empty pool found increments its exhaustion counter, see 
+ *  rkh_fwk_getNumExhausted().
+ *
+ *  \param[in] esize    size of event [in bytes].
+ *  \param[in] e        event signal.
+ *  \param[in] sender	pointer to the actor that request a memory block.
+ *
+ *  \return
+ *  Pointer to the allocated event or NULL if there is no free block that 
+ *  fits it.
+ *
+ *  \note
+ *  This function is internal to RKH and the user application should not call 
+ *  it. Instead, use #RKH_ALLOC_EVT_TRY() macro.
+ *
+ *  \ingroup apiEvt
+ */
+RKH_EVT_T *rkh_fwk_ae_try(RKH_ES_T esize, RKH_SIG_T e, 
+                          const void *const sender);
+
+/**
+ *  \brief
+ *  Returns the number of times that an allocation found the event pool 
+ *  \a poolId without free blocks. It allows to size the event pools for 
+ *  the typical load instead of the absolute worst case.
+ *
+ *  \param[in] poolId   index of the event pool, in registration order. 
+ *                      Local pools, see rkh_fwk_registerLocalEvtPool(), 
+ *                      are indexed from #RKH_CFG_FWK_MAX_EVT_POOL on, 
+ *                      also in registration order.
+ *
+ *  \ingroup apiEvt
+ */
+rui32_t rkh_fwk_getNumExhausted(rui8_t poolId);
+
+/**
+ *  \brief
+ *  Registers a local event pool, which is bound to \a affinity, usually 
+ *  the priority of an active object or the number of a worker core. 
+ *
+ *  While the caller of rkh_fwk_ae() or rkh_fwk_ae_try() is bound to 
+ *  \a affinity, see rkh_fwk_getAffinity(), the event is allocated from 
+ *  the smallest local pool that fits it, falling back to the global pools 
+ *  when none is available. Since the event records its origin pool, 
+ *  rkh_fwk_gc() returns it to the local pool wherever it is recycled, 
+ *  thus its cache lines stay near the core that allocates it.
+ *
+ *  \param[in] sstart   storage start. Pointer to memory from which memory 
+ *                      blocks are allocated.
+ *  \param[in] ssize	storage size [in bytes].
+ *  \param[in] esize	event size. This number determines the size of each 
+ *                      memory block in the pool.
+ *  \param[in] affinity	active object priority or core number that owns 
+ *                      the pool.
+ *
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_FWK_EVT_AFFINITY_EN = 0.
+ *
+ *  \ingroup apiEvt
+ */
+void rkh_fwk_registerLocalEvtPool(void *sstart, rui32_t ssize, 
+                                  RKH_ES_T esize, rui8_t affinity);
+
+/**
+ *  \brief
+ *  Returns the affinity of the caller, i.e. the priority of the active 
+ *  object or the number of the core running it, or #RKH_EVT_NO_AFFINITY 
+ *  when it is not bound to any local event pool, for example an ISR.
+ *
+ *  \note
+ *  This function is provided by the multi-thread ports when 
+ *  RKH_CFG_FWK_EVT_AFFINITY_EN is set to 1.
+ *
+ *  \ingroup apiEvt
+ */
+rui8_t rkh_fwk_getAffinity(void);
+
 /**
  *  \brief
  *  Recycle a dynamic event.
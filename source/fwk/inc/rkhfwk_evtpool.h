@@ -59,6 +59,7 @@
 
 /* ----------------------------- Include files ----------------------------- */
 #include "rkhitl.h"
+#include "rkhmempool.h"
 
 /* ---------------------- External C language linkage ---------------------- */
 #ifdef __cplusplus
@@ -67,6 +68,18 @@ extern "C" {
 
 /* --------------------------------- Macros -------------------------------- */
 /* -------------------------------- Constants ------------------------------ */
+/**
+ *  \brief
+ *  Number of event pools, either global or local ones, managed by this 
+ *  module.
+ */
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+#define RKH_EVTPOOL_NUM \
+    (RKH_CFG_FWK_MAX_EVT_POOL + RKH_CFG_FWK_MAX_LOCAL_EVT_POOL)
+#else
+#define RKH_EVTPOOL_NUM         RKH_CFG_FWK_MAX_EVT_POOL
+#endif
+
 /* ------------------------------- Data types ------------------------------ */
 typedef struct RKHEvtPool RKHEvtPool;
 
@@ -104,7 +117,7 @@ void rkh_evtPool_init();
  *  the external OS/RTOS usually need some code to bolt the framework to the
  *	external OS/RTOS.
  */
-RKHEvtPool *rkh_evtPool_getPool(void *stoStart, rui16_t stoSize, 
+RKHEvtPool *rkh_evtPool_getPool(void *stoStart, RKH_MPSS_T stoSize, 
                                 RKH_ES_T evtSize);
 
 /**
@@ -120,7 +133,7 @@ RKHEvtPool *rkh_evtPool_getPool(void *stoStart, rui16_t stoSize,
  *  the external OS/RTOS usually need some code to bolt the framework to the
  *	external OS/RTOS.
  */
-rui8_t rkh_evtPool_getBlockSize(RKHEvtPool *const me);
+RKH_MPBS_T rkh_evtPool_getBlockSize(RKHEvtPool *const me);
 
 /**
  *  \brief
@@ -169,7 +182,7 @@ void rkh_evtPool_put(RKHEvtPool *const me, RKH_EVT_T *evt);
  *  the external OS/RTOS usually need some code to bolt the framework to the
  *	external OS/RTOS.
  */
-rui8_t rkh_evtPool_getNumUsed(RKHEvtPool *const me);
+RKH_MPNB_T rkh_evtPool_getNumUsed(RKHEvtPool *const me);
 
 /**
  *  \brief
@@ -187,7 +200,7 @@ rui8_t rkh_evtPool_getNumUsed(RKHEvtPool *const me);
  *  the external OS/RTOS usually need some code to bolt the framework to the
  *	external OS/RTOS.
  */
-rui8_t rkh_evtPool_getNumMin(RKHEvtPool *const me);
+RKH_MPNB_T rkh_evtPool_getNumMin(RKHEvtPool *const me);
 
 /**
  *  \brief
@@ -203,7 +216,7 @@ rui8_t rkh_evtPool_getNumMin(RKHEvtPool *const me);
  *  the external OS/RTOS usually need some code to bolt the framework to the
  *	external OS/RTOS.
  */
-rui8_t rkh_evtPool_getNumBlock(RKHEvtPool *const me);
+RKH_MPNB_T rkh_evtPool_getNumBlock(RKHEvtPool *const me);
 
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
@@ -105,6 +105,13 @@ extern "C" {
     #define RKH_HOOK_PUT_TRCEVT()   (void)0
 #endif
 
+#if (RKH_CFG_HOOK_EVTPOOL_LOW_EN == RKH_ENABLED)
+    #define RKH_HOOK_EVTPOOL_LOW(poolId, nFree) \
+        rkh_hook_evtPoolLow((poolId), (nFree))
+#else
+    #define RKH_HOOK_EVTPOOL_LOW(poolId, nFree)   (void)0
+#endif
+
 /* -------------------------------- Constants ------------------------------ */
 /* ------------------------------- Data types ------------------------------ */
 /* -------------------------- External variables --------------------------- */
@@ -252,6 +259,26 @@ void rkh_hook_timetick(void);
  */
 void rkh_hook_putTrcEvt(void);
 
+/**
+ *  \brief
+ *  This function is called from rkh_fwk_ae() and rkh_fwk_ae_try() when an 
+ *  allocation leaves the event pool \a poolId with exactly 
+ *  RKH_CFG_HOOK_EVTPOOL_LOW_NFREE free blocks. It allows the application 
+ *  to shed load or to degrade gracefully before the pool runs out.
+ *
+ *  \param[in] poolId  index of the event pool, in registration order.
+ *  \param[in] nFree   number of free blocks left in the pool.
+ *
+ *	\note
+ *	The event pool low hook will only get called if 
+ *	RKH_CFG_HOOK_EVTPOOL_LOW_EN is set to 1 within rkhcfg.h file. It is 
+ *	called from the context of the allocator, which might be an ISR, thus 
+ *	it must not make any blocking calls.
+ *
+ *	\ingroup apiBSPHook
+ */
+void rkh_hook_evtPoolLow(rui8_t poolId, rui32_t nFree);
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
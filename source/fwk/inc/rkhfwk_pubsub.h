@@ -80,7 +80,88 @@ extern "C" {
 
 /* --------------------------------- Macros -------------------------------- */
 /* -------------------------------- Constants ------------------------------ */
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Mask of a subscription that matches exactly one topic.
+ */
+#define RKH_TOPIC_EXACT     ((RKH_TOPIC_T)~(RKH_TOPIC_T)0)
+#endif
+
 /* ------------------------------- Data types ------------------------------ */
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Predicate of a content filter. It returns RKH_TRUE when the published 
+ *  event must be posted to the subscriber.
+ *
+ *  \note
+ *  It is invoked from the publisher's context, even an interrupt, thus it 
+ *  must be short and must not call RKH services. It runs outside of the 
+ *  critical section, on a snapshot of the filters taken along with the 
+ *  subscribers.
+ */
+typedef rbool_t (*RKH_PUBSUB_PRED_T)(const RKH_EVT_T *e, 
+                                     const RKH_SMA_T *ao);
+
+/**
+ *  \brief
+ *  Content filter of a subscription, evaluated by the publish methods 
+ *  before posting. An event passes when its signal is within 
+ *  [minSig..maxSig] and, if any, the predicate accepts it.
+ */
+typedef struct RKH_PUBSUB_FILTER_T RKH_PUBSUB_FILTER_T;
+struct RKH_PUBSUB_FILTER_T
+{
+    /** Lowest accepted signal */
+    RKH_SIG_T minSig;
+
+    /** Highest accepted signal */
+    RKH_SIG_T maxSig;
+
+    /** Optional predicate, NULL accepts every event in range */
+    RKH_PUBSUB_PRED_T pred;
+};
+#endif
+
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+#if RKH_CFG_FWK_SIZEOF_TOPIC == 32
+typedef rui32_t RKH_TOPIC_T;
+#else
+typedef rui16_t RKH_TOPIC_T;
+#endif
+
+/**
+ *  \brief
+ *  Subscription to the topic registry.
+ *
+ *  A subscription matches every published topic \c t that satisfies
+ *  <tt>(t & mask) == topic</tt>. Its storage is provided by the 
+ *  application and it must not be reused until it is unsubscribed, thus 
+ *  the registry does not limit the number of subscriptions.
+ */
+typedef struct RKH_SUBS_T RKH_SUBS_T;
+struct RKH_SUBS_T
+{
+    /** Next subscription of the same bucket or prefix list */
+    RKH_SUBS_T *next;
+
+    /** Subscribed active object */
+    const RKH_SMA_T *ao;
+
+    /** Topic ID or prefix, already masked */
+    RKH_TOPIC_T topic;
+
+    /** Significant bits of topic, #RKH_TOPIC_EXACT for a single topic */
+    RKH_TOPIC_T mask;
+
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    /** Content filter, NULL accepts every event */
+    const RKH_PUBSUB_FILTER_T *filter;
+#endif
+};
+#endif
+
 /* -------------------------- External variables --------------------------- */
 /* -------------------------- Function prototypes -------------------------- */
 /**
@@ -107,6 +188,24 @@ void rkh_pubsub_init(void);
  */
 void rkh_pubsub_subscribe(rui8_t channel, const RKH_SMA_T *ao);
 
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Adds an active object to the notification list of an event channel, 
+ *  like rkh_pubsub_subscribe(), but only the events accepted by filter 
+ *  are posted to it.
+ *
+ *  \param[in] channel  indicates the topic to which the active object 
+ *                      (client) wants to subscribe.
+ *  \param[in] ao       pointer to previously created active object to
+ *                      subscribe.
+ *  \param[in] filter   pointer to the content filter. It must remain valid 
+ *                      while subscribed. NULL accepts every event.
+ */
+void rkh_pubsub_subscribeFilter(rui8_t channel, const RKH_SMA_T *ao, 
+                                const RKH_PUBSUB_FILTER_T *filter);
+#endif
+
 /**
  *  \brief
  *  Unsubscribes an active object from topic.
@@ -140,11 +239,97 @@ void rkh_pubsub_unsubscribeAll(const RKH_SMA_T *ao);
  *                      unambiguously identify the publisher of the event.
  *
  *  \return
- *  The number of found ready active objects.
+ *  The number of subscribers found, including the ones whose filter 
+ *  rejects the event.
  */
 rui8_t rkh_pubsub_publish(rui8_t channel, RKH_EVT_T *event, 
                           const void *const sender);
 
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Subscribes an active object to a single topic of the topic registry.
+ *
+ *  \param[in] subs     pointer to the subscription storage. It is owned by 
+ *                      the registry until it is unsubscribed.
+ *  \param[in] topic    topic ID.
+ *  \param[in] ao       pointer to previously created active object to
+ *                      subscribe.
+ */
+void rkh_pubsub_subscribeTopic(RKH_SUBS_T *subs, RKH_TOPIC_T topic, 
+                               const RKH_SMA_T *ao);
+
+/**
+ *  \brief
+ *  Subscribes an active object to every topic of the registry whose ID 
+ *  matches a prefix, i.e. the topics \c t satisfying 
+ *  <tt>(t & mask) == (prefix & mask)</tt>. For example, a device class in 
+ *  the upper bits of the ID can be subscribed at once with a mask that 
+ *  selects these bits.
+ *
+ *  \note
+ *  Every prefix subscription is checked on each published topic, thus 
+ *  they should be a few. Use rkh_pubsub_subscribeTopic() instead for 
+ *  single topics.
+ *
+ *  \param[in] subs     pointer to the subscription storage. It is owned by 
+ *                      the registry until it is unsubscribed.
+ *  \param[in] prefix   topic ID prefix.
+ *  \param[in] mask     significant bits of prefix. #RKH_TOPIC_EXACT 
+ *                      behaves like rkh_pubsub_subscribeTopic().
+ *  \param[in] ao       pointer to previously created active object to
+ *                      subscribe.
+ */
+void rkh_pubsub_subscribePrefix(RKH_SUBS_T *subs, RKH_TOPIC_T prefix, 
+                                RKH_TOPIC_T mask, const RKH_SMA_T *ao);
+
+/**
+ *  \brief
+ *  Removes a subscription from the topic registry. Afterwards its storage 
+ *  can be reused.
+ *
+ *  \param[in] subs     pointer to a subscription previously registered by
+ *                      rkh_pubsub_subscribeTopic() or 
+ *                      rkh_pubsub_subscribePrefix().
+ */
+void rkh_pubsub_unsubscribeTopic(RKH_SUBS_T *subs);
+
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Sets the content filter of a topic subscription.
+ *
+ *  \param[in] subs     pointer to a subscription of the topic registry.
+ *  \param[in] filter   pointer to the content filter. It must remain valid 
+ *                      while subscribed. NULL accepts every event.
+ */
+void rkh_pubsub_filterTopic(RKH_SUBS_T *subs, 
+                            const RKH_PUBSUB_FILTER_T *filter);
+#endif
+
+/**
+ *  \brief
+ *  Publishes an event to the active objects subscribed to a topic. 
+ *
+ *  Its cost only depends on the subscriptions hashed into the topic's 
+ *  bucket and the prefix subscriptions, not on the total number of topics.
+ *  An active object matched by several subscriptions receives the event 
+ *  once. In that case, a subscription without filter wins, then the first 
+ *  one whose signal range admits the event, whose predicate decides.
+ *
+ *  \param[in] topic    topic ID to which event is published.
+ *  \param[in] event    pointer to event to publish
+ *  \param[in] sender	pointer to the sender object. See 
+ *                      rkh_pubsub_publish().
+ *
+ *  \return
+ *  The number of subscribers found, including the ones whose filter 
+ *  rejects the event, as rkh_pubsub_publish() does.
+ */
+rui8_t rkh_pubsub_publishTopic(RKH_TOPIC_T topic, RKH_EVT_T *event, 
+                               const void *const sender);
+#endif
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
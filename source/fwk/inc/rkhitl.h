@@ -289,6 +289,18 @@ extern "C" {
     #error  "                               [     || 32  (32-bit size)]      "
     #endif
 
+    #ifndef RKH_CFG_MP_SIZEOF_SSIZE
+    #error "RKH_CFG_MP_SIZEOF_SSIZE               not #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be 16  (16-bit size)]      "
+    #error  "                               [     || 32  (32-bit size)]      "
+
+    #elif  ((RKH_CFG_MP_SIZEOF_SSIZE != 16) && \
+    (RKH_CFG_MP_SIZEOF_SSIZE != 32))
+    #error  "RKH_CFG_MP_SIZEOF_SSIZE        illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be 16  (16-bit size)]      "
+    #error  "                               [     || 32  (32-bit size)]      "
+    #endif
+
     #ifndef RKH_CFG_MP_GET_BSIZE_EN
     #error "RKH_CFG_MP_GET_BSIZE_EN               not #define'd in 'rkhcfg.h'"
     #error "                                    [MUST be RKH_ENABLED ]       "
@@ -337,6 +349,53 @@ extern "C" {
     #error "                                    [     ||  RKH_DISABLED]      "
     #endif
 
+    #ifndef RKH_CFG_MP_MAG_EN
+    #error "RKH_CFG_MP_MAG_EN                     not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]       "
+    #error "                                    [     || RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_MP_MAG_EN != RKH_ENABLED) && \
+    (RKH_CFG_MP_MAG_EN != RKH_DISABLED))
+    #error "RKH_CFG_MP_MAG_EN               illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]      "
+    #error "                                    [     ||  RKH_DISABLED]      "
+
+    #elif   (RKH_CFG_MP_MAG_EN == RKH_ENABLED)
+        #ifndef RKH_CFG_MP_MAG_SIZE
+        #error "RKH_CFG_MP_MAG_SIZE               not #define'd in 'rkhcfg.h'"
+        #error  "                               [MUST be >=   2]              "
+        #error  "                               [     && <  256]              "
+
+        #elif ((RKH_CFG_MP_MAG_SIZE < 2) || (RKH_CFG_MP_MAG_SIZE > 255))
+        #error "RKH_CFG_MP_MAG_SIZE         illegally #define'd in 'rkhcfg.h'"
+        #error  "                               [MUST be >=   2]              "
+        #error  "                               [     && <  256]              "
+        #endif
+        #if (RKH_CFGPORT_SMA_THREAD_EN == RKH_DISABLED)
+        #error "RKH_CFG_MP_MAG_EN requires a multi-thread port,          "
+        #error "that is RKH_CFGPORT_SMA_THREAD_EN = RKH_ENABLED, which   "
+        #error "provides rkh_memPool_getMagSlot()                        "
+        #endif
+    #endif
+
+    #ifndef RKH_CFG_MP_LOCKFREE_EN
+    #error "RKH_CFG_MP_LOCKFREE_EN                not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]       "
+    #error "                                    [     || RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_MP_LOCKFREE_EN != RKH_ENABLED) && \
+    (RKH_CFG_MP_LOCKFREE_EN != RKH_DISABLED))
+    #error "RKH_CFG_MP_LOCKFREE_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]      "
+    #error "                                    [     ||  RKH_DISABLED]      "
+
+    #elif   ((RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED) && \
+    (RKH_CFG_MP_REDUCED_EN == RKH_ENABLED))
+    #error "RKH_CFG_MP_LOCKFREE_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "                          [MUST be used with RKH_CFG_MP_REDUCED_EN]"
+    #error "                          [         set to RKH_DISABLED         ]"
+    #endif
+
 #endif
 
 /*  QUEUE         --------------------------------------------------------- */
@@ -460,6 +519,19 @@ extern "C" {
 
 #endif
 
+#ifndef RKH_CFG_QUE_OVF_POLICY_EN
+    #error "RKH_CFG_QUE_OVF_POLICY_EN              not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]       "
+    #error "                                    [     || RKH_DISABLED]       "
+
+#elif   ((RKH_CFG_QUE_OVF_POLICY_EN != RKH_ENABLED) && \
+    (RKH_CFG_QUE_OVF_POLICY_EN != RKH_DISABLED))
+    #error "RKH_CFG_QUE_OVF_POLICY_EN        illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]      "
+    #error "                                    [     ||  RKH_DISABLED]      "
+
+#endif
+
 /*  TIMER         --------------------------------------------------------- */
 #ifndef RKH_CFG_TMR_EN
     #error "RKH_CFG_TMR_EN                        not #define'd in 'rkhcfg.h'"
@@ -537,6 +609,18 @@ extern "C" {
 
 #endif
 
+#ifndef RKH_CFG_SMA_SCRATCH_EN
+    #error "RKH_CFG_SMA_SCRATCH_EN                not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]       "
+    #error "                                    [     || RKH_DISABLED]       "
+
+#elif   ((RKH_CFG_SMA_SCRATCH_EN == RKH_ENABLED) && \
+    (RKH_CFGPORT_NATIVE_EQUEUE_EN == RKH_DISABLED))
+    #error "RKH_CFG_SMA_SCRATCH_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "               [MUST enable RKH_CFGPORT_NATIVE_EQUEUE_EN]        "
+
+#endif
+
 #ifndef RKH_CFG_SMA_PPRO_EN
     #error "RKH_CFG_SMA_PPRO_EN                   not #define'd in 'rkhcfg.h'"
     #error "                                    [MUST be RKH_ENABLED ]       "
@@ -1192,14 +1276,17 @@ extern "C" {
     #error  "                               [MUST be  8  ( 8-bit size)]       "
     #error  "                               [     || 16  (16-bit size)]       "
     #error  "                               [     || 32  (32-bit size)]       "
+    #error  "                               [     || 64  (64-bit size)]       "
 
     #elif  ((RKH_CFGPORT_TRC_SIZEOF_TSTAMP != 8) && \
     (RKH_CFGPORT_TRC_SIZEOF_TSTAMP != 16) && \
-    (RKH_CFGPORT_TRC_SIZEOF_TSTAMP != 32))
+    (RKH_CFGPORT_TRC_SIZEOF_TSTAMP != 32) && \
+    (RKH_CFGPORT_TRC_SIZEOF_TSTAMP != 64))
     #error  "RKH_CFGPORT_TRC_SIZEOF_TSTAMP  illegally #define'd in 'rkhcfg.h'"
     #error  "                               [MUST be  8  ( 8-bit size)]       "
     #error  "                               [     || 16  (16-bit size)]       "
     #error  "                               [     || 32  (32-bit size)]       "
+    #error  "                               [     || 64  (64-bit size)]       "
     #endif
 
     #ifndef RKH_CFGPORT_SMA_QSTO_EN
@@ -1226,16 +1313,169 @@ extern "C" {
     #error "                                    [     ||  RKH_DISABLED]       "
     #endif
 
+    #ifndef RKH_CFG_TRC_STREAM_MAP_EN
+    #error "RKH_CFG_TRC_STREAM_MAP_EN             not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_STREAM_MAP_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_STREAM_MAP_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_STREAM_MAP_EN       illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+    #endif
+
     #ifndef RKH_CFG_TRC_SIZEOF_STREAM
     #error "RKH_CFG_TRC_SIZEOF_STREAM             not #define'd in 'rkhcfg.h'"
     #error  "                               [MUST be >     0]                 "
     #error  "                               [     && <= 2048]                 "
 
     #elif   ((RKH_CFG_TRC_SIZEOF_STREAM == 0) || \
-    (RKH_CFG_TRC_SIZEOF_STREAM > 2048))
+    ((RKH_CFG_TRC_STREAM_MAP_EN == RKH_DISABLED) && \
+     (RKH_CFG_TRC_SIZEOF_STREAM > 2048)))
     #error "RKH_CFG_TRC_SIZEOF_STREAM       illegally #define'd in 'rkhcfg.h'"
     #error  "                               [MUST be >    0]                  "
     #error  "                               [     && <= 2048]                 "
+    #error  "                               [ unless it is mapped]            "
+    #endif
+
+    #ifndef RKH_CFG_TRC_BLOCK_ENC_EN
+    #error "RKH_CFG_TRC_BLOCK_ENC_EN              not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_BLOCK_ENC_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_BLOCK_ENC_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_BLOCK_ENC_EN        illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+    #endif
+
+    #ifndef RKH_CFG_TRC_LOCAL_EN
+    #error "RKH_CFG_TRC_LOCAL_EN                  not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_LOCAL_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_LOCAL_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_LOCAL_EN            illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED)
+        #if (RKH_CFGPORT_SMA_THREAD_EN == RKH_DISABLED)
+        #error "RKH_CFG_TRC_LOCAL_EN requires a multi-thread port,       "
+        #error "that is RKH_CFGPORT_SMA_THREAD_EN = RKH_ENABLED          "
+        #endif
+        #if (RKH_CFG_TRC_TSTAMP_EN == RKH_DISABLED)
+        #error "RKH_CFG_TRC_LOCAL_EN merges the lanes by timestamp, thus "
+        #error "it requires RKH_CFG_TRC_TSTAMP_EN = RKH_ENABLED          "
+        #endif
+        #if (RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED)
+        #error "RKH_CFG_TRC_LOCAL_EN and RKH_CFG_TRC_BLOCK_ENC_EN cannot "
+        #error "be enabled at the same time                              "
+        #endif
+        #if defined(RKH_CPUSR_TYPE)
+        #error "RKH_CFG_TRC_LOCAL_EN requires a port whose critical      "
+        #error "section does not save the CPU status register            "
+        #endif
+        #if (RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64)
+        #error "RKH_CFG_TRC_LOCAL_EN requires a timestamp up to 32 bits, "
+        #error "that is RKH_CFGPORT_TRC_SIZEOF_TSTAMP <= 32              "
+        #endif
+    #endif
+
+    #ifndef RKH_CFG_TRC_SIZEOF_LOCAL_STREAM
+    #error "RKH_CFG_TRC_SIZEOF_LOCAL_STREAM       not #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=   16]                 "
+    #error  "                               [     && <= 32768]                "
+
+    #elif   ((RKH_CFG_TRC_SIZEOF_LOCAL_STREAM < 16) || \
+    (RKH_CFG_TRC_SIZEOF_LOCAL_STREAM > 32768))
+    #error "RKH_CFG_TRC_SIZEOF_LOCAL_STREAM illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=   16]                 "
+    #error  "                               [     && <= 32768]                "
+    #endif
+
+    #ifndef RKH_CFG_TRC_OVF_DROP_NEWEST_EN
+    #error "RKH_CFG_TRC_OVF_DROP_NEWEST_EN        not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_OVF_DROP_NEWEST_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_OVF_DROP_NEWEST_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_OVF_DROP_NEWEST_EN  illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+    #endif
+
+    #ifndef RKH_CFG_TRC_COMPACT_EN
+    #error "RKH_CFG_TRC_COMPACT_EN                not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_COMPACT_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_COMPACT_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_COMPACT_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   (RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED)
+        #if (RKH_CFG_TRC_NSEQ_EN == RKH_DISABLED)
+        #error "RKH_CFG_TRC_COMPACT_EN resynchronizes the timestamp by   "
+        #error "means of the sequence number, thus it requires           "
+        #error "RKH_CFG_TRC_NSEQ_EN = RKH_ENABLED                        "
+        #endif
+    #endif
+
+    #ifndef RKH_CFG_TRC_SIZEOF_SYMTBL
+    #error "RKH_CFG_TRC_SIZEOF_SYMTBL             not #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=   8]                  "
+    #error  "                               [     && <= 256]                  "
+
+    #elif   ((RKH_CFG_TRC_SIZEOF_SYMTBL < 8) || \
+    (RKH_CFG_TRC_SIZEOF_SYMTBL > 256) || \
+    ((RKH_CFG_TRC_SIZEOF_SYMTBL & (RKH_CFG_TRC_SIZEOF_SYMTBL - 1)) != 0))
+    #error "RKH_CFG_TRC_SIZEOF_SYMTBL       illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=   8]                  "
+    #error  "                               [     && <= 256]                  "
+    #error  "                               [     && power of 2]             "
+    #endif
+
+    #ifndef RKH_CFG_TRC_SYMDICT_EN
+    #error "RKH_CFG_TRC_SYMDICT_EN                not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_SYMDICT_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_SYMDICT_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_SYMDICT_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+    #endif
+
+    #ifndef RKH_CFG_TRC_SIZEOF_SYMDICT
+    #error "RKH_CFG_TRC_SIZEOF_SYMDICT            not #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=   1]                  "
+    #error  "                               [     && <= 255]                  "
+
+    #elif   ((RKH_CFG_TRC_SIZEOF_SYMDICT < 1) || \
+    (RKH_CFG_TRC_SIZEOF_SYMDICT > 255))
+    #error "RKH_CFG_TRC_SIZEOF_SYMDICT      illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=   1]                  "
+    #error  "                               [     && <= 255]                  "
+    #endif
+
+    #ifndef RKH_CFG_TRC_PROFILE_EN
+    #error "RKH_CFG_TRC_PROFILE_EN                not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+    #elif   ((RKH_CFG_TRC_PROFILE_EN != RKH_ENABLED) && \
+    (RKH_CFG_TRC_PROFILE_EN != RKH_DISABLED))
+    #error "RKH_CFG_TRC_PROFILE_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
     #endif
 
 #endif
@@ -1284,6 +1524,112 @@ extern "C" {
 
 #endif
 
+#ifndef RKH_CFG_FWK_EVT_SCLASS_EN
+    #error "RKH_CFG_FWK_EVT_SCLASS_EN             not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   (RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED)
+    #if ((RKH_CFG_FWK_EVT_SCLASS_GRAN == 0) || \
+         (RKH_CFG_FWK_EVT_SCLASS_GRAN > 255))
+    #error "RKH_CFG_FWK_EVT_SCLASS_GRAN     illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >    0]                  "
+    #error  "                               [     && <  256]                  "
+    #endif
+
+    #if ((RKH_CFG_FWK_EVT_SCLASS_NUM == 0) || \
+         (RKH_CFG_FWK_EVT_SCLASS_NUM > 255))
+    #error "RKH_CFG_FWK_EVT_SCLASS_NUM      illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >    0]                  "
+    #error  "                               [     && <  256]                  "
+    #endif
+
+#endif
+
+#ifndef RKH_CFG_FWK_BUF_EN
+    #error "RKH_CFG_FWK_BUF_EN                    not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   (RKH_CFG_FWK_BUF_EN == RKH_ENABLED)
+    #if ((RKH_CFG_FWK_DYN_EVT_EN == RKH_DISABLED) || \
+         (RKH_CFG_MP_EN == RKH_DISABLED))
+    #error "RKH_CFG_FWK_BUF_EN              illegally #define'd in 'rkhcfg.h'"
+    #error "                 [MUST enable RKH_CFG_FWK_DYN_EVT_EN]            "
+    #error "                 [     &&     RKH_CFG_MP_EN         ]            "
+    #endif
+
+    #if (RKH_CFG_FWK_MAX_EVT_POOL > 127)
+    #error "RKH_CFG_FWK_MAX_EVT_POOL        illegally #define'd in 'rkhcfg.h'"
+    #error  "                   [MUST be <  128 when RKH_CFG_FWK_BUF_EN]      "
+    #endif
+
+    #if ((RKH_CFG_FWK_MAX_BUF_POOL == 0) || (RKH_CFG_FWK_MAX_BUF_POOL > 255))
+    #error "RKH_CFG_FWK_MAX_BUF_POOL        illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >    0]                  "
+    #error  "                               [     && <  256]                  "
+    #endif
+
+#endif
+
+#ifndef RKH_CFG_FWK_EVT_AFFINITY_EN
+    #error "RKH_CFG_FWK_EVT_AFFINITY_EN           not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   (RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED)
+    #if ((RKH_CFG_FWK_MAX_LOCAL_EVT_POOL == 0) || \
+         ((RKH_CFG_FWK_MAX_EVT_POOL + RKH_CFG_FWK_MAX_LOCAL_EVT_POOL) > 255))
+    #error "RKH_CFG_FWK_MAX_LOCAL_EVT_POOL  illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >    0]                  "
+    #error  "        [     && RKH_CFG_FWK_MAX_EVT_POOL + it <  256]           "
+    #endif
+
+    #if ((RKH_CFG_FWK_BUF_EN == RKH_ENABLED) && \
+         ((RKH_CFG_FWK_MAX_EVT_POOL + RKH_CFG_FWK_MAX_LOCAL_EVT_POOL) > 127))
+    #error "RKH_CFG_FWK_MAX_LOCAL_EVT_POOL  illegally #define'd in 'rkhcfg.h'"
+    #error  "  [RKH_CFG_FWK_MAX_EVT_POOL + it MUST be <  128 when BUF_EN]      "
+    #endif
+
+#endif
+
+#ifndef RKH_CFG_FWK_TOPIC_EN
+    #error "RKH_CFG_FWK_TOPIC_EN                  not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   (RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED)
+    #if (RKH_CFG_FWK_PUBSUB_EN != RKH_ENABLED)
+    #error "RKH_CFG_FWK_TOPIC_EN            illegally #define'd in 'rkhcfg.h'"
+    #error  "                 [It requires RKH_CFG_FWK_PUBSUB_EN == RKH_ENABLED]"
+    #endif
+
+    #if ((RKH_CFG_FWK_SIZEOF_TOPIC != 16) && (RKH_CFG_FWK_SIZEOF_TOPIC != 32))
+    #error  "RKH_CFG_FWK_SIZEOF_TOPIC       illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be 16  (16-bit size)]       "
+    #error  "                               [     || 32  (32-bit size)]       "
+    #endif
+
+    #if ((RKH_CFG_FWK_TOPIC_HASH_BITS == 0) || \
+         (RKH_CFG_FWK_TOPIC_HASH_BITS > 16))
+    #error "RKH_CFG_FWK_TOPIC_HASH_BITS     illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be >=  1]                   "
+    #error  "                               [     && <= 16]                   "
+    #endif
+
+#endif
+
+#ifndef RKH_CFG_FWK_PUBSUB_FILTER_EN
+    #error "RKH_CFG_FWK_PUBSUB_FILTER_EN          not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   ((RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED) && \
+         (RKH_CFG_FWK_PUBSUB_EN != RKH_ENABLED))
+    #error "RKH_CFG_FWK_PUBSUB_FILTER_EN    illegally #define'd in 'rkhcfg.h'"
+    #error  "                 [It requires RKH_CFG_FWK_PUBSUB_EN == RKH_ENABLED]"
+#endif
+
 #ifndef RKH_CFG_FWK_SIZEOF_EVT
     #error "RKH_CFG_FWK_SIZEOF_EVT                not #define'd in 'rkhcfg.h'"
     #error  "                               [MUST be  8  ( 8-bit size)]       "
@@ -1329,6 +1675,35 @@ extern "C" {
 
 #endif
 
+#ifndef RKH_CFG_FWK_SIZEOF_NREF
+    #error "RKH_CFG_FWK_SIZEOF_NREF               not #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be  8  ( 8-bit size)]       "
+    #error  "                               [     || 16  (16-bit size)]       "
+    #error  "                               [     || 32  (32-bit size)]       "
+
+#elif  ((RKH_CFG_FWK_SIZEOF_NREF != 8) && \
+    (RKH_CFG_FWK_SIZEOF_NREF != 16) && \
+    (RKH_CFG_FWK_SIZEOF_NREF != 32))
+    #error  "RKH_CFG_FWK_SIZEOF_NREF        illegally #define'd in 'rkhcfg.h'"
+    #error  "                               [MUST be  8  ( 8-bit size)]       "
+    #error  "                               [     || 16  (16-bit size)]       "
+    #error  "                               [     || 32  (32-bit size)]       "
+
+#endif
+
+#ifndef RKH_CFG_FWK_ATOMIC_NREF_EN
+    #error "RKH_CFG_FWK_ATOMIC_NREF_EN            not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   ((RKH_CFG_FWK_ATOMIC_NREF_EN != RKH_ENABLED) && \
+    (RKH_CFG_FWK_ATOMIC_NREF_EN != RKH_DISABLED))
+    #error "RKH_CFG_FWK_ATOMIC_NREF_EN      illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be  RKH_ENABLED ]       "
+    #error "                                    [     ||  RKH_DISABLED]       "
+
+#endif
+
 #ifndef RKH_CFG_FWK_DEFER_EVT_EN
     #error "RKH_CFG_FWK_DEFER_EVT_EN              not #define'd in 'rkhcfg.h'"
     #error "                                    [MUST be RKH_ENABLED ]        "
@@ -1445,6 +1820,22 @@ extern "C" {
 
 #endif
 
+#ifndef RKH_CFG_HOOK_EVTPOOL_LOW_EN
+    #error "RKH_CFG_HOOK_EVTPOOL_LOW_EN           not #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+    #error "                                    [     || RKH_DISABLED]        "
+
+#elif   ((RKH_CFG_HOOK_EVTPOOL_LOW_EN == RKH_ENABLED) && \
+    (RKH_CFG_FWK_DYN_EVT_EN == RKH_DISABLED))
+    #error "RKH_CFG_FWK_DYN_EVT_EN          illegally #define'd in 'rkhcfg.h'"
+    #error "                                    [MUST be RKH_ENABLED ]        "
+
+#elif   ((RKH_CFG_HOOK_EVTPOOL_LOW_EN == RKH_ENABLED) && \
+    !defined(RKH_CFG_HOOK_EVTPOOL_LOW_NFREE))
+    #error "RKH_CFG_HOOK_EVTPOOL_LOW_NFREE        not #define'd in 'rkhcfg.h'"
+
+#endif
+
 #ifndef RKH_CFG_SMA_INIT_EVT_EN
     #error "RKH_CFG_SMA_INIT_EVT_EN               not #define'd in 'rkhcfg.h'"
     #error "                                    [MUST be RKH_ENABLED ]        "
@@ -0,0 +1,226 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+
+/**
+ *  \file       rkhfwk_buf.c
+ *  \ingroup    fwk
+ *
+ *  \brief      Zero-copy buffer manager for large-payload events.
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.16  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/* ----------------------------- Include files ----------------------------- */
+#include "rkhassert.h"
+#include "rkhfwk_dynevt.h"
+#include "rkhfwk_buf.h"
+#include "rkhmempool.h"
+
+RKH_MODULE_NAME(rkhfwk_buf)
+
+#if RKH_CFG_FWK_BUF_EN == RKH_ENABLED
+/* ----------------------------- Local macros ------------------------------ */
+/* Size of the header that precedes the payload within a buffer block */
+#define RKH_BUF_HDR_SIZE    ((rui32_t)sizeof(RKHBufHdr))
+
+/* ------------------------------- Constants ------------------------------- */
+/* ---------------------------- Local data types --------------------------- */
+struct RKHBuf
+{
+    RKH_NREF_T nref;        /* # of buffer-descriptor events that refer it */
+    rui8_t pool;            /* index of the buffer pool that owns it */
+};
+
+/* keeps the payload aligned as a block returned by the memory pool */
+typedef union RKHBufHdr RKHBufHdr;
+union RKHBufHdr
+{
+    RKHBuf buf;
+    void *align[2];
+};
+
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+static RKH_MEMPOOL_T bufPools[RKH_CFG_FWK_MAX_BUF_POOL];
+
+/**
+ *  \brief
+ *  Number of registered buffer pools.
+ */
+static rui8_t nextFreeBufPool;
+
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+static void
+setBufEvt(RKH_BUFEVT_T *be, RKHBuf *buf, rui8_t *data, rui32_t len)
+{
+    be->evt.pool |= RKH_BUFEVT_FLAG;
+    be->buf = buf;
+    be->data = data;
+    be->len = len;
+}
+
+/* ---------------------------- Global functions --------------------------- */
+void
+rkh_buf_init(void)
+{
+    nextFreeBufPool = 0;
+}
+
+void
+rkh_buf_registerPool(void *sstart, rui32_t ssize, rui32_t bsize)
+{
+    RKH_MEMPOOL_T *mp;
+
+    RKH_REQUIRE((nextFreeBufPool < RKH_CFG_FWK_MAX_BUF_POOL) &&
+                (bsize > RKH_BUF_HDR_SIZE) &&
+                ((rui32_t)(RKH_MPSS_T)ssize == ssize) &&
+                ((rui32_t)(RKH_MPBS_T)bsize == bsize));
+    RKH_REQUIRE((nextFreeBufPool == 0) ||      /* in ascending order of size */
+                ((rui32_t)bufPools[nextFreeBufPool - 1].bsize <= bsize));
+
+    mp = &bufPools[nextFreeBufPool];
+    rkh_memPool_init(mp, sstart, (RKH_MPSS_T)ssize, (RKH_MPBS_T)bsize);
+    ++nextFreeBufPool;
+}
+
+RKH_BUFEVT_T *
+rkh_buf_ae(RKH_ES_T esize, RKH_SIG_T e, rui32_t len, const void *const sender)
+{
+    rInt i;
+    RKHBuf *buf;
+    RKH_BUFEVT_T *be;
+
+    RKH_REQUIRE(esize >= (RKH_ES_T)sizeof(RKH_BUFEVT_T));
+
+    /* the smallest pool that fits the payload, or the larger ones when it */
+    /* is empty */
+    for (i = 0, buf = (RKHBuf *)0; i < nextFreeBufPool; ++i)
+    {
+        if (len <= ((rui32_t)bufPools[i].bsize - RKH_BUF_HDR_SIZE))
+        {
+            buf = (RKHBuf *)rkh_memPool_get(&bufPools[i]);
+            if (buf != (RKHBuf *)0)
+            {
+                break;
+            }
+        }
+    }
+    if (buf == (RKHBuf *)0)
+    {
+        return (RKH_BUFEVT_T *)0;
+    }
+
+    be = (RKH_BUFEVT_T *)rkh_fwk_ae_try(esize, e, sender);
+    if (be == (RKH_BUFEVT_T *)0)
+    {
+        rkh_memPool_put(&bufPools[i], buf);
+        return (RKH_BUFEVT_T *)0;
+    }
+
+    buf->nref = 1;
+    buf->pool = (rui8_t)i;
+    setBufEvt(be, buf, (rui8_t *)buf + RKH_BUF_HDR_SIZE, len);
+    return be;
+}
+
+RKH_BUFEVT_T *
+rkh_buf_view(RKH_ES_T esize, RKH_SIG_T e, const RKH_BUFEVT_T *src, 
+             rui32_t offset, rui32_t len, const void *const sender)
+{
+    RKH_BUFEVT_T *be;
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
+    RKH_SR_ALLOC();
+#endif
+
+    RKH_REQUIRE((esize >= (RKH_ES_T)sizeof(RKH_BUFEVT_T)) &&
+                (src != (const RKH_BUFEVT_T *)0) &&
+                ((src->evt.pool & RKH_BUFEVT_FLAG) != 0) &&
+                (offset <= src->len) && (len <= (src->len - offset)));
+
+    be = (RKH_BUFEVT_T *)rkh_fwk_ae_try(esize, e, sender);
+    if (be != (RKH_BUFEVT_T *)0)
+    {
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+        (void)RKH_NREF_INC(&src->buf->nref);
+#else
+        RKH_ENTER_CRITICAL_();
+        ++src->buf->nref;
+        RKH_EXIT_CRITICAL_();
+#endif
+        setBufEvt(be, src->buf, src->data + offset, len);
+    }
+    return be;
+}
+
+void
+rkh_buf_release(RKH_BUFEVT_T *be)
+{
+    RKHBuf *buf;
+    RKH_NREF_T nref;
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
+    RKH_SR_ALLOC();
+#endif
+
+    RKH_REQUIRE((be != (RKH_BUFEVT_T *)0) && (be->buf != (RKHBuf *)0));
+    buf = be->buf;
+    be->buf = (RKHBuf *)0;
+
+    /* only the last reference to the buffer sees zero, so it is returned */
+    /* to its pool exactly once */
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+    nref = RKH_NREF_DEC(&buf->nref);
+#else
+    RKH_ENTER_CRITICAL_();
+    nref = --buf->nref;
+    RKH_EXIT_CRITICAL_();
+#endif
+    if (nref == 0)
+    {
+        RKH_REQUIRE(buf->pool < nextFreeBufPool);
+        rkh_memPool_put(&bufPools[buf->pool], buf);
+    }
+}
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
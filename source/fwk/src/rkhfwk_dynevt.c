@@ -54,12 +54,51 @@
 #include "rkhtrc_filter.h"
 #include "rkhassert.h"
 #include "rkhfwk_dynevt.h"
+#include "rkhfwk_hook.h"
+#include "rkhfwk_buf.h"
 
 RKH_MODULE_NAME(rkhfwk_dynevt)
 
 #if RKH_CFG_FWK_DYN_EVT_EN == RKH_ENABLED
 
 /* ----------------------------- Local macros ------------------------------ */
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+#define RKH_SCLASS(esize_) \
+    (((esize_) + (RKH_CFG_FWK_EVT_SCLASS_GRAN - 1)) / \
+     RKH_CFG_FWK_EVT_SCLASS_GRAN)
+#endif
+
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED && \
+    RKH_CFG_TRC_EN == RKH_ENABLED && RKH_CFG_TRC_FWK_EN == RKH_ENABLED
+/* the reference counter is atomic, thus only the trace needs the lock */
+#define RKH_GC_ENTER_CRITICAL_()    RKH_ENTER_CRITICAL_()
+#define RKH_GC_EXIT_CRITICAL_()     RKH_EXIT_CRITICAL_()
+#else
+#define RKH_GC_ENTER_CRITICAL_()    (void)0
+#define RKH_GC_EXIT_CRITICAL_()     (void)0
+#endif
+
+#define RKH_EVT_POOL_IDX(e_)        (rui8_t)(RKH_EVT_POOL_ID(e_) - 1)
+
+#if RKH_CFG_FWK_BUF_EN == RKH_ENABLED
+#define RKH_BUF_RELEASE(e_) \
+    if (((e_)->pool & RKH_BUFEVT_FLAG) != 0) \
+    { \
+        rkh_buf_release((RKH_BUFEVT_T *)(e_)); \
+    }
+#else
+#define RKH_BUF_RELEASE(e_)         (void)0
+#endif
+
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+/* local pools are placed after the global ones within evtPools[] */
+#define RKH_EVT_POOL_IS_VALID(idx_) \
+    (((idx_) < nextFreeEvtPool) || \
+     (((idx_) >= RKH_CFG_FWK_MAX_EVT_POOL) && ((idx_) < nextFreeLocalPool)))
+#else
+#define RKH_EVT_POOL_IS_VALID(idx_) ((idx_) < nextFreeEvtPool)
+#endif
+
 /* ------------------------------- Constants ------------------------------- */
 /* ---------------------------- Local data types --------------------------- */
 typedef struct RKHEvtPoolMgr RKHEvtPoolMgr;
@@ -67,10 +106,14 @@ struct RKHEvtPoolMgr
 {
     RKH_ES_T blockSize;
     RKHEvtPool *evtPool;
+    rui32_t nExhausted;     /* # of times it was found without free blocks */
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+    rui8_t affinity;        /* owner of a local pool */
+#endif
 };
 
 /* ---------------------------- Global variables --------------------------- */
-static RKHEvtPoolMgr evtPools[RKH_CFG_FWK_MAX_EVT_POOL];
+static RKHEvtPoolMgr evtPools[RKH_EVTPOOL_NUM];
 
 /* ---------------------------- Local variables ---------------------------- */
 /**
@@ -79,15 +122,221 @@ static RKHEvtPoolMgr evtPools[RKH_CFG_FWK_MAX_EVT_POOL];
  */
 static rui8_t nextFreeEvtPool;
 
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Index of the next free local event pool. The local pools take up 
+ *  evtPools[RKH_CFG_FWK_MAX_EVT_POOL..nextFreeLocalPool - 1].
+ */
+static rui8_t nextFreeLocalPool;
+#endif
+
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Maps a size class, (esize + granularity - 1) / granularity, to the 
+ *  index of the first registered pool that could hold any event size of 
+ *  that class, that is, the first one whose block size is greater than 
+ *  the smallest size of the class. As block sizes need not be multiples 
+ *  of the granularity, findEvtPool() advances from there while the 
+ *  requested size does not fit. A value equal to nextFreeEvtPool means 
+ *  that no pool fits the class.
+ */
+static rui8_t sizeClass[RKH_CFG_FWK_EVT_SCLASS_NUM + 1];
+#endif
+
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+static void
+buildSizeClass(void)
+{
+    rui32_t sc;
+    rui8_t i;
+
+    for (sc = 0, i = 0; sc <= RKH_CFG_FWK_EVT_SCLASS_NUM; ++sc)
+    {
+        while ((i < nextFreeEvtPool) && 
+               (((rui32_t)evtPools[i].blockSize + 
+                 RKH_CFG_FWK_EVT_SCLASS_GRAN) <= 
+                (sc * RKH_CFG_FWK_EVT_SCLASS_GRAN)))
+        {
+            ++i;
+        }
+        sizeClass[sc] = i;
+    }
+}
+
+static rInt
+findEvtPool(RKH_ES_T esize)
+{
+    rInt i;
+
+    i = (RKH_SCLASS(esize) <= RKH_CFG_FWK_EVT_SCLASS_NUM) ? 
+            sizeClass[RKH_SCLASS(esize)] : 
+            sizeClass[RKH_CFG_FWK_EVT_SCLASS_NUM];
+    while ((i < nextFreeEvtPool) && (esize > evtPools[i].blockSize))
+    {
+        ++i;
+    }
+    return i;
+}
+#endif
+
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+static RKH_EVT_T *
+getLocalEvt(RKH_ES_T esize, rInt *pool)
+{
+    rInt i;
+    rui8_t affinity;
+    RKHEvtPoolMgr *ep;
+    RKH_EVT_T *evt;
+    RKH_SR_ALLOC();
+
+    affinity = rkh_fwk_getAffinity();
+    if (affinity == RKH_EVT_NO_AFFINITY)
+    {
+        return RKH_EVT_CAST(0);
+    }
+    for (i = RKH_CFG_FWK_MAX_EVT_POOL, ep = &evtPools[i]; 
+         i < nextFreeLocalPool; ++i, ++ep)
+    {
+        if ((ep->affinity == affinity) && (esize <= ep->blockSize))
+        {
+            evt = rkh_evtPool_get(ep->evtPool);
+            if (evt != RKH_EVT_CAST(0))
+            {
+                *pool = i;
+                return evt;
+            }
+            RKH_ENTER_CRITICAL_();
+            ++ep->nExhausted;
+            RKH_EXIT_CRITICAL_();
+        }
+    }
+    return RKH_EVT_CAST(0);
+}
+#endif
+
+static RKH_EVT_T *
+getEvt(RKH_ES_T esize, rInt *pool)
+{
+    rInt i;
+    RKHEvtPoolMgr *ep;
+    RKH_EVT_T *evt;
+    RKH_SR_ALLOC();
+
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+    /* the local pools of the caller are preferred over the global ones */
+    if ((evt = getLocalEvt(esize, pool)) != RKH_EVT_CAST(0))
+    {
+        return evt;
+    }
+#endif
+
+    /* find the pool index that fits the requested event size ... */
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+    i = findEvtPool(esize);
+    ep = &evtPools[i];
+#else
+    for (i = 0, ep = evtPools; 
+         (i < nextFreeEvtPool) && 
+         (esize > rkh_evtPool_getBlockSize(ep->evtPool)); 
+         ++ep, ++i)
+    {
+        ;
+    }
+#endif
+    if (i >= nextFreeEvtPool)           /* no registered pool fits it? */
+    {
+        return RKH_EVT_CAST(0);
+    }
+
+    /* ... and spill over to the larger ones when it is empty */
+    while ((evt = rkh_evtPool_get(ep->evtPool)) == RKH_EVT_CAST(0))
+    {
+        RKH_ENTER_CRITICAL_();
+        ++ep->nExhausted;
+        RKH_EXIT_CRITICAL_();
+
+        if (++i >= nextFreeEvtPool)
+        {
+            break;
+        }
+        ++ep;
+    }
+    *pool = i;
+    return evt;
+}
+
+static void
+setEvt(RKH_EVT_T *evt, RKH_SIG_T e, rInt pool, RKH_ES_T esize, 
+       const void *const sender)
+{
+#if RKH_CFG_HOOK_EVTPOOL_LOW_EN == RKH_ENABLED
+    rui32_t nFree;
+#endif
+    RKH_SR_ALLOC();
+
+    evt->e = e;                          /* set signal for this event */
+    evt->nref = (RKH_NREF_T)0;           /* Store the dynamic attributes of */
+                                         /* the event: the pool ID and the */
+    evt->pool = (rui8_t)(pool + 1);      /* reference counter = 0 */
+                                         
+    RKH_TR_FWK_AE(esize, evt, 
+                  rkh_evtPool_getNumUsed(evtPools[pool].evtPool), 
+                  rkh_evtPool_getNumMin(evtPools[pool].evtPool), sender);
+
+#if RKH_CFG_HOOK_EVTPOOL_LOW_EN == RKH_ENABLED
+    nFree = (rui32_t)(rkh_evtPool_getNumBlock(evtPools[pool].evtPool) - 
+                      rkh_evtPool_getNumUsed(evtPools[pool].evtPool));
+    if (nFree == RKH_CFG_HOOK_EVTPOOL_LOW_NFREE)   /* just crossed it down? */
+    {
+        RKH_HOOK_EVTPOOL_LOW((rui8_t)pool, nFree);
+    }
+#endif
+}
+
 /* ---------------------------- Global functions --------------------------- */
 void
 rkh_fwk_gc(RKH_EVT_T *e, const void *const sender)
 {
     RKHEvtPoolMgr * ep;
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+    RKH_NREF_T nref;
+#endif
     RKH_SR_ALLOC();
 
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+    if (e->nref != 0)       /* is it a dynamic event? */
+    {
+        /* 
+         * Only the caller that drops the counter to zero sees it, thus 
+         * the event is returned to its pool exactly once.
+         */
+        nref = RKH_NREF_DEC(&e->nref);
+        if (nref != 0)      /* isn't this the last ref? */
+        {
+            RKH_GC_ENTER_CRITICAL_();
+            RKH_TR_FWK_GC(e, RKH_EVT_POOL_ID(e), nref);
+            RKH_GC_EXIT_CRITICAL_();
+        }
+        else    /* this is the last reference to this event, recycle it */
+        {
+            rui8_t evtPoolIdx = RKH_EVT_POOL_IDX(e);
+
+            RKH_REQUIRE(RKH_EVT_POOL_IS_VALID(evtPoolIdx));
+            ep = &evtPools[evtPoolIdx]; 
+            RKH_GC_ENTER_CRITICAL_();
+            RKH_TR_FWK_GCR(e, rkh_evtPool_getNumUsed(ep->evtPool) - 1, 
+                           rkh_evtPool_getNumMin(ep->evtPool), sender);
+            RKH_GC_EXIT_CRITICAL_();
+
+            RKH_BUF_RELEASE(e);
+            rkh_evtPool_put(ep->evtPool, e);
+        }
+    }
+#else
     if (e->nref != 0)       /* is it a dynamic event? */
     {
         RKH_ENTER_CRITICAL_();
@@ -95,79 +344,125 @@ rkh_fwk_gc(RKH_EVT_T *e, const void *const sender)
         if (e->nref > 1)    /* isn't this the last ref? */
         {
             --e->nref;      /* decrement the reference counter */
-            RKH_TR_FWK_GC(e, e->pool, e->nref);
+            RKH_TR_FWK_GC(e, RKH_EVT_POOL_ID(e), e->nref);
             RKH_EXIT_CRITICAL_();
         }
         else    /* this is the last reference to this event, recycle it */
         {
-            rui8_t evtPoolIdx = (rui8_t)(e->pool - 1);
+            rui8_t evtPoolIdx = RKH_EVT_POOL_IDX(e);
 
-            RKH_REQUIRE(evtPoolIdx < nextFreeEvtPool); /* cannot wrap around */
+            RKH_REQUIRE(RKH_EVT_POOL_IS_VALID(evtPoolIdx));
             ep = &evtPools[evtPoolIdx]; 
             RKH_TR_FWK_GCR(e, rkh_evtPool_getNumUsed(ep->evtPool) - 1, 
                            rkh_evtPool_getNumMin(ep->evtPool), sender);
             RKH_EXIT_CRITICAL_();
 
+            RKH_BUF_RELEASE(e);
             rkh_evtPool_put(ep->evtPool, e);
         }
     }
+#endif
 }
 
 void
 rkh_fwk_reserve(RKH_EVT_T *e)
 {
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+    RKH_INC_REF(e);
+#else
     RKH_SR_ALLOC();
 
     RKH_ENTER_CRITICAL_();
     RKH_INC_REF(e);
     RKH_EXIT_CRITICAL_();
+#endif
 }
 
 RKH_EVT_T *
 rkh_fwk_ae(RKH_ES_T esize, RKH_SIG_T e, const void *const sender)
 {
     rInt i;
-    RKHEvtPoolMgr *ep;
     RKH_EVT_T *evt;
-    RKH_SR_ALLOC();
 
-    /* find the pool index that fits the requested event size ... */
-    for (i = 0, ep = evtPools; 
-         (i < nextFreeEvtPool) && 
-         (esize > rkh_evtPool_getBlockSize(ep->evtPool)); 
-         ++ep, ++i)
+    evt = getEvt(esize, &i);
+    RKH_ENSURE(evt != RKH_EVT_CAST(0));  /* a pool must fit it and not run */
+                                         /* out of events */
+    setEvt(evt, e, i, esize, sender);
+    return evt;
+}
+
+RKH_EVT_T *
+rkh_fwk_ae_try(RKH_ES_T esize, RKH_SIG_T e, const void *const sender)
+{
+    rInt i;
+    RKH_EVT_T *evt;
+
+    evt = getEvt(esize, &i);
+    if (evt != RKH_EVT_CAST(0))
     {
-        ;
+        setEvt(evt, e, i, esize, sender);
     }
-    RKH_ENSURE(i < nextFreeEvtPool);    /* cannot run out of registered pools */
-    evt = rkh_evtPool_get(ep->evtPool);
-    RKH_ENSURE(evt != RKH_EVT_CAST(0));  /* pool must not run out of events */
-
-    evt->e = e;                          /* set signal for this event */
-    evt->nref = (rui8_t)0;               /* Store the dynamic attributes of */
-                                         /* the event: the pool ID and the */
-    evt->pool = (rui8_t)(i + (rui8_t)1); /* reference counter = 0 */
-                                         
-    RKH_TR_FWK_AE(esize, evt, rkh_evtPool_getNumUsed(ep->evtPool), 
-                  rkh_evtPool_getNumMin(ep->evtPool), sender);
     return evt;
 }
 
+rui32_t
+rkh_fwk_getNumExhausted(rui8_t poolId)
+{
+    RKH_REQUIRE(RKH_EVT_POOL_IS_VALID(poolId));
+    return evtPools[poolId].nExhausted;
+}
+
 void
 rkh_fwk_registerEvtPool(void *sstart, rui32_t ssize, RKH_ES_T esize)
 {
     RKHEvtPool *ep;
     RKH_SR_ALLOC();
 
-    RKH_REQUIRE((nextFreeEvtPool + 1) <= RKH_CFG_FWK_MAX_EVT_POOL);
-    ep = rkh_evtPool_getPool(sstart, (rui16_t)ssize, esize);
+    RKH_REQUIRE(((nextFreeEvtPool + 1) <= RKH_CFG_FWK_MAX_EVT_POOL) &&
+                ((rui32_t)(RKH_MPSS_T)ssize == ssize));  /* see SIZEOF_SSIZE */
+    ep = rkh_evtPool_getPool(sstart, (RKH_MPSS_T)ssize, esize);
     RKH_ENSURE(ep != (RKHEvtPool *)0);
     evtPools[nextFreeEvtPool].evtPool = ep;
+    evtPools[nextFreeEvtPool].nExhausted = 0;
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+    evtPools[nextFreeEvtPool].blockSize = 
+                                    (RKH_ES_T)rkh_evtPool_getBlockSize(ep);
+    RKH_REQUIRE((nextFreeEvtPool == 0) ||      /* in ascending order of size */
+                (evtPools[nextFreeEvtPool - 1].blockSize <= 
+                 evtPools[nextFreeEvtPool].blockSize));
+#endif
     ++nextFreeEvtPool;
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+    buildSizeClass();
+#endif
     RKH_TR_FWK_EPREG(nextFreeEvtPool, ssize, esize, 
                      rkh_evtPool_getNumBlock(ep));
 }
 
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+void
+rkh_fwk_registerLocalEvtPool(void *sstart, rui32_t ssize, RKH_ES_T esize, 
+                             rui8_t affinity)
+{
+    RKHEvtPool *ep;
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((nextFreeLocalPool < RKH_EVTPOOL_NUM) &&
+                (affinity != RKH_EVT_NO_AFFINITY) &&
+                ((rui32_t)(RKH_MPSS_T)ssize == ssize));  /* see SIZEOF_SSIZE */
+    ep = rkh_evtPool_getPool(sstart, (RKH_MPSS_T)ssize, esize);
+    RKH_ENSURE(ep != (RKHEvtPool *)0);
+    evtPools[nextFreeLocalPool].evtPool = ep;
+    evtPools[nextFreeLocalPool].nExhausted = 0;
+    evtPools[nextFreeLocalPool].affinity = affinity;
+    evtPools[nextFreeLocalPool].blockSize = 
+                                    (RKH_ES_T)rkh_evtPool_getBlockSize(ep);
+    ++nextFreeLocalPool;
+    RKH_TR_FWK_EPREG(nextFreeLocalPool, ssize, esize, 
+                     rkh_evtPool_getNumBlock(ep));
+}
+#endif
+
 void
 rkh_dynEvt_init(void)
 {
@@ -175,10 +470,17 @@ rkh_dynEvt_init(void)
     RKHEvtPoolMgr *ep;
 
     nextFreeEvtPool = 0;
-    for (i = 0, ep = evtPools; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i)
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+    nextFreeLocalPool = RKH_CFG_FWK_MAX_EVT_POOL;
+#endif
+    for (i = 0, ep = evtPools; i < RKH_EVTPOOL_NUM; ++i, ++ep)
     {
         ep->evtPool = (RKHEvtPool *)0;
+        ep->nExhausted = 0;
     }
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+    buildSizeClass();
+#endif
 }
 #endif
 
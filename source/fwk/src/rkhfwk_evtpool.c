@@ -70,7 +70,7 @@ struct RKHEvtPool
 
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
-static RKHEvtPool evtPools[RKH_CFG_FWK_MAX_EVT_POOL];
+static RKHEvtPool evtPools[RKH_EVTPOOL_NUM];
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
@@ -81,19 +81,19 @@ rkh_evtPool_init(void)
     rInt i;
     RKHEvtPool *ep;
 
-    for (i = 0, ep = evtPools; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i, ++ep)
+    for (i = 0, ep = evtPools; i < RKH_EVTPOOL_NUM; ++i, ++ep)
     {
         ((RKH_MEMPOOL_T *)ep)->nblocks = 0;
     }
 }
 
 RKHEvtPool *
-rkh_evtPool_getPool(void *stoStart, rui16_t stoSize, RKH_ES_T evtSize)
+rkh_evtPool_getPool(void *stoStart, RKH_MPSS_T stoSize, RKH_ES_T evtSize)
 {
     rInt i;
     RKHEvtPool *ep;
 
-    for (i = 0, ep = evtPools; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i, ++ep)
+    for (i = 0, ep = evtPools; i < RKH_EVTPOOL_NUM; ++i, ++ep)
     {
         if (((RKH_MEMPOOL_T *)ep)->nblocks == 0)
         {
@@ -105,12 +105,12 @@ rkh_evtPool_getPool(void *stoStart, rui16_t stoSize, RKH_ES_T evtSize)
     return (RKHEvtPool *)0;
 }
 
-rui8_t 
+RKH_MPBS_T 
 rkh_evtPool_getBlockSize(RKHEvtPool *const me)
 {
     RKH_REQUIRE(me != (RKHEvtPool *)0);
-    return (rui8_t)((RKH_MEMPOOL_T *)me)->bsize;
-    /* return (rui8_t)rkh_memPool_get_bsize((RKH_MEMPOOL_T *)me); */
+    return ((RKH_MEMPOOL_T *)me)->bsize;
+    /* return rkh_memPool_get_bsize((RKH_MEMPOOL_T *)me); */
 }
 
 RKH_EVT_T *
@@ -127,26 +127,40 @@ rkh_evtPool_put(RKHEvtPool *const me, RKH_EVT_T *evt)
     rkh_memPool_put((RKH_MEMPOOL_T *)me, evt);
 }
 
-rui8_t 
+RKH_MPNB_T 
 rkh_evtPool_getNumUsed(RKHEvtPool *const me)
 {
+    RKH_MPNB_T nUsed;
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    rui8_t slot;
+#endif
+
     RKH_REQUIRE(me != (RKHEvtPool *)0);
-    return (rui8_t)(((RKH_MEMPOOL_T *)me)->nblocks - ((RKH_MEMPOOL_T *)me)->nfree);
+    nUsed = (RKH_MPNB_T)(((RKH_MEMPOOL_T *)me)->nblocks - 
+                         ((RKH_MEMPOOL_T *)me)->nfree);
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    /* the blocks stashed in the magazines are free, not used */
+    for (slot = 0; slot < RKH_CFG_FWK_MAX_SMA; ++slot)
+    {
+        nUsed -= ((RKH_MEMPOOL_T *)me)->mag[slot].nblk;
+    }
+#endif
+    return nUsed;
 }
 
-rui8_t 
+RKH_MPNB_T 
 rkh_evtPool_getNumMin(RKHEvtPool *const me)
 {
     RKH_REQUIRE(me != (RKHEvtPool *)0);
-    return (rui8_t)(((RKH_MEMPOOL_T *)me)->nmin);
-    /* return (rui8_t)rkh_memPool_get_low_wmark((RKH_MEMPOOL_T *)me); */
+    return ((RKH_MEMPOOL_T *)me)->nmin;
+    /* return rkh_memPool_get_low_wmark((RKH_MEMPOOL_T *)me); */
 }
 
-rui8_t 
+RKH_MPNB_T 
 rkh_evtPool_getNumBlock(RKHEvtPool *const me)
 {
     RKH_REQUIRE(me != (RKHEvtPool *)0);
-    return (rui8_t)(((RKH_MEMPOOL_T *)me)->nblocks);
+    return ((RKH_MEMPOOL_T *)me)->nblocks;
 }
 #endif
 
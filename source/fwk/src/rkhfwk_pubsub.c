@@ -80,12 +80,41 @@
 RKH_MODULE_NAME(rkhfwk_pubsub)
 
 /* ----------------------------- Local macros ------------------------------ */
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+/* 
+ * Fibonacci hashing, it spreads consecutive topic IDs, as the ones of 
+ * per-device topics, across the buckets.
+ */
+#define RKH_TOPIC_HASH(topic_) \
+    (rui32_t)((((rui32_t)(topic_) * 0x9E3779B1uL) & 0xFFFFFFFFuL) >> \
+              (32 - RKH_CFG_FWK_TOPIC_HASH_BITS))
+#endif
+
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+#define RKH_PUBSUB_ACCEPTS(arg_, sma_) \
+    passFilter((arg_)->filters[RKH_GET_PRIO(sma_)], (arg_)->event, (sma_))
+#else
+#define RKH_PUBSUB_ACCEPTS(arg_, sma_)      RKH_TRUE
+#endif
+
 /* ------------------------------- Constants ------------------------------- */
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+#define RKH_TOPIC_NUM_BUCKETS   (1u << RKH_CFG_FWK_TOPIC_HASH_BITS)
+#endif
+
 /* ---------------------------- Local data types --------------------------- */
 typedef struct PubSub PubSub;
 struct PubSub
 {
     RKHRdyGrp channels[RKH_CFG_FWK_MAX_SUBS_CHANNELS];
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+    RKH_SUBS_T *topics[RKH_TOPIC_NUM_BUCKETS];
+    RKH_SUBS_T *prefixes;
+#endif
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    const RKH_PUBSUB_FILTER_T *filters[RKH_CFG_FWK_MAX_SUBS_CHANNELS]
+                                      [RKH_CFG_FWK_MAX_SMA];
+#endif
 };
 
 typedef struct PubArg PubArg;
@@ -94,14 +123,87 @@ struct PubArg
     RdyCbArg base;
     RKH_EVT_T *event;
     const void *sender;
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    /* snapshot of the subscribers' filters, taken along with them */
+    const RKH_PUBSUB_FILTER_T *filters[RKH_CFG_FWK_MAX_SMA];
+#endif
 };
 
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
 static PubSub observer;     /* Singleton */
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED && \
+    RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+/* marks the active objects not yet matched by a topic subscription */
+static const RKH_PUBSUB_FILTER_T unmatched = {0, 0, (RKH_PUBSUB_PRED_T)0};
+#endif
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+static rbool_t
+inRange(const RKH_PUBSUB_FILTER_T *filter, const RKH_EVT_T *e)
+{
+    return (rbool_t)((filter == (const RKH_PUBSUB_FILTER_T *)0) || 
+                     ((e->e >= filter->minSig) && (e->e <= filter->maxSig)));
+}
+
+static rbool_t
+passFilter(const RKH_PUBSUB_FILTER_T *filter, const RKH_EVT_T *e, 
+           const RKH_SMA_T *ao)
+{
+    if (filter == (const RKH_PUBSUB_FILTER_T *)0)
+    {
+        return RKH_TRUE;
+    }
+    return (rbool_t)(inRange(filter, e) &&
+                     ((filter->pred == (RKH_PUBSUB_PRED_T)0) || 
+                      filter->pred(e, ao)));
+}
+#endif
+
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+static RKH_SUBS_T **
+getTopicList(const RKH_SUBS_T *subs)
+{
+    return (subs->mask == RKH_TOPIC_EXACT) ? 
+                &observer.topics[RKH_TOPIC_HASH(subs->topic)] :
+                &observer.prefixes;
+}
+
+/* 
+ * Adds the active object of a matching subscription to the subscribers 
+ * of a topic. It runs within the critical section, thus it only takes 
+ * the subscription's filter, which is evaluated later by publish(). When 
+ * an active object is matched by several subscriptions, a missing filter 
+ * wins, then a filter whose signal range admits the event.
+ */
+static void
+addTopicSubscriber(PubArg *arg, RKHRdyGrp *subscribers, 
+                   const RKH_SUBS_T *subs)
+{
+    rui8_t prio;
+
+    prio = RKH_GET_PRIO(subs->ao);
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    if (arg->filters[prio] == &unmatched)
+    {
+        arg->filters[prio] = subs->filter;
+    }
+    else if ((arg->filters[prio] != (const RKH_PUBSUB_FILTER_T *)0) && 
+             ((subs->filter == (const RKH_PUBSUB_FILTER_T *)0) || 
+              ((inRange(arg->filters[prio], arg->event) == RKH_FALSE) && 
+               inRange(subs->filter, arg->event))))
+    {
+        arg->filters[prio] = subs->filter;
+    }
+#else
+    (void)arg;
+#endif
+    rkh_rdygrp_setReady(subscribers, prio);
+}
+#endif
+
 /* ---------------------------- Global functions --------------------------- */
 void 
 rkh_pubsub_init(void)
@@ -115,6 +217,30 @@ rkh_pubsub_init(void)
     {
         rkh_rdygrp_init(pCh);
     }
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+    {
+        rui32_t nBucket;
+
+        for (nBucket = 0; nBucket < RKH_TOPIC_NUM_BUCKETS; ++nBucket)
+        {
+            observer.topics[nBucket] = (RKH_SUBS_T *)0;
+        }
+        observer.prefixes = (RKH_SUBS_T *)0;
+    }
+#endif
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    {
+        rui8_t nAo;
+
+        for (nCh = 0; nCh < RKH_CFG_FWK_MAX_SUBS_CHANNELS; ++nCh)
+        {
+            for (nAo = 0; nAo < RKH_CFG_FWK_MAX_SMA; ++nAo)
+            {
+                observer.filters[nCh][nAo] = (const RKH_PUBSUB_FILTER_T *)0;
+            }
+        }
+    }
+#endif
 }
 
 void
@@ -126,8 +252,28 @@ rkh_pubsub_subscribe(rui8_t channel, const RKH_SMA_T *ao)
                 (channel < RKH_CFG_FWK_MAX_SUBS_CHANNELS));
     RKH_ENTER_CRITICAL_();
     rkh_rdygrp_setReady(&observer.channels[channel], RKH_GET_PRIO(ao));
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    observer.filters[channel][RKH_GET_PRIO(ao)] = 
+                                            (const RKH_PUBSUB_FILTER_T *)0;
+#endif
+    RKH_EXIT_CRITICAL_();
+}
+
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+void
+rkh_pubsub_subscribeFilter(rui8_t channel, const RKH_SMA_T *ao, 
+                           const RKH_PUBSUB_FILTER_T *filter)
+{
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((ao != (const RKH_SMA_T *)0) && 
+                (channel < RKH_CFG_FWK_MAX_SUBS_CHANNELS));
+    RKH_ENTER_CRITICAL_();
+    observer.filters[channel][RKH_GET_PRIO(ao)] = filter;
+    rkh_rdygrp_setReady(&observer.channels[channel], RKH_GET_PRIO(ao));
     RKH_EXIT_CRITICAL_();
 }
+#endif
 
 void
 rkh_pubsub_unsubscribe(rui8_t channel, const RKH_SMA_T *ao)
@@ -138,6 +284,10 @@ rkh_pubsub_unsubscribe(rui8_t channel, const RKH_SMA_T *ao)
                 (channel < RKH_CFG_FWK_MAX_SUBS_CHANNELS));
     RKH_ENTER_CRITICAL_();
     rkh_rdygrp_setUnready(&observer.channels[channel], RKH_GET_PRIO(ao));
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    observer.filters[channel][RKH_GET_PRIO(ao)] = 
+                                            (const RKH_PUBSUB_FILTER_T *)0;
+#endif
     RKH_EXIT_CRITICAL_();
 }
 
@@ -156,6 +306,10 @@ rkh_pubsub_unsubscribeAll(const RKH_SMA_T *ao)
          ++nCh, ++pCh)
     {
         rkh_rdygrp_setUnready(pCh, RKH_GET_PRIO(ao));
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+        observer.filters[nCh][RKH_GET_PRIO(ao)] = 
+                                            (const RKH_PUBSUB_FILTER_T *)0;
+#endif
     }
     RKH_EXIT_CRITICAL_();
 }
@@ -164,13 +318,14 @@ void
 publish(RdyCbArg *arg)
 {
     PubArg *realArg;
+    RKH_SMA_T *sma;
 
-    RKH_REQUIRE(RKH_GET_SMA(arg->aoRdyPrio) != (const RKH_SMA_T *)0); 
+    sma = RKH_GET_SMA(arg->aoRdyPrio);
+    RKH_REQUIRE(sma != (const RKH_SMA_T *)0); 
     realArg = (PubArg *)arg;
-    if (RKH_GET_SMA(arg->aoRdyPrio) != realArg->sender)
+    if ((sma != realArg->sender) && RKH_PUBSUB_ACCEPTS(realArg, sma))
     {
-        RKH_SMA_POST_FIFO(RKH_GET_SMA(arg->aoRdyPrio), 
-                          realArg->event, realArg->sender);
+        RKH_SMA_POST_FIFO(sma, realArg->event, realArg->sender);
     }
 }
 
@@ -180,18 +335,156 @@ rkh_pubsub_publish(rui8_t channel, RKH_EVT_T *event,
 {
     rui8_t nRdyAo;
     PubArg publishArg;
+    RKHRdyGrp subscribers;
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE(channel < RKH_CFG_FWK_MAX_SUBS_CHANNELS);
+    publishArg.event = event;
+    publishArg.sender = sender;
+
+    /* 
+     * Take a snapshot of the subscribers, their filters and a guard 
+     * reference under a short critical section. The guard prevents the 
+     * event from being recycled by a subscriber before the fan-out ends, 
+     * thus the filters are evaluated and the posts, each one protected by 
+     * its own queue, are made outside of it.
+     */
+    RKH_ENTER_CRITICAL_();
+    RKH_INC_REF(event);
+    subscribers = observer.channels[channel];
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    for (nRdyAo = 0; nRdyAo < RKH_CFG_FWK_MAX_SMA; ++nRdyAo)
+    {
+        publishArg.filters[nRdyAo] = observer.filters[channel][nRdyAo];
+    }
+#endif
+    RKH_EXIT_CRITICAL_();
+
+    nRdyAo = rkh_rdygrp_traverse(&subscribers, publish, 
+                                 (RdyCbArg *)&publishArg);
+    RKH_FWK_GC(event, sender);
+    return nRdyAo;
+}
+
+#if RKH_CFG_FWK_TOPIC_EN == RKH_ENABLED
+void
+rkh_pubsub_subscribeTopic(RKH_SUBS_T *subs, RKH_TOPIC_T topic, 
+                          const RKH_SMA_T *ao)
+{
+    rkh_pubsub_subscribePrefix(subs, topic, RKH_TOPIC_EXACT, ao);
+}
+
+void
+rkh_pubsub_subscribePrefix(RKH_SUBS_T *subs, RKH_TOPIC_T prefix, 
+                           RKH_TOPIC_T mask, const RKH_SMA_T *ao)
+{
+    RKH_SUBS_T **list;
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((subs != (RKH_SUBS_T *)0) && (ao != (const RKH_SMA_T *)0));
+    subs->ao = ao;
+    subs->topic = (RKH_TOPIC_T)(prefix & mask);
+    subs->mask = mask;
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    subs->filter = (const RKH_PUBSUB_FILTER_T *)0;
+#endif
+    list = getTopicList(subs);
+
+    RKH_ENTER_CRITICAL_();
+    subs->next = *list;
+    *list = subs;
+    RKH_EXIT_CRITICAL_();
+}
+
+void
+rkh_pubsub_unsubscribeTopic(RKH_SUBS_T *subs)
+{
+    RKH_SUBS_T **link;
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE(subs != (RKH_SUBS_T *)0);
+    RKH_ENTER_CRITICAL_();
+    for (link = getTopicList(subs); 
+         (*link != (RKH_SUBS_T *)0) && (*link != subs); 
+         link = &(*link)->next)
+    {
+    }
+    if (*link == subs)
+    {
+        *link = subs->next;
+    }
+    RKH_EXIT_CRITICAL_();
+    subs->next = (RKH_SUBS_T *)0;
+}
+
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+void
+rkh_pubsub_filterTopic(RKH_SUBS_T *subs, const RKH_PUBSUB_FILTER_T *filter)
+{
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE(subs != (RKH_SUBS_T *)0);
+    RKH_ENTER_CRITICAL_();
+    subs->filter = filter;
+    RKH_EXIT_CRITICAL_();
+}
+#endif
+
+rui8_t 
+rkh_pubsub_publishTopic(RKH_TOPIC_T topic, RKH_EVT_T *event, 
+                        const void *const sender)
+{
+    rui8_t nRdyAo;
+    PubArg publishArg;
+    RKHRdyGrp subscribers;
+    const RKH_SUBS_T *subs;
     RKH_SR_ALLOC();
 
     publishArg.event = event;
     publishArg.sender = sender;
+    rkh_rdygrp_init(&subscribers);
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    for (nRdyAo = 0; nRdyAo < RKH_CFG_FWK_MAX_SMA; ++nRdyAo)
+    {
+        publishArg.filters[nRdyAo] = &unmatched;
+    }
+#endif
+
+    /* 
+     * Only the topic's bucket and the prefix list are visited. The 
+     * matching active objects and their filters are collected into a 
+     * ready group, which also drops duplicates, and then the filters are 
+     * evaluated and the event is posted outside of the critical section, 
+     * as rkh_pubsub_publish() does.
+     */
     RKH_ENTER_CRITICAL_();
     RKH_INC_REF(event);
-    nRdyAo = rkh_rdygrp_traverse(&observer.channels[channel], 
-                                 publish, (RdyCbArg *)&publishArg);
+    for (subs = observer.topics[RKH_TOPIC_HASH(topic)]; 
+         subs != (const RKH_SUBS_T *)0; 
+         subs = subs->next)
+    {
+        if (subs->topic == topic)
+        {
+            addTopicSubscriber(&publishArg, &subscribers, subs);
+        }
+    }
+    for (subs = observer.prefixes; 
+         subs != (const RKH_SUBS_T *)0; 
+         subs = subs->next)
+    {
+        if ((topic & subs->mask) == subs->topic)
+        {
+            addTopicSubscriber(&publishArg, &subscribers, subs);
+        }
+    }
     RKH_EXIT_CRITICAL_();
+
+    nRdyAo = rkh_rdygrp_traverse(&subscribers, publish, 
+                                 (RdyCbArg *)&publishArg);
     RKH_FWK_GC(event, sender);
     return nRdyAo;
 }
+#endif
 
 #endif
 /* ------------------------------ End of file ------------------------------ */
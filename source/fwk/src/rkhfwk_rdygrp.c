@@ -61,6 +61,19 @@
 RKH_MODULE_NAME(rkhfwk_rdygrp)
 
 /* ----------------------------- Local macros ------------------------------ */
+/* 
+ *  Position of the least significant bit set of a non-zero byte, i.e. its 
+ *  count of trailing zeros. The port could override it by means of a 
+ *  specific CPU instruction.
+ */
+#ifndef RKH_CTZ8
+    #if defined(__GNUC__)
+        #define RKH_CTZ8(x_)    (rui8_t)__builtin_ctz((unsigned int)(x_))
+    #else
+        #define RKH_CTZ8(x_)    rkh_bittbl_getLeastBitSetPos(x_)
+    #endif
+#endif
+
 /* ------------------------------- Constants ------------------------------- */
 /* ---------------------------- Local data types --------------------------- */
 /* ---------------------------- Global variables --------------------------- */
@@ -119,23 +132,20 @@ rui8_t
 rkh_rdygrp_traverse(RKHRdyGrp *const me, void (*rdyCb)(RdyCbArg *), 
                     RdyCbArg *rdyCbArg)
 {
-    rui8_t row, column, *pTbl, nBit, nRdyAO;
+    rui8_t rows, row, column, nRdyAO;
 
+    /* visit only the set bits, clearing the least significant one each */
+    /* time, thus the cost is proportional to the number of ready AOs */
     nRdyAO = 0;
-    if (me->grp != 0)
+    for (rows = me->grp; rows != 0; rows &= (rui8_t)(rows - 1))
     {
-        for (row = 0, pTbl = me->tbl; row < RKH_NUM_RDYGRP; ++pTbl, ++row)
+        row = RKH_CTZ8(rows);
+        for (column = me->tbl[row]; column != 0; 
+             column &= (rui8_t)(column - 1))
         {
-            for (column = *pTbl, nBit = 0; (column != 0) && (nBit < 8); 
-                 ++nBit, column >>= 1)
-            {
-                if ((column & 1) != 0)
-                {
-                    ++nRdyAO;
-                    rdyCbArg->aoRdyPrio = (row << 3) | nBit;
-                    (*rdyCb)(rdyCbArg);
-                }
-            }
+            ++nRdyAO;
+            rdyCbArg->aoRdyPrio = (rui8_t)((row << 3) | RKH_CTZ8(column));
+            (*rdyCb)(rdyCbArg);
         }
     }
     return nRdyAO;
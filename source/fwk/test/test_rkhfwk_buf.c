@@ -0,0 +1,328 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Recycle Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+
+/**
+ *  \file       test_rkhfwk_buf.c
+ *  \ingroup    test_fwk
+ *  \brief      Unit test for buffer manager of fwk module.
+ *
+ *  \addtogroup test
+ *  @{
+ *  \addtogroup test_fwk Framework
+ *  @{
+ *  \brief      Unit test for framework module.
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.16  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/* ----------------------------- Include files ----------------------------- */
+#include "unity.h"
+#include "rkhfwk_buf.h"
+#include "Mock_rkhfwk_dynevt.h"
+#include "Mock_rkhmempool.h"
+#include "Mock_rkhassert.h"
+#include "Mock_rkhport.h"
+
+/* ----------------------------- Local macros ------------------------------ */
+/* ------------------------------- Constants ------------------------------- */
+#define SMALL_BSIZE     64
+#define LARGE_BSIZE     128
+
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+static double storage[8];
+static double smallBlock[SMALL_BSIZE / sizeof(double)];
+static double largeBlock[LARGE_BSIZE / sizeof(double)];
+static RKH_BUFEVT_T evt, view;
+
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+static void 
+MockAssertCallback(const char* const file, int line, int cmock_num_calls)
+{
+    TEST_PASS();
+}
+
+static void 
+MockMemPoolInitCallback(RKH_MEMPOOL_T *mp, void* sstart, RKH_MPSS_T ssize, 
+                        RKH_MPBS_T bsize, int cmock_num_calls)
+{
+    mp->bsize = bsize;
+}
+
+static void
+registerPools(void)
+{
+    rkh_memPool_init_StubWithCallback(MockMemPoolInitCallback);
+    rkh_buf_registerPool(storage, sizeof(storage), SMALL_BSIZE);
+    rkh_buf_registerPool(storage, sizeof(storage), LARGE_BSIZE);
+}
+
+/* ---------------------------- Global functions --------------------------- */
+void
+setUp(void)
+{
+    Mock_rkhfwk_dynevt_Init();
+    Mock_rkhmempool_Init();
+    Mock_rkhassert_Init();
+    rkh_buf_init();
+    evt.evt.pool = 1;
+    evt.evt.nref = 0;
+    view.evt.pool = 1;
+    view.evt.nref = 0;
+}
+
+void
+tearDown(void)
+{
+    Mock_rkhfwk_dynevt_Verify();
+    Mock_rkhmempool_Verify();
+    Mock_rkhassert_Verify();
+    Mock_rkhfwk_dynevt_Destroy();
+    Mock_rkhmempool_Destroy();
+    Mock_rkhassert_Destroy();
+}
+
+/**
+ *  \addtogroup test_buf Test cases of buffer manager group
+ *  @{
+ *  \name Test cases of buffer manager group
+ *  @{ 
+ */
+void
+test_Fails_RegisterPoolsInDescendingOrder(void)
+{
+    rkh_memPool_init_StubWithCallback(MockMemPoolInitCallback);
+    rkh_assert_Expect("rkhfwk_buf", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    rkh_buf_registerPool(storage, sizeof(storage), LARGE_BSIZE);
+    rkh_buf_registerPool(storage, sizeof(storage), SMALL_BSIZE);
+}
+
+void
+test_AllocateBufEvt(void)
+{
+    RKH_BUFEVT_T *pEvt;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, smallBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&evt);
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 40, (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+    TEST_ASSERT_EQUAL(1 | RKH_BUFEVT_FLAG, pEvt->evt.pool);
+    TEST_ASSERT_EQUAL_PTR(smallBlock, pEvt->buf);
+    TEST_ASSERT_TRUE(pEvt->data > (rui8_t *)smallBlock);
+    TEST_ASSERT_TRUE((pEvt->data + 40) <= 
+                     ((rui8_t *)smallBlock + SMALL_BSIZE));
+    TEST_ASSERT_EQUAL(40, pEvt->len);
+}
+
+void
+test_AllocateBufEvtSpillsOverToLargerPool(void)
+{
+    RKH_BUFEVT_T *pEvt;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, 0);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_memPool_get_ExpectAndReturn(0, largeBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&evt);
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 40, (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+    TEST_ASSERT_EQUAL_PTR(largeBlock, pEvt->buf);
+}
+
+void
+test_TriesAllocateBufEvtExceededBufferSize(void)
+{
+    RKH_BUFEVT_T *pEvt;
+
+    registerPools();
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, LARGE_BSIZE, 
+                            (const void *)0xbeaf);
+
+    TEST_ASSERT_NULL(pEvt);
+}
+
+void
+test_TriesAllocateBufEvtWithoutFreeEvt(void)
+{
+    RKH_BUFEVT_T *pEvt;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, smallBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)0);
+    rkh_memPool_put_Expect(0, smallBlock);
+    rkh_memPool_put_IgnoreArg_mp();
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 40, (const void *)0xbeaf);
+
+    TEST_ASSERT_NULL(pEvt);
+}
+
+void
+test_ViewSharesBufferOfSourceEvt(void)
+{
+    RKH_BUFEVT_T *pEvt, *pView;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, smallBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&evt);
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 2, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&view);
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+#endif
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 40, (const void *)0xbeaf);
+    pView = RKH_BUFEVT_VIEW(RKH_BUFEVT_T, 2, pEvt, 10, 20, 
+                            (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&view, pView);
+    TEST_ASSERT_EQUAL(1 | RKH_BUFEVT_FLAG, pView->evt.pool);
+    TEST_ASSERT_EQUAL_PTR(pEvt->buf, pView->buf);
+    TEST_ASSERT_EQUAL_PTR(pEvt->data + 10, pView->data);
+    TEST_ASSERT_EQUAL(20, pView->len);
+}
+
+void
+test_Fails_ViewExceedsSourceEvt(void)
+{
+    RKH_BUFEVT_T *pEvt;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, smallBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&evt);
+    rkh_assert_Expect("rkhfwk_buf", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 40, (const void *)0xbeaf);
+    RKH_BUFEVT_VIEW(RKH_BUFEVT_T, 2, pEvt, 30, 20, (const void *)0xbeaf);
+}
+
+void
+test_ReleaseSharedBufferKeepsIt(void)
+{
+    RKH_BUFEVT_T *pEvt, *pView;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, smallBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&evt);
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 2, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&view);
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+#endif
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 40, (const void *)0xbeaf);
+    pView = RKH_BUFEVT_VIEW(RKH_BUFEVT_T, 2, pEvt, 10, 20, 
+                            (const void *)0xbeaf);
+    rkh_buf_release(pEvt);
+
+    TEST_ASSERT_NULL(pEvt->buf);
+    TEST_ASSERT_EQUAL_PTR(smallBlock, pView->buf);
+}
+
+void
+test_ReleaseLastReferenceReturnsBuffer(void)
+{
+    RKH_BUFEVT_T *pEvt;
+
+    registerPools();
+    rkh_memPool_get_ExpectAndReturn(0, largeBlock);
+    rkh_memPool_get_IgnoreArg_mp();
+    rkh_fwk_ae_try_ExpectAndReturn(sizeof(RKH_BUFEVT_T), 1, 
+                                   (const void *)0xbeaf, 
+                                   (RKH_EVT_T *)&evt);
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+#endif
+    rkh_memPool_put_Expect(0, largeBlock);
+    rkh_memPool_put_IgnoreArg_mp();
+
+    pEvt = RKH_ALLOC_BUFEVT(RKH_BUFEVT_T, 1, 100, (const void *)0xbeaf);
+    rkh_buf_release(pEvt);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+
+/* ------------------------------ End of file ------------------------------ */
@@ -62,6 +62,7 @@
 #include "Mock_rkhtrc_record.h"
 #include "Mock_rkhtrc_filter.h"
 #include "Mock_rkhport.h"
+#include "Mock_rkhfwk_buf.h"
 
 /* ----------------------------- Local macros ------------------------------ */
 /* ------------------------------- Constants ------------------------------- */
@@ -69,6 +70,7 @@
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
 static rui8_t *storage;
+static rui8_t affinity;
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
@@ -78,7 +80,48 @@ MockAssertCallback(const char* const file, int line, int cmock_num_calls)
     TEST_PASS();
 }
 
+static void
+expectRegisterEvtPool(RKH_ES_T esize, RKHEvtPool *ep)
+{
+    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), esize, ep);
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+    rkh_evtPool_getBlockSize_ExpectAndReturn(ep, esize);
+#endif
+}
+
+static void
+expectFindEvtPool(RKHEvtPool *ep, RKH_ES_T blockSize)
+{
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_DISABLED
+    rkh_evtPool_getBlockSize_ExpectAndReturn(ep, blockSize);
+#else
+    (void)ep;
+    (void)blockSize;
+#endif
+}
+
+static void
+registerEvtPools(void)
+{
+    int i, blockSize;
+    int *epAddress;
+
+    for (i = 0, epAddress = (int *)0xdead0000, blockSize = 4; 
+         i < RKH_CFG_FWK_MAX_EVT_POOL; 
+         ++i, (blockSize *= 2), ++epAddress)
+    {
+        expectRegisterEvtPool(blockSize, (RKHEvtPool *)epAddress);
+        rkh_fwk_registerEvtPool(storage, sizeof(storage), blockSize);
+    }
+}
+
 /* ---------------------------- Global functions --------------------------- */
+rui8_t
+rkh_fwk_getAffinity(void)
+{
+    return affinity;
+}
+
 void
 setUp(void)
 {
@@ -86,6 +129,7 @@ setUp(void)
     Mock_rkhfwk_evtpool_Init();
     rkh_trc_isoff__IgnoreAndReturn(RKH_FALSE);
     rkh_dynEvt_init();
+    affinity = RKH_EVT_NO_AFFINITY;
 }
 
 void
@@ -106,8 +150,7 @@ tearDown(void)
 void
 test_RegisterOneEventPool(void)
 {
-    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 4, 
-                                     (RKHEvtPool *)1);
+    expectRegisterEvtPool(4, (RKHEvtPool *)1);
     rkh_fwk_registerEvtPool(storage, sizeof(storage), 4);
 }
 
@@ -118,8 +161,7 @@ test_RegisterMultipleEventPool(void)
 
     for (i = 0; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i)
     {
-        rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 4, 
-                                         (RKHEvtPool *)1);
+        expectRegisterEvtPool(4, (RKHEvtPool *)1);
         rkh_fwk_registerEvtPool(storage, sizeof(storage), 4);
     }
 }
@@ -131,8 +173,7 @@ test_Fails_ExceedsNumberOfAllowedEventPools(void)
 
     for (i = 0; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i)
     {
-        rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 4, 
-                                         (RKHEvtPool *)1);
+        expectRegisterEvtPool(4, (RKHEvtPool *)1);
     }
     rkh_assert_Expect("rkhfwk_dynevt", 0);
     rkh_assert_IgnoreArg_file();
@@ -158,6 +199,18 @@ test_Fails_UnavailablePool(void)
     rkh_fwk_registerEvtPool(storage, sizeof(storage), 4);
 }
 
+void
+test_Fails_StorageSizeExceedsPoolSizeType(void)
+{
+    rkh_assert_Expect("rkhfwk_dynevt", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    rkh_fwk_registerEvtPool(storage,
+                            (rui32_t)((RKH_MPSS_T)~(RKH_MPSS_T)0) + 1u, 4);
+}
+
 void
 test_Fails_TriesAllocateOneEvtWithoutAssignedPool(void)
 {
@@ -175,7 +228,6 @@ test_Fails_TriesAllocateOneEvtWithoutAssignedPool(void)
 void
 test_AllocateOneEvt(void)
 {
-    int i, blockSize;
     RKH_EVT_T *pEvt, evt, *expectedEvt;
     int *epAddress;
     RKH_SIG_T sig;
@@ -189,20 +241,11 @@ test_AllocateOneEvt(void)
     evt.nref = 8;
     expectedEvt = &evt;
 
-    for (i = 0, epAddress = (int *)0xdead0000, blockSize = 4; 
-         i < RKH_CFG_FWK_MAX_EVT_POOL; 
-         ++i, (blockSize *= 2), ++epAddress)
-    {
-        rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 
-                                            blockSize, 
-                                            (RKHEvtPool *)epAddress);
-        rkh_fwk_registerEvtPool(storage, sizeof(storage), blockSize);
-    }
+    registerEvtPools();
     epAddress = (int *)0xdead0000;
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress), 4);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 1), 8);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 
-                                             16);
+    expectFindEvtPool((RKHEvtPool *)(epAddress), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
     rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 
                                     expectedEvt);
 
@@ -217,25 +260,15 @@ test_AllocateOneEvt(void)
 void
 test_Fails_ExceededBlockSize(void)
 {
-    int i, blockSize;
     RKH_EVT_T *evt;
     int *epAddress;
 
-    for (i = 0, epAddress = (int *)0xdead0000, blockSize = 4; 
-         i < RKH_CFG_FWK_MAX_EVT_POOL; 
-         ++i, (blockSize *= 2), ++epAddress)
-    {
-        rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 
-                                            blockSize, 
-                                            (RKHEvtPool *)epAddress);
-        rkh_fwk_registerEvtPool(storage, sizeof(storage), blockSize);
-    }
-
+    registerEvtPools();
     epAddress = (int *)0xdead0000;
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 0), 4);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 1), 8);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 16);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 3), 32);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 0), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 3), 32);
 
     rkh_assert_Expect("rkhfwk_dynevt", 0);
     rkh_assert_IgnoreArg_file();
@@ -250,24 +283,20 @@ test_Fails_ExceededBlockSize(void)
 void
 test_Fails_UnavailableBlockFromPool(void)
 {
-    int i, blockSize;
     RKH_EVT_T *evt;
     int *epAddress;
 
-    for (i = 0, epAddress = (int *)0xdead0000, blockSize = 4; 
-         i < RKH_CFG_FWK_MAX_EVT_POOL; 
-         ++i, (blockSize *= 2), ++epAddress)
-    {
-        rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 
-                                            blockSize, 
-                                            (RKHEvtPool *)epAddress);
-        rkh_fwk_registerEvtPool(storage, sizeof(storage), blockSize);
-    }
+    registerEvtPools();
     epAddress = (int *)0xdead0000;
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 0), 4);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 1), 8);
-    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 16);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 0), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
     rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 3), 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
 
     rkh_assert_Expect("rkhfwk_dynevt", 0);
     rkh_assert_IgnoreArg_file();
@@ -279,6 +308,269 @@ test_Fails_UnavailableBlockFromPool(void)
     TEST_ASSERT_NULL(evt);
 }
 
+void
+test_AllocateOneEvtSpillsOverToLargerPool(void)
+{
+    RKH_EVT_T *pEvt, evt;
+    int *epAddress;
+
+    registerEvtPools();
+    epAddress = (int *)0xdead0000;
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 0), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 3), &evt);
+
+    pEvt = rkh_fwk_ae(9, 1, (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+    TEST_ASSERT_EQUAL(1, pEvt->e);
+    TEST_ASSERT_EQUAL(4, pEvt->pool);
+    TEST_ASSERT_EQUAL(1, rkh_fwk_getNumExhausted(2));
+}
+
+void
+test_TriesAllocateOneEvtSpillsOverToLargerPool(void)
+{
+    RKH_EVT_T *pEvt, evt;
+    int *epAddress;
+
+    registerEvtPools();
+    epAddress = (int *)0xdead0000;
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 0), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 3), &evt);
+
+    pEvt = rkh_fwk_ae_try(9, 1, (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+    TEST_ASSERT_EQUAL(1, pEvt->e);
+    TEST_ASSERT_EQUAL(4, pEvt->pool);
+    TEST_ASSERT_EQUAL(0, pEvt->nref);
+    TEST_ASSERT_EQUAL(1, rkh_fwk_getNumExhausted(2));
+    TEST_ASSERT_EQUAL(0, rkh_fwk_getNumExhausted(3));
+}
+
+void
+test_TriesAllocateOneEvtFromExhaustedPools(void)
+{
+    RKH_EVT_T *evt;
+    int *epAddress;
+
+    registerEvtPools();
+    epAddress = (int *)0xdead0000;
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 0), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 2), 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)(epAddress + 3), 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+
+    evt = rkh_fwk_ae_try(9, 1, (const void *)0xbeaf);
+
+    TEST_ASSERT_NULL(evt);
+    TEST_ASSERT_EQUAL(0, rkh_fwk_getNumExhausted(1));
+    TEST_ASSERT_EQUAL(1, rkh_fwk_getNumExhausted(2));
+    TEST_ASSERT_EQUAL(1, rkh_fwk_getNumExhausted(3));
+}
+
+void
+test_TriesAllocateOneEvtLargerThanEveryPool(void)
+{
+    RKH_EVT_T *evt;
+    int *epAddress;
+
+    registerEvtPools();
+    epAddress = (int *)0xdead0000;
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 0), 4);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 1), 8);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 2), 16);
+    expectFindEvtPool((RKHEvtPool *)(epAddress + 3), 32);
+
+    evt = rkh_fwk_ae_try(33, 1, (const void *)0xbeaf);
+
+    TEST_ASSERT_NULL(evt);
+    TEST_ASSERT_EQUAL(0, rkh_fwk_getNumExhausted(3));
+}
+
+void
+test_AllocateOneEvtFromLocalPool(void)
+{
+    RKH_EVT_T *pEvt, evt;
+
+    expectRegisterEvtPool(16, (RKHEvtPool *)0xdead0000);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 16);
+    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 16, 
+                                        (RKHEvtPool *)0xdead0010);
+    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)0xdead0010, 16);
+    rkh_fwk_registerLocalEvtPool(storage, sizeof(storage), 16, 2);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0010, &evt);
+    affinity = 2;
+
+    pEvt = rkh_fwk_ae(9, 1, (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+    TEST_ASSERT_EQUAL(RKH_CFG_FWK_MAX_EVT_POOL + 1, pEvt->pool);
+}
+
+void
+test_AllocateOneEvtFallsBackToGlobalPool(void)
+{
+    RKH_EVT_T *pEvt, evt;
+
+    expectRegisterEvtPool(16, (RKHEvtPool *)0xdead0000);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 16);
+    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 16, 
+                                        (RKHEvtPool *)0xdead0010);
+    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)0xdead0010, 16);
+    rkh_fwk_registerLocalEvtPool(storage, sizeof(storage), 16, 2);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0010, 0);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    expectFindEvtPool((RKHEvtPool *)0xdead0000, 16);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0000, &evt);
+    affinity = 2;
+
+    pEvt = rkh_fwk_ae(9, 1, (const void *)0xbeaf);
+
+    TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+    TEST_ASSERT_EQUAL(1, pEvt->pool);
+    TEST_ASSERT_EQUAL(1, rkh_fwk_getNumExhausted(RKH_CFG_FWK_MAX_EVT_POOL));
+    TEST_ASSERT_EQUAL(0, rkh_fwk_getNumExhausted(0));
+}
+
+void
+test_Fails_GetNumExhaustedOfUnregisteredLocalPool(void)
+{
+    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 16, 
+                                        (RKHEvtPool *)0xdead0010);
+    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)0xdead0010, 16);
+    rkh_fwk_registerLocalEvtPool(storage, sizeof(storage), 16, 2);
+    rkh_assert_Expect("rkhfwk_dynevt", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    rkh_fwk_getNumExhausted(RKH_CFG_FWK_MAX_EVT_POOL + 1);
+
+    TEST_FAIL();
+}
+
+void
+test_RecycleEvtToLocalPool(void)
+{
+    RKH_EVT_T evt;
+
+    evt.nref = 1;
+    evt.pool = RKH_CFG_FWK_MAX_EVT_POOL + 1;
+    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 16, 
+                                        (RKHEvtPool *)0xdead0010);
+    rkh_evtPool_getBlockSize_ExpectAndReturn((RKHEvtPool *)0xdead0010, 16);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_evtPool_put_Expect((RKHEvtPool *)0xdead0010, &evt);
+
+    rkh_fwk_registerLocalEvtPool(storage, sizeof(storage), 16, 2);
+    rkh_fwk_gc(&evt, (const void *)0xdead);
+}
+
+#if RKH_CFG_FWK_EVT_SCLASS_EN == RKH_ENABLED
+void
+test_SizeClassFitsPoolNotMultipleOfGranularity(void)
+{
+    RKH_EVT_T *pEvt, evt;
+    RKH_ES_T esize;
+
+    expectRegisterEvtPool(8, (RKHEvtPool *)0xdead0000);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 8);
+    expectRegisterEvtPool(12, (RKHEvtPool *)0xdead0010);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 12);
+    expectRegisterEvtPool(32, (RKHEvtPool *)0xdead0020);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 32);
+
+    for (esize = RKH_CFG_FWK_EVT_SCLASS_GRAN + 1; esize <= 12; ++esize)
+    {
+        rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0010, &evt);
+
+        pEvt = rkh_fwk_ae(esize, 1, (const void *)0xbeaf);
+
+        TEST_ASSERT_EQUAL_PTR(&evt, pEvt);
+        TEST_ASSERT_EQUAL(2, pEvt->pool);
+    }
+}
+
+void
+test_SizeClassSkipsPoolsSmallerThanEvt(void)
+{
+    RKH_EVT_T *pEvt, evt;
+
+    expectRegisterEvtPool(8, (RKHEvtPool *)0xdead0000);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 8);
+    expectRegisterEvtPool(12, (RKHEvtPool *)0xdead0010);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 12);
+    expectRegisterEvtPool(32, (RKHEvtPool *)0xdead0020);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 32);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0000, &evt);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0020, &evt);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0020, &evt);
+
+    pEvt = rkh_fwk_ae(RKH_CFG_FWK_EVT_SCLASS_GRAN, 1, (const void *)0xbeaf);
+    TEST_ASSERT_EQUAL(1, pEvt->pool);
+    pEvt = rkh_fwk_ae(13, 1, (const void *)0xbeaf);
+    TEST_ASSERT_EQUAL(3, pEvt->pool);
+    pEvt = rkh_fwk_ae(2 * RKH_CFG_FWK_EVT_SCLASS_GRAN, 1, 
+                      (const void *)0xbeaf);
+    TEST_ASSERT_EQUAL(3, pEvt->pool);
+}
+
+void
+test_SizeClassFindsPoolBeyondLastClass(void)
+{
+    RKH_EVT_T *pEvt, evt;
+    RKH_ES_T esize;
+
+    esize = RKH_CFG_FWK_EVT_SCLASS_NUM * RKH_CFG_FWK_EVT_SCLASS_GRAN;
+    expectRegisterEvtPool(8, (RKHEvtPool *)0xdead0000);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 8);
+    expectRegisterEvtPool(esize + 4, (RKHEvtPool *)0xdead0010);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), esize + 4);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0010, &evt);
+    rkh_evtPool_get_ExpectAndReturn((RKHEvtPool *)0xdead0010, &evt);
+
+    pEvt = rkh_fwk_ae(esize, 1, (const void *)0xbeaf);
+    TEST_ASSERT_EQUAL(2, pEvt->pool);
+    pEvt = rkh_fwk_ae(esize + 4, 1, (const void *)0xbeaf);
+    TEST_ASSERT_EQUAL(2, pEvt->pool);
+}
+
+void
+test_Fails_SizeClassEvtLargerThanEveryPool(void)
+{
+    expectRegisterEvtPool(8, (RKHEvtPool *)0xdead0000);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 8);
+    expectRegisterEvtPool(12, (RKHEvtPool *)0xdead0010);
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 12);
+    rkh_assert_Expect("rkhfwk_dynevt", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    rkh_fwk_ae(13, 1, (const void *)0xbeaf);
+
+    TEST_FAIL();
+}
+#endif
+
 void
 test_ReservesOneEvt(void)
 {
@@ -287,8 +579,10 @@ test_ReservesOneEvt(void)
     evt.e = 8;
     evt.nref = 16;
     evt.pool = 32;
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
     rkh_enter_critical_Expect();
     rkh_exit_critical_Expect();
+#endif
 
     rkh_fwk_reserve(&evt);
 
@@ -320,6 +614,71 @@ test_TriesRecycleMultipleReferencedEvt(void)
     TEST_ASSERT_EQUAL(3, evt.nref);
 }
 
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+void
+test_ReservesOneEvtBeyondEightBitsAtomically(void)
+{
+    RKH_EVT_T evt;
+
+    evt.pool = 1;
+    evt.nref = 0xff;
+
+    rkh_fwk_reserve(&evt);
+
+    TEST_ASSERT_EQUAL(0x100, evt.nref);
+}
+
+void
+test_ReservesStaticEvtLeavesItsRefUntouched(void)
+{
+    RKH_EVT_T evt;
+
+    evt.pool = 0;
+    evt.nref = 0;
+
+    rkh_fwk_reserve(&evt);
+
+    TEST_ASSERT_EQUAL(0, evt.nref);
+}
+
+void
+test_TriesRecycleReferencedEvtBeyondEightBitsAtomically(void)
+{
+    RKH_EVT_T evt;
+
+    evt.pool = 1;
+    evt.nref = 0x100;
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+
+    rkh_fwk_gc(&evt, (const void *)0xdead);
+
+    TEST_ASSERT_EQUAL(0xff, evt.nref);
+}
+
+void
+test_RecycleEvtOnlyOnItsLastRefAtomically(void)
+{
+    RKH_EVT_T evt;
+
+    evt.nref = 2;
+    evt.pool = 1;
+    expectRegisterEvtPool(4, (RKHEvtPool *)1);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_evtPool_put_Expect((RKHEvtPool *)1, &evt);
+
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 4);
+    rkh_fwk_gc(&evt, (const void *)0xdead);
+    TEST_ASSERT_EQUAL(1, evt.nref);
+    rkh_fwk_gc(&evt, (const void *)0xdead);
+    TEST_ASSERT_EQUAL(0, evt.nref);
+    rkh_fwk_gc(&evt, (const void *)0xdead);
+}
+#endif
+
 void
 test_RecycleEvt(void)
 {
@@ -327,8 +686,7 @@ test_RecycleEvt(void)
 
     evt.nref = 1;
     evt.pool = 1;
-    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 4, 
-                                     (RKHEvtPool *)1);
+    expectRegisterEvtPool(4, (RKHEvtPool *)1);
     rkh_enter_critical_Expect();
     rkh_exit_critical_Expect();
     rkh_evtPool_put_Expect((RKHEvtPool *)1, &evt);
@@ -337,6 +695,23 @@ test_RecycleEvt(void)
     rkh_fwk_gc(&evt, (const void *)0xdead);
 }
 
+void
+test_RecycleBufEvtReleasesItsBuffer(void)
+{
+    RKH_BUFEVT_T evt;
+
+    evt.evt.nref = 1;
+    evt.evt.pool = 1 | RKH_BUFEVT_FLAG;
+    expectRegisterEvtPool(4, (RKHEvtPool *)1);
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_buf_release_Expect(&evt);
+    rkh_evtPool_put_Expect((RKHEvtPool *)1, (RKH_EVT_T *)&evt);
+
+    rkh_fwk_registerEvtPool(storage, sizeof(storage), 4);
+    rkh_fwk_gc((RKH_EVT_T *)&evt, (const void *)0xdead);
+}
+
 void
 test_Fails_OnRecycleEvtNullPool(void)
 {
@@ -344,7 +719,9 @@ test_Fails_OnRecycleEvtNullPool(void)
 
     evt.nref = 1;
     evt.pool = 0;
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
     rkh_enter_critical_Expect();
+#endif
     rkh_assert_Expect("rkhfwk_dynevt", 0);
     rkh_assert_IgnoreArg_file();
     rkh_assert_IgnoreArg_line();
@@ -360,9 +737,10 @@ test_Fails_OnRecycleEvtWrongPool(void)
 
     evt.nref = 1;
     evt.pool = 2;
-    rkh_evtPool_getPool_ExpectAndReturn(storage, sizeof(storage), 4, 
-                                        (RKHEvtPool *)1);
+    expectRegisterEvtPool(4, (RKHEvtPool *)1);
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_DISABLED
     rkh_enter_critical_Expect();
+#endif
     rkh_assert_Expect("rkhfwk_dynevt", 0);
     rkh_assert_IgnoreArg_file();
     rkh_assert_IgnoreArg_line();
@@ -68,7 +68,7 @@
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
 static rui8_t *stoStart;
-static rui16_t stoSize;
+static RKH_MPSS_T stoSize;
 static RKH_ES_T evtSize;
 
 /* ----------------------- Local function prototypes ----------------------- */
@@ -123,7 +123,7 @@ test_AfterInitAllEvtPoolAvailable(void)
     RKHEvtPool *ep;
     int i;
 
-    for (i = 0; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i)
+    for (i = 0; i < RKH_EVTPOOL_NUM; ++i)
     {
         rkh_memPool_init_Expect(0, stoStart, stoSize, (RKH_MPBS_T)evtSize);
         rkh_memPool_init_IgnoreArg_mp();
@@ -131,7 +131,7 @@ test_AfterInitAllEvtPoolAvailable(void)
         ep = rkh_evtPool_getPool(stoStart, stoSize, evtSize);
         TEST_ASSERT_NOT_NULL(ep);
     } 
-    TEST_ASSERT_EQUAL(RKH_CFG_FWK_MAX_EVT_POOL, i);
+    TEST_ASSERT_EQUAL(RKH_EVTPOOL_NUM, i);
 }
 
 void
@@ -150,9 +150,9 @@ void
 test_GetMultipleEvtPool(void)
 {
     rInt i;
-    RKHEvtPool *ep[RKH_CFG_FWK_MAX_EVT_POOL];
+    RKHEvtPool *ep[RKH_EVTPOOL_NUM];
 
-    for (i = 0; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i)
+    for (i = 0; i < RKH_EVTPOOL_NUM; ++i)
     {
         rkh_memPool_init_Expect(0, stoStart + (stoSize * i), 
                            stoSize, (RKH_MPBS_T)evtSize * (2 * (i + 1)));
@@ -172,7 +172,7 @@ test_Fails_ExceedsMaxAvailableEvtPool(void)
     rInt i;
     RKHEvtPool *ep;
 
-    for (i = 0; i < RKH_CFG_FWK_MAX_EVT_POOL; ++i)
+    for (i = 0; i < RKH_EVTPOOL_NUM; ++i)
     {
         rkh_memPool_init_Expect(0, stoStart, stoSize, (RKH_MPBS_T)evtSize);
         rkh_memPool_init_IgnoreArg_mp();
@@ -271,6 +271,24 @@ test_GetNumUsed(void)
     rkh_evtPool_getNumUsed(ep);
 }
 
+void
+test_GetNumUsedExcludesMagazineBlocks(void)
+{
+    RKHEvtPool *ep;
+    RKH_MEMPOOL_T *mp;
+
+    rkh_memPool_init_Expect(0, stoStart, stoSize, (RKH_MPBS_T)evtSize);
+    rkh_memPool_init_IgnoreArg_mp();
+
+    ep = rkh_evtPool_getPool(stoStart, stoSize, evtSize);
+    mp = (RKH_MEMPOOL_T *)ep;
+    mp->nblocks = 8;
+    mp->nfree = 2;
+    mp->mag[0].nblk = 3;
+    mp->mag[RKH_CFG_FWK_MAX_SMA - 1].nblk = 1;
+    TEST_ASSERT_EQUAL(2, rkh_evtPool_getNumUsed(ep));
+}
+
 void
 test_Fails_GetNumUsedInvalidInstance(void)
 {
@@ -73,6 +73,9 @@ struct PubArg
     RdyCbArg base;
     RKH_EVT_T *event;
     const void *sender;
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+    const RKH_PUBSUB_FILTER_T *filters[RKH_CFG_FWK_MAX_SMA];
+#endif
 };
 
 /* ---------------------------- Global variables --------------------------- */
@@ -87,6 +90,10 @@ RKH_SMA_CREATE(RKH_SMA_T, ao, 0, HCAL, NULL, NULL, NULL);
 RKH_SMA_DEF_PTR(ao);
 RKH_SMA_CREATE(RKH_SMA_T, aoSender, 1, HCAL, NULL, NULL, NULL);
 RKH_SMA_DEF_PTR(aoSender);
+static rui8_t rdyPrios[RKH_CFG_FWK_MAX_SMA];
+static rui8_t nRdyPrios;
+static int inCritical;
+static int nPredCalls;
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
@@ -96,6 +103,93 @@ MockAssertCallback(const char* const file, int line, int cmock_num_calls)
     TEST_PASS();
 }
 
+static void
+MockSetReadyCallback(RKHRdyGrp *const me, rui8_t prio, int cmock_num_calls)
+{
+    rui8_t i;
+
+    for (i = 0; (i < nRdyPrios) && (rdyPrios[i] != prio); ++i)
+    {
+    }
+    if (i == nRdyPrios)
+    {
+        rdyPrios[nRdyPrios++] = prio;
+    }
+}
+
+static rui8_t
+MockTraverseCallback(RKHRdyGrp *const me, void (*rdyCb)(RdyCbArg *), 
+                     RdyCbArg *rdyCbArg, int cmock_num_calls)
+{
+    rui8_t i;
+
+    for (i = 0; i < nRdyPrios; ++i)
+    {
+        rdyCbArg->aoRdyPrio = rdyPrios[i];
+        (*rdyCb)(rdyCbArg);
+    }
+    return nRdyPrios;
+}
+
+static rui8_t
+MockTraverseAfterResubscribeCallback(RKHRdyGrp *const me, 
+                                     void (*rdyCb)(RdyCbArg *), 
+                                     RdyCbArg *rdyCbArg, 
+                                     int cmock_num_calls)
+{
+    rkh_pubsub_subscribe(0, ao);    /* drops its filter after the snapshot */
+    return MockTraverseCallback(me, rdyCb, rdyCbArg, cmock_num_calls);
+}
+
+static void
+MockEnterCriticalCallback(int cmock_num_calls)
+{
+    inCritical = 1;
+}
+
+static void
+MockExitCriticalCallback(int cmock_num_calls)
+{
+    inCritical = 0;
+}
+
+#if RKH_CFG_FWK_PUBSUB_FILTER_EN == RKH_ENABLED
+static rbool_t
+predicate(const RKH_EVT_T *e, const RKH_SMA_T *sma)
+{
+    ++nPredCalls;
+    TEST_ASSERT_FALSE(inCritical);
+    return (rbool_t)(e->e != 15);
+}
+
+static void
+setFilters(PubArg *arg, const RKH_PUBSUB_FILTER_T *filter)
+{
+    rui8_t nAo;
+
+    for (nAo = 0; nAo < RKH_CFG_FWK_MAX_SMA; ++nAo)
+    {
+        arg->filters[nAo] = filter;
+    }
+}
+#endif
+
+static void
+stubSubscribers(void)
+{
+    nRdyPrios = 0;
+    inCritical = 0;
+    nPredCalls = 0;
+    rkh_sptbl[RKH_GET_PRIO(ao)] = ao;
+    rkh_sptbl[RKH_GET_PRIO(aoSender)] = aoSender;
+    rkh_rdygrp_init_Ignore();
+    rkh_rdygrp_setReady_StubWithCallback(MockSetReadyCallback);
+    rkh_rdygrp_traverse_StubWithCallback(MockTraverseCallback);
+    rkh_enter_critical_StubWithCallback(MockEnterCriticalCallback);
+    rkh_exit_critical_StubWithCallback(MockExitCriticalCallback);
+    rkh_pubsub_init();
+}
+
 /* ---------------------------- Global functions --------------------------- */
 void
 setUp(void)
@@ -202,8 +296,8 @@ test_PublishOneActiveObject(void)
 
     rkh_rdygrp_init_Ignore();
     rkh_enter_critical_Expect();
-    rkh_rdygrp_traverse_ExpectAndReturn(0, 0, 0, 1);
     rkh_exit_critical_Expect();
+    rkh_rdygrp_traverse_ExpectAndReturn(0, 0, 0, 1);
     rkh_fwk_gc_Expect(&evt, &me);
     rkh_rdygrp_traverse_IgnoreArg_me();
     rkh_rdygrp_traverse_IgnoreArg_rdyCb();
@@ -225,6 +319,7 @@ test_InvokePublishCallbackOnPublish(void)
     publishArg.base.aoRdyPrio = RKH_GET_PRIO(ao);   /* subscriber */
     publishArg.event = &event;
     publishArg.sender = aoSender;
+    setFilters(&publishArg, NULL);
     rkh_sma_post_fifo_Expect(ao, &event, aoSender);
 
     publish((RdyCbArg *)&publishArg);
@@ -240,6 +335,7 @@ test_IgnoreSelfPublishing(void)
     publishArg.base.aoRdyPrio = RKH_GET_PRIO(ao);   /* subscriber */
     publishArg.event = &event;
     publishArg.sender = ao;
+    setFilters(&publishArg, NULL);
 
     publish((RdyCbArg *)&publishArg);
 }
@@ -278,6 +374,243 @@ test_Fails_UnsubscribeWithWrongArgs(void)
     rkh_pubsub_unsubscribe(0, NULL);
 }
 
+void
+test_PublishTopicOnlyToItsSubscribers(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_SUBS_T subs[2];
+    rui8_t nRdyAo;
+
+    rkh_rdygrp_init_Ignore();
+    rkh_enter_critical_Ignore();
+    rkh_exit_critical_Ignore();
+    rkh_pubsub_init();
+    rkh_pubsub_subscribeTopic(&subs[0], 0x1234, ao);
+    rkh_pubsub_subscribeTopic(&subs[1], 0x1235, aoSender);
+
+    rkh_rdygrp_setReady_Expect(0, RKH_GET_PRIO(ao));
+    rkh_rdygrp_setReady_IgnoreArg_me();
+    rkh_rdygrp_traverse_ExpectAndReturn(0, 0, 0, 1);
+    rkh_rdygrp_traverse_IgnoreArg_me();
+    rkh_rdygrp_traverse_IgnoreArg_rdyCb();
+    rkh_rdygrp_traverse_IgnoreArg_rdyCbArg();
+    rkh_fwk_gc_Expect(&evt, &me);
+
+    nRdyAo = rkh_pubsub_publishTopic(0x1234, &evt, &me);
+    TEST_ASSERT_EQUAL(1, nRdyAo);
+}
+
+void
+test_PublishTopicToPrefixSubscribers(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_SUBS_T subs;
+
+    rkh_rdygrp_init_Ignore();
+    rkh_enter_critical_Ignore();
+    rkh_exit_critical_Ignore();
+    rkh_pubsub_init();
+    rkh_pubsub_subscribePrefix(&subs, 0x1200, 0xFF00, ao);
+
+    rkh_rdygrp_setReady_Expect(0, RKH_GET_PRIO(ao));
+    rkh_rdygrp_setReady_IgnoreArg_me();
+    rkh_rdygrp_traverse_IgnoreAndReturn(1);
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publishTopic(0x12AB, &evt, &me);
+
+    rkh_rdygrp_traverse_IgnoreAndReturn(0);
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publishTopic(0x13AB, &evt, &me);
+}
+
+void
+test_UnsubscribeTopic(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_SUBS_T subs[2];
+
+    rkh_rdygrp_init_Ignore();
+    rkh_enter_critical_Ignore();
+    rkh_exit_critical_Ignore();
+    rkh_pubsub_init();
+    rkh_pubsub_subscribeTopic(&subs[0], 0x1234, ao);
+    rkh_pubsub_subscribePrefix(&subs[1], 0x1200, 0xFF00, aoSender);
+    rkh_pubsub_unsubscribeTopic(&subs[0]);
+    rkh_pubsub_unsubscribeTopic(&subs[1]);
+
+    rkh_rdygrp_traverse_IgnoreAndReturn(0);
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publishTopic(0x1234, &evt, &me);
+}
+
+void
+test_PublishCallbackAppliesChannelFilter(void)
+{
+    PubArg publishArg;
+    RKH_PUBSUB_FILTER_T filter = {10, 20, NULL};
+
+    rkh_sptbl[RKH_GET_PRIO(ao)] = ao;
+    publishArg.base.aoRdyPrio = RKH_GET_PRIO(ao);
+    publishArg.event = &event;
+    publishArg.sender = aoSender;
+    setFilters(&publishArg, NULL);
+    publishArg.filters[RKH_GET_PRIO(ao)] = &filter;
+
+    event.e = 9;
+    publish((RdyCbArg *)&publishArg);   /* rejected, thus not posted */
+
+    event.e = 10;
+    rkh_sma_post_fifo_Expect(ao, &event, aoSender);
+    publish((RdyCbArg *)&publishArg);
+}
+
+void
+test_PublishTopicSkipsRejectingSubscriptions(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_SUBS_T subs[2];
+    RKH_PUBSUB_FILTER_T filter = {10, 20, NULL};
+    rui8_t nRdyAo;
+
+    stubSubscribers();
+    rkh_pubsub_subscribeTopic(&subs[0], 0x1234, ao);
+    rkh_pubsub_subscribeTopic(&subs[1], 0x1234, aoSender);
+    rkh_pubsub_filterTopic(&subs[1], &filter);
+
+    evt.e = 21;
+    rkh_sma_post_fifo_Expect(ao, &evt, &me);
+    rkh_fwk_gc_Expect(&evt, &me);
+
+    nRdyAo = rkh_pubsub_publishTopic(0x1234, &evt, &me);
+    TEST_ASSERT_EQUAL(2, nRdyAo);
+}
+
+void
+test_PublishCountsFilteredSubscribersAsPublishTopicDoes(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_PUBSUB_FILTER_T filter = {10, 20, NULL};
+    rui8_t nRdyAo;
+
+    stubSubscribers();
+    rkh_pubsub_subscribe(0, ao);
+    rkh_pubsub_subscribeFilter(0, aoSender, &filter);
+
+    evt.e = 21;
+    rkh_sma_post_fifo_Expect(ao, &evt, &me);
+    rkh_fwk_gc_Expect(&evt, &me);
+
+    nRdyAo = rkh_pubsub_publish(0, &evt, &me);
+    TEST_ASSERT_EQUAL(2, nRdyAo);
+}
+
+void
+test_PublishRunsPredicateOutsideCriticalSection(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_PUBSUB_FILTER_T filter = {10, 20, predicate};
+
+    stubSubscribers();
+    rkh_pubsub_subscribeFilter(0, ao, &filter);
+
+    evt.e = 15;
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publish(0, &evt, &me);
+
+    evt.e = 16;
+    rkh_sma_post_fifo_Expect(ao, &evt, &me);
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publish(0, &evt, &me);
+
+    TEST_ASSERT_EQUAL(2, nPredCalls);
+}
+
+void
+test_PublishEvaluatesFiltersSnapshotTakenWithSubscribers(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_PUBSUB_FILTER_T filter = {10, 20, NULL};
+
+    stubSubscribers();
+    rkh_pubsub_subscribeFilter(0, ao, &filter);
+    rkh_rdygrp_traverse_StubWithCallback(
+                                    MockTraverseAfterResubscribeCallback);
+
+    evt.e = 21;
+    rkh_fwk_gc_Expect(&evt, &me);
+
+    rkh_pubsub_publish(0, &evt, &me);
+}
+
+void
+test_PublishTopicRunsPredicateOutsideCriticalSection(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_SUBS_T subs;
+    RKH_PUBSUB_FILTER_T filter = {10, 20, predicate};
+
+    stubSubscribers();
+    rkh_pubsub_subscribeTopic(&subs, 0x1234, ao);
+    rkh_pubsub_filterTopic(&subs, &filter);
+
+    evt.e = 15;
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publishTopic(0x1234, &evt, &me);
+
+    evt.e = 16;
+    rkh_sma_post_fifo_Expect(ao, &evt, &me);
+    rkh_fwk_gc_Expect(&evt, &me);
+    rkh_pubsub_publishTopic(0x1234, &evt, &me);
+
+    TEST_ASSERT_EQUAL(2, nPredCalls);
+}
+
+void
+test_PublishTopicPrefersUnfilteredSubscriptionOfSameAo(void)
+{
+    int me;
+    RKH_EVT_T evt;
+    RKH_SUBS_T subs[2];
+    RKH_PUBSUB_FILTER_T filter = {10, 20, NULL};
+    rui8_t nRdyAo;
+
+    stubSubscribers();
+    rkh_pubsub_subscribeTopic(&subs[0], 0x1234, ao);
+    rkh_pubsub_filterTopic(&subs[0], &filter);
+    rkh_pubsub_subscribePrefix(&subs[1], 0x1200, 0xFF00, ao);
+
+    evt.e = 21;
+    rkh_sma_post_fifo_Expect(ao, &evt, &me);
+    rkh_fwk_gc_Expect(&evt, &me);
+
+    nRdyAo = rkh_pubsub_publishTopic(0x1234, &evt, &me);
+    TEST_ASSERT_EQUAL(1, nRdyAo);
+}
+
+void
+test_Fails_SubscribeTopicWithWrongArgs(void)
+{
+    RKH_SUBS_T subs;
+
+    rkh_assert_Expect("rkhfwk_pubsub", 0);
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+    rkh_pubsub_subscribeTopic(NULL, 0x1234, ao);
+
+    rkh_assert_Expect("rkhfwk_pubsub", 0);
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+    rkh_pubsub_subscribeTopic(&subs, 0x1234, NULL);
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -70,6 +70,13 @@ extern "C" {
 
 /* --------------------------------- Macros -------------------------------- */
 /* -------------------------------- Constants ------------------------------ */
+/**
+ *  \brief
+ *  Value returned by rkh_memPool_getMagSlot() when the calling thread has 
+ *  not its own magazines, thus it uses the shared free list.
+ */
+#define RKH_MP_NO_MAG       0xFF
+
 /* ------------------------------- Data types ------------------------------ */
 /**
  *  Defines the size of number of memory block size. The valid values
@@ -101,6 +108,31 @@ typedef rui32_t RKH_MPBS_T;
 typedef rui8_t RKH_MPBS_T;
 #endif
 
+/**
+ *  Defines the size of the memory pool storage. The valid values [in bits]
+ *  are 16 or 32. Default is 16. This type is configurable via the
+ *  preprocessor switch RKH_CFG_MP_SIZEOF_SSIZE.
+ */
+#if RKH_CFG_MP_SIZEOF_SSIZE == 32
+typedef rui32_t RKH_MPSS_T;
+#else
+typedef rui16_t RKH_MPSS_T;
+#endif
+
+/**
+ *  Defines the tagged head of a lock-free free list. The lower 32 bits
+ *  hold the index of the first free block plus one (0 means empty), and 
+ *  the upper bits hold a tag incremented on every update to avoid the ABA 
+ *  problem. The port may redefine #RKH_MP_TAG_TYPE to any 64-bit unsigned
+ *  type handled by its compare-and-swap primitive.
+ */
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+#ifndef RKH_MP_TAG_TYPE
+#define RKH_MP_TAG_TYPE     unsigned long long
+#endif
+typedef RKH_MP_TAG_TYPE RKH_MPTAG_T;
+#endif
+
 /**
  *  \brief
  *  Defines the data structure into which the performance information for
@@ -139,6 +171,39 @@ typedef struct
     rui8_t full;
 } RKH_MPI_T;
 
+/**
+ *  \brief
+ *  Defines a magazine, a small LIFO stash of free blocks owned by a single 
+ *  thread. It is refilled from and drained to the shared free list of the 
+ *  pool in batches of #RKH_CFG_MP_MAG_SIZE / 2 blocks.
+ */
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+typedef struct RKH_MPMAG_T
+{
+    /**
+     *  \brief
+     *  Number of blocks currently in the magazine.
+     */
+    rui8_t nblk;
+
+    /**
+     *  \brief
+     *  Stashed free blocks.
+     */
+    void *blk[RKH_CFG_MP_MAG_SIZE];
+
+    /**
+     *  \brief
+     *  Performance information of the requests served by the magazine. 
+     *  It is owned by its thread and added to the information of the pool 
+     *  by rkh_memPool_get_info().
+     */
+#if RKH_CFG_MP_GET_INFO_EN == RKH_ENABLED
+    RKH_MPI_T mpi;
+#endif
+} RKH_MPMAG_T;
+#endif
+
 /**
  *  \brief
  *  Defines the data structure used to memory block pool facility.
@@ -199,6 +264,15 @@ typedef struct RKH_MEMPOOL_T
      */
     void *free;
 
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    /**
+     *  \brief
+     *  Tagged head of the lock-free free list. It replaces \a free when
+     *  #RKH_CFG_MP_LOCKFREE_EN is enabled.
+     */
+    volatile RKH_MPTAG_T head;
+#endif
+
     /**
      *  \brief
      *  Number of free blocks remaining.
@@ -266,6 +340,17 @@ typedef struct RKH_MEMPOOL_T
 #if RKH_CFG_MP_GET_INFO_EN == RKH_ENABLED
     RKH_MPI_T mpi;
 #endif
+
+    /**
+     *  \brief
+     *  Magazines, one per active object thread, indexed by the slot 
+     *  returned by rkh_memPool_getMagSlot(). The \a nfree and \a nmin 
+     *  members only count the blocks in the shared free list, thus they 
+     *  are approximated.
+     */
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    RKH_MPMAG_T mag[RKH_CFG_FWK_MAX_SMA];
+#endif
 } RKH_MEMPOOL_T;
 
 /* -------------------------- External variables --------------------------- */
@@ -305,7 +390,7 @@ typedef struct RKH_MEMPOOL_T
  *
  *  \ingroup apiMemPool
  */
-void rkh_memPool_init(RKH_MEMPOOL_T *mp, void *sstart, rui16_t ssize,
+void rkh_memPool_init(RKH_MEMPOOL_T *mp, void *sstart, RKH_MPSS_T ssize,
                  RKH_MPBS_T bsize);
 
 /**
@@ -361,6 +446,10 @@ RKH_MPBS_T rkh_memPool_get_bsize(RKH_MEMPOOL_T *mp);
  *  The number of free memory blocks in the pool.
  *
  *  \note
+ *  When #RKH_CFG_MP_MAG_EN is enabled the returned value includes the 
+ *  blocks stashed in the magazines, which are read without locking them, 
+ *  thus it is approximated.
+ *  \note
  *  This function is optional, thus it could be eliminated in compile-time
  *  with RKH_CFG_MP_GET_NFREE_EN.
  *
@@ -422,6 +511,25 @@ void rkh_memPool_get_info(RKH_MEMPOOL_T *mp, RKH_MPI_T *mpi);
  */
 void rkh_memPool_clear_info(RKH_MEMPOOL_T *mp);
 
+/**
+ *  \brief
+ *  Returns the magazine slot of the calling thread, a number in the range 
+ *  [0, #RKH_CFG_FWK_MAX_SMA - 1] that must be unique for each thread that 
+ *  owns magazines, usually the priority of its active object. Threads 
+ *  without magazines, as well as interrupt handlers, must receive 
+ *  #RKH_MP_NO_MAG.
+ *
+ *  \return
+ *  Magazine slot or #RKH_MP_NO_MAG.
+ *
+ *  \note
+ *  This function is provided by the multi-thread port when the 
+ *  #RKH_CFG_MP_MAG_EN option is enabled.
+ *
+ *  \ingroup apiMemPool
+ */
+rui8_t rkh_memPool_getMagSlot(void);
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
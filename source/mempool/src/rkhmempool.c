@@ -61,7 +61,96 @@
 RKH_MODULE_NAME(rkhmempool)
 
 /* ----------------------------- Local macros ------------------------------ */
+#if RKH_CFG_MP_GET_INFO_EN == RKH_ENABLED
+    #define RKH_IUPDT_INIT(mp)        ++ (mp)->mpi.inits
+    #define RKH_IUPDT_GET(mp, fb) \
+        ++ (mp)->mpi.gets; \
+        if ((fb) == RKH_NULL) \
+        { \
+            ++ (mp)->mpi.free; \
+        }
+    #define RKH_IUPDT_PUT(mp)         ++ (mp)->mpi.puts
+#else
+    #define RKH_IUPDT_INIT(mp)
+    #define RKH_IUPDT_GET(mp, fb)
+    #define RKH_IUPDT_PUT(mp)
+#endif
+
+#if RKH_CFG_MP_GET_LWM_EN == RKH_ENABLED && \
+    RKH_CFG_MP_REDUCED_EN == RKH_DISABLED
+    #define RKH_MP_NMIN(mp)           (mp)->nmin
+#else
+    #define RKH_MP_NMIN(mp)           (mp)->nfree
+#endif
+
+/*
+ *  The magazine and lock-free paths do not enter the critical section, 
+ *  thus their trace records take it by themselves, only when they are 
+ *  compiled in.
+ */
+#if RKH_CFG_TRC_EN == RKH_ENABLED && \
+    (RKH_CFG_TRC_ALL_EN == RKH_ENABLED || RKH_CFG_TRC_MP_EN == RKH_ENABLED)
+    #define RKH_TR_MP_CRIT_GET(mp) \
+        RKH_ENTER_CRITICAL_(); \
+        RKH_TR_MP_GET(mp, (mp)->nfree, RKH_MP_NMIN(mp)); \
+        RKH_EXIT_CRITICAL_()
+    #define RKH_TR_MP_CRIT_PUT(mp) \
+        RKH_ENTER_CRITICAL_(); \
+        RKH_TR_MP_PUT(mp, (mp)->nfree); \
+        RKH_EXIT_CRITICAL_()
+    #define RKH_MP_SR_ALLOC()         RKH_SR_ALLOC()
+#else
+    #define RKH_TR_MP_CRIT_GET(mp)    (void)0
+    #define RKH_TR_MP_CRIT_PUT(mp)    (void)0
+    #if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+        #define RKH_MP_SR_ALLOC()
+    #else
+        #define RKH_MP_SR_ALLOC()     RKH_SR_ALLOC()
+    #endif
+#endif
+
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    /*
+     *  Atomic primitives, by default the GCC builtins. A port without them
+     *  must define these macros in its rkhport.h file.
+     */
+    #ifndef RKH_MP_CAS
+        #define RKH_MP_CAS(p_, old_, new_) \
+            __sync_bool_compare_and_swap((p_), (old_), (new_))
+    #endif
+    #ifndef RKH_MP_LOAD
+        #define RKH_MP_LOAD(p_)             __sync_fetch_and_add((p_), 0)
+    #endif
+    #ifndef RKH_MP_INC
+        #define RKH_MP_INC(p_)              __sync_add_and_fetch((p_), 1)
+    #endif
+    #ifndef RKH_MP_DEC
+        #define RKH_MP_DEC(p_)              __sync_sub_and_fetch((p_), 1)
+    #endif
+
+    #define RKH_MP_IDX(head_)       (rui32_t)((head_) & 0xFFFFFFFFUL)
+    #define RKH_MP_TAG(head_)       ((head_) >> 32)
+    #define RKH_MP_HEAD(tag_, idx_) \
+        (RKH_MPTAG_T)(((RKH_MPTAG_T)(tag_) << 32) | (RKH_MPTAG_T)(idx_))
+
+    #if RKH_CFG_MP_GET_INFO_EN == RKH_ENABLED
+        #define RKH_IUPDT_GET_LF(mp, fb) \
+            (void)RKH_MP_INC(&(mp)->mpi.gets); \
+            if ((fb) == RKH_NULL) \
+            { \
+                (void)RKH_MP_INC(&(mp)->mpi.free); \
+            }
+        #define RKH_IUPDT_PUT_LF(mp)  (void)RKH_MP_INC(&(mp)->mpi.puts)
+    #else
+        #define RKH_IUPDT_GET_LF(mp, fb)
+        #define RKH_IUPDT_PUT_LF(mp)
+    #endif
+#endif
 /* ------------------------------- Constants ------------------------------- */
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+#define RKH_MP_MAG_BATCH        (RKH_CFG_MP_MAG_SIZE / 2)
+#endif
+
 /* ---------------------------- Local data types --------------------------- */
 /*
  *  Structure representing a free block.
@@ -75,13 +164,172 @@ typedef struct rkh_free_blk_t
 /* ---------------------------- Local variables ---------------------------- */
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+/*
+ *  Converts a block index of the lock-free list, which is 1-based, to the
+ *  block address and viceversa. The index 0 represents the NULL pointer.
+ */
+static RKH_FREE_BLK_T *
+blkAt(RKH_MEMPOOL_T *mp, rui32_t idx)
+{
+    return (idx == 0) ? (RKH_FREE_BLK_T *)0 :
+           (RKH_FREE_BLK_T *)((rui8_t *)mp->start + 
+                              ((idx - 1) * (rui32_t)mp->bsize));
+}
+
+static rui32_t
+idxOf(RKH_MEMPOOL_T *mp, RKH_FREE_BLK_T *fb)
+{
+    return (fb == (RKH_FREE_BLK_T *)0) ? 0 :
+           (rui32_t)(((rui8_t *)fb - (rui8_t *)mp->start) / mp->bsize) + 1;
+}
+
+/*
+ *  Pops a block from the lock-free list. The tag of the head is 
+ *  incremented on every update, thus a stale 'next' link read from a block
+ *  concurrently reused by another thread makes the CAS fail and retry.
+ */
+static RKH_FREE_BLK_T *
+popFree(RKH_MEMPOOL_T *mp)
+{
+    RKH_MPTAG_T head, next;
+    RKH_FREE_BLK_T *fb;
+    RKH_MPNB_T nfree;
+#if RKH_CFG_MP_GET_LWM_EN == RKH_ENABLED
+    RKH_MPNB_T nmin;
+#endif
+
+    do
+    {
+        head = RKH_MP_LOAD(&mp->head);
+        fb = blkAt(mp, RKH_MP_IDX(head));
+        if (fb == (RKH_FREE_BLK_T *)0)
+        {
+            return fb;                                   /* pool exhausted */
+        }
+        next = RKH_MP_HEAD(RKH_MP_TAG(head) + 1, idxOf(mp, fb->next));
+    }
+    while (!RKH_MP_CAS(&mp->head, head, next));
+
+    nfree = RKH_MP_DEC(&mp->nfree);
+#if RKH_CFG_MP_GET_LWM_EN == RKH_ENABLED
+    while (((nmin = mp->nmin) > nfree) && 
+           !RKH_MP_CAS(&mp->nmin, nmin, nfree))
+    {
+        /* another thread updated the minimum, try again */
+    }
+#endif
+    (void)nfree;
+    return fb;
+}
+
+/*
+ *  Pushes a block onto the lock-free list.
+ */
+static void
+pushFree(RKH_MEMPOOL_T *mp, RKH_FREE_BLK_T *fb)
+{
+    RKH_MPTAG_T head;
+    RKH_MPNB_T nfree;
+
+    do
+    {
+        head = RKH_MP_LOAD(&mp->head);
+        fb->next = blkAt(mp, RKH_MP_IDX(head));
+    }
+    while (!RKH_MP_CAS(&mp->head, head, 
+                       RKH_MP_HEAD(RKH_MP_TAG(head) + 1, idxOf(mp, fb))));
+
+    nfree = RKH_MP_INC(&mp->nfree);
+    RKH_ASSERT(nfree <= mp->nblocks);   /* # free blocks must be <= total */
+    (void)nfree;
+}
+#endif
+
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+/*
+ *  Moves up to a batch of blocks from the shared free list to an empty 
+ *  magazine.
+ */
+static void
+refill(RKH_MEMPOOL_T *mp, RKH_MPMAG_T *mag)
+{
+    RKH_FREE_BLK_T *fb;
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_DISABLED
+    RKH_SR_ALLOC();
+#endif
+
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    while ((mag->nblk < RKH_MP_MAG_BATCH) &&
+           ((fb = popFree(mp)) != RKH_NULL))
+    {
+        mag->blk[mag->nblk++] = fb;
+    }
+#else
+    RKH_ENTER_CRITICAL_();
+    while ((mag->nblk < RKH_MP_MAG_BATCH) &&
+           ((fb = (RKH_FREE_BLK_T *)mp->free) != RKH_NULL))
+    {
+        mp->free = fb->next;
+        RKH_ASSERT(mp->nfree > (RKH_MPNB_T)0);
+        --mp->nfree;
+        mag->blk[mag->nblk++] = fb;
+    }
+
+#if RKH_CFG_MP_GET_LWM_EN == RKH_ENABLED && \
+    RKH_CFG_MP_REDUCED_EN == RKH_DISABLED
+    if (mp->nmin > mp->nfree)
+    {
+        mp->nmin = mp->nfree;
+    }
+#endif
+    RKH_EXIT_CRITICAL_();
+#endif
+}
+
+/*
+ *  Moves a batch of blocks from a full magazine back to the shared free 
+ *  list.
+ */
+static void
+drain(RKH_MEMPOOL_T *mp, RKH_MPMAG_T *mag)
+{
+    RKH_FREE_BLK_T *fb;
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_DISABLED
+    RKH_SR_ALLOC();
+#endif
+
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    while (mag->nblk > RKH_MP_MAG_BATCH)
+    {
+        fb = (RKH_FREE_BLK_T *)mag->blk[--mag->nblk];
+        pushFree(mp, fb);
+    }
+#else
+    RKH_ENTER_CRITICAL_();
+    while (mag->nblk > RKH_MP_MAG_BATCH)
+    {
+        RKH_ASSERT(mp->nfree < mp->nblocks);
+        fb = (RKH_FREE_BLK_T *)mag->blk[--mag->nblk];
+        fb->next = (RKH_FREE_BLK_T *)mp->free;
+        mp->free = fb;
+        ++mp->nfree;
+    }
+    RKH_EXIT_CRITICAL_();
+#endif
+}
+#endif
+
 /* ---------------------------- Global functions --------------------------- */
 void
-rkh_memPool_init(RKH_MEMPOOL_T *mp, void *sstart, rui16_t ssize,
+rkh_memPool_init(RKH_MEMPOOL_T *mp, void *sstart, RKH_MPSS_T ssize,
             RKH_MPBS_T bsize)
 {
     RKH_FREE_BLK_T *fb;
     RKH_MPNB_T nblocks;
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    rui8_t slot;
+#endif
     RKH_SR_ALLOC();
 
     /*
@@ -110,19 +358,20 @@ rkh_memPool_init(RKH_MEMPOOL_T *mp, void *sstart, rui16_t ssize,
     bsize = mp->bsize;               /* use the rounded-up value from now on */
 
     /* The pool buffer must fit at least one rounded-up block. */
-    RKH_ASSERT(ssize >= (rui16_t)bsize);
+    RKH_ASSERT(ssize >= (RKH_MPSS_T)bsize);
 
     /* Chain all blocks together in a free-list...*/
-    ssize -= (rui16_t)bsize;               /* don't count the last block */
+    ssize -= (RKH_MPSS_T)bsize;            /* don't count the last block */
     mp->nblocks = 1;                   /* the last block already in the pool */
     fb = (RKH_FREE_BLK_T *)mp->free;    /*start at the head of the free list */
 
-    while (ssize >= (rui16_t)bsize)
+    while (ssize >= (RKH_MPSS_T)bsize)
     {
         fb->next = &fb[nblocks];    /* point the next link to the next block */
         fb = fb->next;              /* advance to the next block */
-        ssize -= (rui16_t)bsize;    /* reduce the available pool size */
+        ssize -= (RKH_MPSS_T)bsize; /* reduce the available pool size */
         ++mp->nblocks;              /* increment the number of blocks so far */
+        RKH_ASSERT(mp->nblocks != (RKH_MPNB_T)0);   /* RKH_MPNB_T overflow */
     }
 
     fb->next  = (RKH_FREE_BLK_T *)0;         /* the last link points to NULL */
@@ -135,6 +384,20 @@ rkh_memPool_init(RKH_MEMPOOL_T *mp, void *sstart, rui16_t ssize,
     mp->start = sstart;               /* the original start this pool buffer */
     mp->end   = fb;                           /* the last block in this pool */
 #endif
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    mp->head = RKH_MP_HEAD(0, idxOf(mp, (RKH_FREE_BLK_T *)mp->free));
+#endif
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    for (slot = 0; slot < RKH_CFG_FWK_MAX_SMA; ++slot)
+    {
+        mp->mag[slot].nblk = 0;                   /* all magazines are empty */
+#if RKH_CFG_MP_GET_INFO_EN == RKH_ENABLED
+        mp->mag[slot].mpi.gets = mp->mag[slot].mpi.puts = 
+                                 mp->mag[slot].mpi.free = 0;
+#endif
+    }
+#endif
+    RKH_IUPDT_INIT(mp);
     RKH_TR_MP_INIT(mp, mp->nblocks, mp->bsize);
 }
 
@@ -142,10 +405,38 @@ void *
 rkh_memPool_get(RKH_MEMPOOL_T *mp)
 {
     RKH_FREE_BLK_T *fb;
-    RKH_SR_ALLOC();
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    RKH_MPMAG_T *mag;
+    rui8_t slot;
+#endif
+    RKH_MP_SR_ALLOC();
 
     RKH_ASSERT(mp != (RKH_MEMPOOL_T *)0 && mp->bsize != 0);
 
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    slot = rkh_memPool_getMagSlot();
+    if (slot != RKH_MP_NO_MAG)          /* has the caller its own magazine? */
+    {
+        RKH_ASSERT(slot < RKH_CFG_FWK_MAX_SMA);
+        mag = &mp->mag[slot];
+        if (mag->nblk == 0)
+        {
+            refill(mp, mag);
+        }
+        fb = (mag->nblk != 0) ? (RKH_FREE_BLK_T *)mag->blk[--mag->nblk] : 
+                                RKH_NULL;
+        RKH_IUPDT_GET(mag, fb);
+        RKH_TR_MP_CRIT_GET(mp);
+        return fb;
+    }
+#endif
+
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    fb = popFree(mp);
+    RKH_IUPDT_GET_LF(mp, fb);
+    RKH_TR_MP_CRIT_GET(mp);
+    return fb;
+#else
     RKH_ENTER_CRITICAL_();
 
     fb = (RKH_FREE_BLK_T *)mp->free;            /* get a free block or NULL */
@@ -163,41 +454,64 @@ rkh_memPool_get(RKH_MEMPOOL_T *mp)
 #endif
     }
 
-#if RKH_CFG_MP_GET_LWM_EN == RKH_ENABLED && \
-        RKH_CFG_MP_REDUCED_EN == RKH_DISABLED
-    RKH_TR_MP_GET(mp, mp->nfree, mp->nmin);
-#else
-    RKH_TR_MP_GET(mp, mp->nfree, mp->nfree);
-#endif
+    RKH_IUPDT_GET(mp, fb);
+    RKH_TR_MP_GET(mp, mp->nfree, RKH_MP_NMIN(mp));
     RKH_EXIT_CRITICAL_();
     return fb;            /* return the block or NULL pointer to the caller */
+#endif
 }
 
 void
 rkh_memPool_put(RKH_MEMPOOL_T *mp, void *blk)
 {
-    RKH_SR_ALLOC();
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    RKH_MPMAG_T *mag;
+    rui8_t slot;
+#endif
+    RKH_MP_SR_ALLOC();
 
     RKH_ASSERT(mp != (RKH_MEMPOOL_T *)0);
     RKH_ASSERT(mp->bsize != 0);
 
 #if RKH_CFG_MP_REDUCED_EN == RKH_DISABLED
-    RKH_ASSERT(mp->start <= blk &&                       /* must be in range */
-               blk <= mp->end &&
-               mp->nfree < mp->nblocks);    /* # free blocks must be < total */
-#else
-    RKH_ASSERT(mp->nfree < mp->nblocks);    /* # free blocks must be < total */
+    RKH_ASSERT(mp->start <= blk && blk <= mp->end);      /* must be in range */
 #endif
 
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    slot = rkh_memPool_getMagSlot();
+    if (slot != RKH_MP_NO_MAG)          /* has the caller its own magazine? */
+    {
+        RKH_ASSERT(slot < RKH_CFG_FWK_MAX_SMA);
+        mag = &mp->mag[slot];
+        if (mag->nblk == RKH_CFG_MP_MAG_SIZE)
+        {
+            drain(mp, mag);
+        }
+        mag->blk[mag->nblk++] = blk;
+        RKH_IUPDT_PUT(mag);
+        RKH_TR_MP_CRIT_PUT(mp);
+        return;
+    }
+#endif
+
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+    pushFree(mp, (RKH_FREE_BLK_T *)blk);
+    RKH_IUPDT_PUT_LF(mp);
+    RKH_TR_MP_CRIT_PUT(mp);
+#else
     RKH_ENTER_CRITICAL_();
 
+    RKH_ASSERT(mp->nfree < mp->nblocks);    /* # free blocks must be < total */
+
     /* link into free list */
     ((RKH_FREE_BLK_T *)blk)->next = (RKH_FREE_BLK_T *)mp->free;
     mp->free = blk;                      /* set as new head of the free list */
     ++mp->nfree;                         /* one more free block in this pool */
 
+    RKH_IUPDT_PUT(mp);
     RKH_TR_MP_PUT(mp, mp->nfree);
     RKH_EXIT_CRITICAL_();
+#endif
 }
 
 #if RKH_CFG_MP_GET_BSIZE_EN == RKH_ENABLED
@@ -222,6 +536,9 @@ RKH_MPNB_T
 rkh_memPool_get_nfree(RKH_MEMPOOL_T *mp)
 {
     RKH_MPNB_T nfree;
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    rui8_t slot;
+#endif
     RKH_SR_ALLOC();
 
     RKH_ASSERT(mp != (RKH_MEMPOOL_T *)0);
@@ -230,6 +547,13 @@ rkh_memPool_get_nfree(RKH_MEMPOOL_T *mp)
     nfree = mp->nfree;
     RKH_EXIT_CRITICAL_();
 
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    for (slot = 0; slot < RKH_CFG_FWK_MAX_SMA; ++slot)
+    {
+        nfree += mp->mag[slot].nblk;          /* approximated, not locked */
+    }
+#endif
+
     return nfree;
 }
 #endif
@@ -257,6 +581,9 @@ rkh_memPool_get_low_wmark(RKH_MEMPOOL_T *mp)
 void
 rkh_memPool_get_info(RKH_MEMPOOL_T *mp, RKH_MPI_T *mpi)
 {
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    rui8_t slot;
+#endif
     RKH_SR_ALLOC();
 
     RKH_ASSERT(mp != (RKH_MEMPOOL_T *)0 && mpi != (RKH_MPI_T *)0);
@@ -264,12 +591,24 @@ rkh_memPool_get_info(RKH_MEMPOOL_T *mp, RKH_MPI_T *mpi)
     RKH_ENTER_CRITICAL_();
     *mpi = mp->mpi;
     RKH_EXIT_CRITICAL_();
+
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    for (slot = 0; slot < RKH_CFG_FWK_MAX_SMA; ++slot)
+    {
+        mpi->gets += mp->mag[slot].mpi.gets;   /* approximated, not locked */
+        mpi->puts += mp->mag[slot].mpi.puts;
+        mpi->free += mp->mag[slot].mpi.free;
+    }
+#endif
 }
 
 void
 rkh_memPool_clear_info(RKH_MEMPOOL_T *mp)
 {
     RKH_MPI_T *pmpi;
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    rui8_t slot;
+#endif
     RKH_SR_ALLOC();
 
     RKH_ASSERT(mp != (RKH_MEMPOOL_T *)0);
@@ -278,6 +617,14 @@ rkh_memPool_clear_info(RKH_MEMPOOL_T *mp)
     RKH_ENTER_CRITICAL_();
     pmpi->inits = pmpi->gets = pmpi->puts = pmpi->free = pmpi->full = 0;
     RKH_EXIT_CRITICAL_();
+
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+    for (slot = 0; slot < RKH_CFG_FWK_MAX_SMA; ++slot)
+    {
+        pmpi = &mp->mag[slot].mpi;
+        pmpi->gets = pmpi->puts = pmpi->free = 0;
+    }
+#endif
 }
 #endif
 
@@ -0,0 +1,419 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Recycle Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       test_rkhmempool.c
+ *  \ingroup    test_mempool
+ *  \brief      Unit test for memory pool module.
+ *
+ *  \addtogroup test
+ *  @{
+ *  \addtogroup test_mempool Memory pool
+ *  @{
+ *  \brief      Unit test for memory pool module.
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/* ----------------------------- Include files ----------------------------- */
+#include "unity.h"
+#include "rkhmempool.h"
+#include "Mock_rkhassert.h"
+#include "Mock_rkhport.h"
+#include "Mock_rkhtrc_record.h"
+#include "Mock_rkhtrc_filter.h"
+#include <string.h>
+
+/* ----------------------------- Local macros ------------------------------ */
+#define BLOCK_SIZE      16
+#define NUM_BLOCKS      16
+
+/* ------------------------------- Constants ------------------------------- */
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+static RKH_MEMPOOL_T mp;
+static void *sto[(NUM_BLOCKS * BLOCK_SIZE) / sizeof(void *)];
+static void *blocks[NUM_BLOCKS];
+static rui8_t magSlot;
+static rbool_t trcOn;
+
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+static void
+MockAssertCallback(const char* const file, int line, int cmock_num_calls)
+{
+    TEST_PASS();
+}
+
+static rbool_t
+MockTrcIsOffCallback(RKH_TE_ID_T e, int cmock_num_calls)
+{
+    return trcOn;
+}
+
+static void
+getBlocks(int nBlocks)
+{
+    int i;
+
+    for (i = 0; i < nBlocks; ++i)
+    {
+        blocks[i] = rkh_memPool_get(&mp);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+}
+
+static void
+putBlocks(int nBlocks)
+{
+    int i;
+
+    for (i = 0; i < nBlocks; ++i)
+    {
+        rkh_memPool_put(&mp, blocks[i]);
+    }
+}
+
+/* ---------------------------- Global functions --------------------------- */
+rui8_t
+rkh_memPool_getMagSlot(void)
+{
+    return magSlot;
+}
+
+void
+setUp(void)
+{
+    Mock_rkhassert_Init();
+    Mock_rkhport_Init();
+    rkh_enter_critical_Ignore();
+    rkh_exit_critical_Ignore();
+    trcOn = RKH_FALSE;
+    rkh_trc_isoff__StubWithCallback(MockTrcIsOffCallback);
+    magSlot = RKH_MP_NO_MAG;
+    memset(&mp, 0, sizeof(mp));
+    rkh_memPool_init(&mp, sto, (RKH_MPSS_T)sizeof(sto), BLOCK_SIZE);
+}
+
+void
+tearDown(void)
+{
+    Mock_rkhassert_Verify();
+    Mock_rkhport_Verify();
+    Mock_rkhassert_Destroy();
+    Mock_rkhport_Destroy();
+}
+
+/**
+ *  \addtogroup test_shared Test cases of shared free list group
+ *  @{
+ *  \name Test cases of shared free list group
+ *  @{
+ */
+void
+test_AfterInitAllBlocksAreFree(void)
+{
+    RKH_MPI_T info;
+
+    TEST_ASSERT_EQUAL(NUM_BLOCKS, mp.nblocks);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS, rkh_memPool_get_nfree(&mp));
+    rkh_memPool_get_info(&mp, &info);
+    TEST_ASSERT_EQUAL(1, info.inits);
+    TEST_ASSERT_EQUAL(0, info.gets);
+}
+
+void
+test_SharedGetAndPutUpdateInfo(void)
+{
+    RKH_MPI_T info;
+
+    getBlocks(2);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - 2, rkh_memPool_get_nfree(&mp));
+    putBlocks(1);
+
+    rkh_memPool_get_info(&mp, &info);
+    TEST_ASSERT_EQUAL(2, info.gets);
+    TEST_ASSERT_EQUAL(1, info.puts);
+    TEST_ASSERT_EQUAL(0, info.free);
+}
+
+void
+test_SharedGetOnExhaustedPoolCountsNoFree(void)
+{
+    RKH_MPI_T info;
+
+    getBlocks(NUM_BLOCKS);
+    TEST_ASSERT_NULL(rkh_memPool_get(&mp));
+
+    rkh_memPool_get_info(&mp, &info);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS + 1, info.gets);
+    TEST_ASSERT_EQUAL(1, info.free);
+}
+
+void
+test_Fails_PutOnPoolWithAllBlocksFree(void)
+{
+    rkh_assert_Expect("rkhmempool", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    rkh_memPool_put(&mp, sto);
+    TEST_FAIL();
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+
+/**
+ *  \addtogroup test_magazine Test cases of magazine group
+ *  @{
+ *  \name Test cases of magazine group
+ *  @{
+ */
+void
+test_MagazineGetRefillsHalfMagazine(void)
+{
+    magSlot = 0;
+    getBlocks(1);
+
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - (RKH_CFG_MP_MAG_SIZE / 2), mp.nfree);
+    TEST_ASSERT_EQUAL((RKH_CFG_MP_MAG_SIZE / 2) - 1, mp.mag[0].nblk);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - 1, rkh_memPool_get_nfree(&mp));
+}
+
+void
+test_MagazinePutDrainsHalfMagazineWhenFull(void)
+{
+    getBlocks(RKH_CFG_MP_MAG_SIZE + 1);
+
+    magSlot = 1;
+    putBlocks(RKH_CFG_MP_MAG_SIZE);
+    TEST_ASSERT_EQUAL(RKH_CFG_MP_MAG_SIZE, mp.mag[1].nblk);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - RKH_CFG_MP_MAG_SIZE - 1, mp.nfree);
+
+    rkh_memPool_put(&mp, blocks[RKH_CFG_MP_MAG_SIZE]);
+    TEST_ASSERT_EQUAL((RKH_CFG_MP_MAG_SIZE / 2) + 1, mp.mag[1].nblk);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - (RKH_CFG_MP_MAG_SIZE / 2) - 1, mp.nfree);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS, rkh_memPool_get_nfree(&mp));
+}
+
+void
+test_MagazineGetAndPutUpdateInfo(void)
+{
+    RKH_MPI_T info;
+
+    magSlot = 0;
+    getBlocks(3);
+    putBlocks(2);
+    magSlot = RKH_MP_NO_MAG;
+    getBlocks(1);
+
+    rkh_memPool_get_info(&mp, &info);
+    TEST_ASSERT_EQUAL(4, info.gets);
+    TEST_ASSERT_EQUAL(2, info.puts);
+    TEST_ASSERT_EQUAL(0, info.free);
+}
+
+void
+test_MagazineGetOnExhaustedPoolCountsNoFree(void)
+{
+    RKH_MPI_T info;
+
+    getBlocks(NUM_BLOCKS);
+    magSlot = 0;
+    TEST_ASSERT_NULL(rkh_memPool_get(&mp));
+
+    rkh_memPool_get_info(&mp, &info);
+    TEST_ASSERT_EQUAL(NUM_BLOCKS + 1, info.gets);
+    TEST_ASSERT_EQUAL(1, info.free);
+}
+
+void
+test_ClearInfoClearsMagazines(void)
+{
+    RKH_MPI_T info;
+
+    magSlot = 0;
+    getBlocks(2);
+    putBlocks(2);
+    rkh_memPool_clear_info(&mp);
+
+    rkh_memPool_get_info(&mp, &info);
+    TEST_ASSERT_EQUAL(0, info.gets);
+    TEST_ASSERT_EQUAL(0, info.puts);
+}
+
+void
+test_MagazineGetEmitsTraceRecord(void)
+{
+    trcOn = RKH_TRUE;
+    rkh_trc_begin_Expect(RKH_TE_MP_GET);
+    rkh_trc_u32_Ignore();
+    rkh_trc_u8_Expect(NUM_BLOCKS - (RKH_CFG_MP_MAG_SIZE / 2));
+    rkh_trc_u8_Expect(NUM_BLOCKS - (RKH_CFG_MP_MAG_SIZE / 2));
+    rkh_trc_end_Expect();
+
+    magSlot = 0;
+    getBlocks(1);
+}
+
+void
+test_Fails_DrainOnPoolWithAllBlocksFree(void)
+{
+    int i;
+
+    rkh_assert_Expect("rkhmempool", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    /* a thread releases more blocks than it got, the excess is */
+    /* detected when the magazine is drained */
+    magSlot = 0;
+    for (i = 0; i <= RKH_CFG_MP_MAG_SIZE; ++i)
+    {
+        rkh_memPool_put(&mp, sto);
+    }
+    TEST_FAIL();
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+
+#if RKH_CFG_MP_LOCKFREE_EN == RKH_ENABLED
+/**
+ *  \addtogroup test_lockfree Test cases of lock-free free list group
+ *  @{
+ *  \name Test cases of lock-free free list group
+ *  @{
+ */
+void
+test_LockFreeHeadAfterInit(void)
+{
+    TEST_ASSERT_EQUAL(1, (rui32_t)(mp.head & 0xFFFFFFFFUL));
+    TEST_ASSERT_EQUAL(0, (rui32_t)(mp.head >> 32));
+}
+
+void
+test_LockFreeGetPopsHeadAndBumpsTag(void)
+{
+    getBlocks(2);
+
+    TEST_ASSERT_EQUAL_PTR(sto, blocks[0]);
+    TEST_ASSERT_EQUAL_PTR((rui8_t *)sto + BLOCK_SIZE, blocks[1]);
+    TEST_ASSERT_EQUAL(3, (rui32_t)(mp.head & 0xFFFFFFFFUL));
+    TEST_ASSERT_EQUAL(2, (rui32_t)(mp.head >> 32));
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - 2, mp.nfree);
+}
+
+void
+test_LockFreePutPushesBlockAsNewHead(void)
+{
+    getBlocks(2);
+    rkh_memPool_put(&mp, blocks[0]);
+
+    TEST_ASSERT_EQUAL(1, (rui32_t)(mp.head & 0xFFFFFFFFUL));
+    TEST_ASSERT_EQUAL(3, (rui32_t)(mp.head >> 32));
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - 1, mp.nfree);
+    TEST_ASSERT_EQUAL_PTR(blocks[0], rkh_memPool_get(&mp));
+}
+
+void
+test_LockFreeReusesAllBlocksInLifoOrder(void)
+{
+    int i;
+
+    getBlocks(NUM_BLOCKS);
+    TEST_ASSERT_EQUAL(0, (rui32_t)(mp.head & 0xFFFFFFFFUL));
+    putBlocks(NUM_BLOCKS);
+    for (i = NUM_BLOCKS - 1; i >= 0; --i)
+    {
+        TEST_ASSERT_EQUAL_PTR(blocks[i], rkh_memPool_get(&mp));
+    }
+    TEST_ASSERT_NULL(rkh_memPool_get(&mp));
+}
+
+void
+test_LockFreeKeepsLowWatermark(void)
+{
+    getBlocks(3);
+    putBlocks(3);
+
+    TEST_ASSERT_EQUAL(NUM_BLOCKS - 3, rkh_memPool_get_low_wmark(&mp));
+    TEST_ASSERT_EQUAL(NUM_BLOCKS, mp.nfree);
+}
+
+void
+test_LockFreeGetEmitsTraceRecord(void)
+{
+    trcOn = RKH_TRUE;
+    rkh_trc_begin_Expect(RKH_TE_MP_GET);
+    rkh_trc_u32_Ignore();
+    rkh_trc_u8_Expect(NUM_BLOCKS - 1);
+    rkh_trc_u8_Expect(NUM_BLOCKS - 1);
+    rkh_trc_end_Expect();
+
+    getBlocks(1);
+}
+
+void
+test_LockFreePutEmitsTraceRecord(void)
+{
+    getBlocks(1);
+    trcOn = RKH_TRUE;
+    rkh_trc_begin_Expect(RKH_TE_MP_PUT);
+    rkh_trc_u32_Ignore();
+    rkh_trc_u8_Expect(NUM_BLOCKS);
+    rkh_trc_end_Expect();
+
+    putBlocks(1);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/* ------------------------------ End of file ------------------------------ */
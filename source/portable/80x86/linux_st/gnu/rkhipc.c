@@ -0,0 +1,539 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+
+/**
+ *  \file       rkhipc.c
+ *  \brief      Shared-memory event transport between RKH processes running 
+ *              on the same host (Linux).
+ *
+ *  \ingroup    port
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.16  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/*
+ *  (1) The ring head and tail are free-running counters, each one written 
+ *      by one side only. The slot contents are published by a full 
+ *      barrier before storing the head, and released by a full barrier 
+ *      before storing the tail.
+ *  (2) The consumer announces it is about to sleep by setting the 
+ *      sleeping flag and then it checks the head again, while the 
+ *      producer stores the head and then checks the flag. Both sides 
+ *      place a full barrier in between, thus a wake-up cannot be lost.
+ *  (3) Both futex operations are not private, since the futex word is 
+ *      shared by different processes.
+ *  (4) A name already in use is only taken over when its ring is complete 
+ *      and the process that created it does not exist anymore. A ring 
+ *      being created by another process has no magic yet, thus it is 
+ *      never removed.
+ */
+
+/* ----------------------------- Include files ----------------------------- */
+#define _GNU_SOURCE                     /* syscall() */
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "rkh.h"
+#include "rkhfwk_dynevt.h"
+#include "rkhfwk_pubsub.h"
+#include "rkhipc.h"
+
+/* 
+ * The proxy needs the virtual functions of the active objects and the 
+ * events are sent by copy from dynamic events, thus the transport is left 
+ * out of the build otherwise.
+ */
+#if ((RKH_CFG_SMA_VFUNCT_EN == RKH_ENABLED) && \
+     (RKH_CFG_FWK_DYN_EVT_EN == RKH_ENABLED))
+
+RKH_MODULE_NAME(rkhipc)
+
+/* ----------------------------- Local macros ------------------------------ */
+#define RKH_IPC_ROUNDUP(x_, a_)     (((x_) + ((a_) - 1)) & ~((a_) - 1))
+#define RKH_IPC_SLOT_STRIDE(size_) \
+    RKH_IPC_ROUNDUP((size_) + RKH_IPC_SLOT_HDR, RKH_IPC_SLOT_ALIGN)
+#define RKH_IPC_STRIDE(ring_)       RKH_IPC_SLOT_STRIDE((ring_)->slotSize)
+#define RKH_IPC_SLOT(ring_, n_) \
+    ((rui8_t *)((ring_) + 1) + \
+     (((n_) & ((ring_)->nSlots - 1)) * RKH_IPC_STRIDE(ring_)))
+
+/* ------------------------------- Constants ------------------------------- */
+#define RKH_IPC_MAGIC               0x524B4849u     /* "RKHI" */
+#define RKH_IPC_LINE                64u             /* cache line size */
+#define RKH_IPC_SLOT_ALIGN          8u
+#define RKH_IPC_SLOT_HDR            RKH_IPC_SLOT_ALIGN  /* size word */
+
+/* 
+ * Number of polls of an empty ring before sleeping on the futex. Thus, 
+ * the consumer of a busy link takes the events without any syscall.
+ */
+#ifndef RKH_IPC_SPIN
+#define RKH_IPC_SPIN                2000u
+#endif
+
+/* 
+ * Maximum sleep of the consumer, which bounds the time taken by 
+ * rkh_ipc_stopBridge().
+ */
+#define RKH_IPC_SLEEP_NSEC          100000000L
+
+/* ---------------------------- Local data types --------------------------- */
+struct RKHIpcRing
+{
+    unsigned int magic;
+    unsigned int nSlots;
+    unsigned int slotSize;
+    unsigned int nLost;
+    pid_t pid;                          /* creator */
+    char pad0[RKH_IPC_LINE - (4 * sizeof(unsigned int)) - sizeof(pid_t)];
+    volatile unsigned int head;         /* futex word, producer side */
+    volatile unsigned int sleeping;
+    char pad1[RKH_IPC_LINE - (2 * sizeof(unsigned int))];
+    volatile unsigned int tail;         /* consumer side */
+    char pad2[RKH_IPC_LINE - sizeof(unsigned int)];
+};
+
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+/* ----------------------- Local function prototypes ----------------------- */
+static void proxyActivate(RKH_SMA_T *me, const RKH_EVT_T **qSto, 
+                          RKH_QUENE_T qSize, void *stkSto, rui32_t stkSize);
+#if defined(RKH_USE_TRC_SENDER)
+static void proxyPost(RKH_SMA_T *me, const RKH_EVT_T *e, 
+                      const void *const sender);
+#else
+static void proxyPost(RKH_SMA_T *me, const RKH_EVT_T *e);
+#endif
+
+/* ---------------------------- Local functions ---------------------------- */
+static const RKHSmaVtbl proxyVtbl =
+{
+    proxyActivate,
+    (RKHTask)0,                     /* it never has events to dispatch */
+    proxyPost,
+    proxyPost
+};
+
+static void
+futexWait(volatile unsigned int *addr, unsigned int val)
+{
+    struct timespec tout;
+
+    tout.tv_sec = 0;
+    tout.tv_nsec = RKH_IPC_SLEEP_NSEC;
+    (void)syscall(SYS_futex, addr, FUTEX_WAIT, val, &tout, (void *)0, 0);
+}
+
+static void
+futexWake(volatile unsigned int *addr)
+{
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE, 1, (void *)0, (void *)0, 0);
+}
+
+static size_t
+ringSize(rui32_t nSlots, rui32_t slotSize)
+{
+    return sizeof(RKHIpcRing) + 
+           ((size_t)nSlots * RKH_IPC_SLOT_STRIDE((size_t)slotSize));
+}
+
+static rbool_t
+isRingValid(const RKHIpcRing *ring, size_t size)
+{
+    if ((ring->magic != RKH_IPC_MAGIC) || (ring->nSlots == 0) || 
+        ((ring->nSlots & (ring->nSlots - 1)) != 0) || 
+        (ring->slotSize < sizeof(RKH_EVT_T)))
+    {
+        return RKH_FALSE;
+    }
+    return (rbool_t)(((size - sizeof(RKHIpcRing)) / RKH_IPC_STRIDE(ring)) >= 
+                     ring->nSlots);
+}
+
+static rbool_t
+isStale(const char *name)
+{
+    int fd;
+    struct stat st;
+    void *p;
+    const RKHIpcRing *ring;
+    rbool_t stale;
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return (rbool_t)(errno == ENOENT);  /* it has just been removed */
+    }
+    if ((fstat(fd, &st) != 0) || 
+        ((size_t)st.st_size < sizeof(RKHIpcRing)))
+    {
+        (void)close(fd);
+        return RKH_FALSE;
+    }
+    p = mmap((void *)0, sizeof(RKHIpcRing), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (p == MAP_FAILED)
+    {
+        return RKH_FALSE;
+    }
+    ring = (const RKHIpcRing *)p;
+    stale = (rbool_t)((ring->magic == RKH_IPC_MAGIC) &&     /* Note (4) */
+                      (kill(ring->pid, 0) != 0) && (errno == ESRCH));
+    (void)munmap(p, sizeof(RKHIpcRing));
+    return stale;
+}
+
+static void
+proxyActivate(RKH_SMA_T *me, const RKH_EVT_T **qSto, RKH_QUENE_T qSize, 
+              void *stkSto, rui32_t stkSize)
+{
+    (void)qSto;
+    (void)qSize;
+    (void)stkSto;
+    (void)stkSize;
+
+    rkh_sma_register(me);
+}
+
+static void
+#if defined(RKH_USE_TRC_SENDER)
+proxyPost(RKH_SMA_T *me, const RKH_EVT_T *e, const void *const sender)
+#else
+proxyPost(RKH_SMA_T *me, const RKH_EVT_T *e)
+#endif
+{
+    RKHIpcProxy *proxy;
+    rui32_t size;
+
+#if defined(RKH_USE_TRC_SENDER)
+    (void)sender;
+#endif
+    proxy = (RKHIpcProxy *)me;
+    size = (proxy->evtSize != (RKHIpcEvtSize)0) ? proxy->evtSize(e) : 
+                                                  sizeof(RKH_EVT_T);
+    (void)rkh_ipc_send(proxy->link, e, size);
+
+    /* 
+     * The copy consumes the event, so it is referenced and recycled as if 
+     * it had been queued and dispatched.
+     */
+    RKH_FWK_RSV((RKH_EVT_T *)e);
+    RKH_FWK_GC((RKH_EVT_T *)e, me);
+}
+
+static
+void *
+bridgeThread(void *arg)
+{
+    RKHIpcBridge *me;
+    RKH_EVT_T *e;
+
+    me = (RKHIpcBridge *)arg;
+    while (me->running)
+    {
+        e = rkh_ipc_recv(me->link, me);
+        if (e == (RKH_EVT_T *)0)
+        {
+            continue;
+        }
+        if (me->target != (RKH_SMA_T *)0)
+        {
+            RKH_SMA_POST_FIFO(me->target, e, me);
+        }
+#if RKH_CFG_FWK_PUBSUB_EN == RKH_ENABLED
+        else
+        {
+            (void)rkh_pubsub_publish(me->channel, e, me);
+        }
+#endif
+    }
+    return (void *)0;
+}
+
+/* ---------------------------- Global functions --------------------------- */
+rbool_t
+rkh_ipc_open(RKHIpcLink *me, const char *name, rui32_t nSlots, 
+             rui32_t slotSize, rbool_t create)
+{
+    int fd;
+    struct stat st;
+    size_t size;
+    void *p;
+    RKHIpcRing *ring;
+
+    RKH_REQUIRE((me != (RKHIpcLink *)0) && (name != (const char *)0) && 
+                (strlen(name) < sizeof(me->name)));
+    strcpy(me->name, name);
+    if (create)
+    {
+        RKH_REQUIRE((nSlots != 0) && ((nSlots & (nSlots - 1)) == 0) && 
+                    (slotSize >= sizeof(RKH_EVT_T)));
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if ((fd < 0) && (errno == EEXIST) && isStale(name))
+        {
+            (void)shm_unlink(name);         /* left by a dead process */
+            fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+        if (fd < 0)
+        {
+            return RKH_FALSE;
+        }
+        size = ringSize(nSlots, slotSize);
+        if (ftruncate(fd, (off_t)size) != 0)
+        {
+            (void)close(fd);
+            (void)shm_unlink(name);
+            return RKH_FALSE;
+        }
+    }
+    else
+    {
+        fd = shm_open(name, O_RDWR, 0);
+        if (fd < 0)
+        {
+            return RKH_FALSE;
+        }
+        if ((fstat(fd, &st) != 0) || 
+            ((size_t)st.st_size < sizeof(RKHIpcRing)))
+        {
+            (void)close(fd);
+            return RKH_FALSE;
+        }
+        size = (size_t)st.st_size;
+    }
+
+    p = mmap((void *)0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (p == MAP_FAILED)
+    {
+        if (create)
+        {
+            (void)shm_unlink(name);
+        }
+        return RKH_FALSE;
+    }
+
+    ring = (RKHIpcRing *)p;
+    if (create)
+    {
+        ring->nSlots = (unsigned int)nSlots;
+        ring->slotSize = (unsigned int)slotSize;
+        ring->pid = getpid();
+        __sync_synchronize();
+        ring->magic = RKH_IPC_MAGIC;        /* the ring is ready to attach */
+    }
+    else if (!isRingValid(ring, size))
+    {
+        (void)munmap(p, size);
+        return RKH_FALSE;
+    }
+
+    me->ring = ring;
+    me->size = (rui32_t)size;
+    me->owner = create;
+    return RKH_TRUE;
+}
+
+void
+rkh_ipc_close(RKHIpcLink *me)
+{
+    RKH_REQUIRE((me != (RKHIpcLink *)0) && (me->ring != (RKHIpcRing *)0));
+    (void)munmap(me->ring, (size_t)me->size);
+    if (me->owner)
+    {
+        (void)shm_unlink(me->name);
+    }
+    me->ring = (RKHIpcRing *)0;
+}
+
+rbool_t
+rkh_ipc_send(RKHIpcLink *me, const RKH_EVT_T *e, rui32_t size)
+{
+    RKHIpcRing *ring;
+    unsigned int head;
+    rui8_t *slot;
+    rbool_t sent, wake;
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((me != (RKHIpcLink *)0) && (e != (const RKH_EVT_T *)0));
+    ring = me->ring;
+    RKH_REQUIRE((size >= sizeof(RKH_EVT_T)) && (size <= ring->slotSize));
+    sent = wake = RKH_FALSE;
+
+    RKH_ENTER_CRITICAL_();
+    head = ring->head;
+    if ((head - ring->tail) < ring->nSlots)
+    {
+        __sync_synchronize();                   /* see Note (1) */
+        slot = RKH_IPC_SLOT(ring, head);
+        *(unsigned int *)slot = (unsigned int)size;
+        memcpy(slot + RKH_IPC_SLOT_HDR, e, (size_t)size);
+        __sync_synchronize();
+        ring->head = head + 1;
+        __sync_synchronize();                   /* see Note (2) */
+        wake = (rbool_t)(ring->sleeping != 0);
+        sent = RKH_TRUE;
+    }
+    else
+    {
+        (void)__sync_add_and_fetch(&ring->nLost, 1);
+    }
+    RKH_EXIT_CRITICAL_();
+
+    if (wake)
+    {
+        futexWake(&ring->head);
+    }
+    return sent;
+}
+
+RKH_EVT_T *
+rkh_ipc_recv(RKHIpcLink *me, const void *const sender)
+{
+    RKHIpcRing *ring;
+    unsigned int tail, size, nSpin;
+    const rui8_t *slot;
+    const RKH_EVT_T *src;
+    RKH_EVT_T *e;
+
+    RKH_REQUIRE(me != (RKHIpcLink *)0);
+    ring = me->ring;
+    tail = ring->tail;
+    for (nSpin = 0; ring->head == tail; ++nSpin)
+    {
+        if (nSpin >= RKH_IPC_SPIN)
+        {
+            ring->sleeping = 1;
+            __sync_synchronize();               /* see Note (2) */
+            if (ring->head == tail)
+            {
+                futexWait(&ring->head, tail);
+            }
+            ring->sleeping = 0;
+            if (ring->head == tail)             /* woken up with no event */
+            {
+                return (RKH_EVT_T *)0;
+            }
+            break;
+        }
+    }
+    __sync_synchronize();                       /* see Note (1) */
+
+    slot = RKH_IPC_SLOT(ring, tail);
+    size = *(const unsigned int *)slot;
+    src = (const RKH_EVT_T *)(slot + RKH_IPC_SLOT_HDR);
+    e = rkh_fwk_ae_try((RKH_ES_T)size, src->e, sender);
+    if (e != (RKH_EVT_T *)0)
+    {
+        /* the new event keeps its own pool and reference counter */
+        memcpy((rui8_t *)e + sizeof(RKH_EVT_T), 
+               (const rui8_t *)src + sizeof(RKH_EVT_T), 
+               (size_t)(size - sizeof(RKH_EVT_T)));
+    }
+    else
+    {
+        (void)__sync_add_and_fetch(&ring->nLost, 1);
+    }
+
+    __sync_synchronize();
+    ring->tail = tail + 1;
+    return e;
+}
+
+rui32_t
+rkh_ipc_getNumLost(RKHIpcLink *me)
+{
+    RKH_REQUIRE((me != (RKHIpcLink *)0) && (me->ring != (RKHIpcRing *)0));
+    return (rui32_t)__sync_fetch_and_add(&me->ring->nLost, 0);
+}
+
+void
+rkh_ipc_proxyCtor(RKHIpcProxy *me, RKHIpcLink *link, RKHIpcEvtSize evtSize)
+{
+    RKH_REQUIRE((me != (RKHIpcProxy *)0) && (link != (RKHIpcLink *)0));
+    me->sma.vptr = &proxyVtbl;     /* its state machine is never used */
+    me->link = link;
+    me->evtSize = evtSize;
+}
+
+rbool_t
+rkh_ipc_startBridge(RKHIpcBridge *me, RKHIpcLink *link, RKH_SMA_T *target, 
+                    rui8_t channel)
+{
+    RKH_REQUIRE((me != (RKHIpcBridge *)0) && (link != (RKHIpcLink *)0));
+#if RKH_CFG_FWK_PUBSUB_EN != RKH_ENABLED
+    RKH_REQUIRE(target != (RKH_SMA_T *)0);
+#endif
+    me->link = link;
+    me->target = target;
+    me->channel = channel;
+    me->running = RKH_TRUE;
+    if (pthread_create(&me->thread, (const pthread_attr_t *)0, 
+                       bridgeThread, me) != 0)
+    {
+        me->running = RKH_FALSE;
+        return RKH_FALSE;
+    }
+    return RKH_TRUE;
+}
+
+void
+rkh_ipc_stopBridge(RKHIpcBridge *me)
+{
+    RKH_REQUIRE(me != (RKHIpcBridge *)0);
+    me->running = RKH_FALSE;
+    futexWake(&me->link->ring->head);
+    (void)pthread_join(me->thread, (void **)0);
+}
+
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
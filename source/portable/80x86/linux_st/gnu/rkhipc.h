@@ -0,0 +1,275 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+
+/**
+ *  \file       rkhipc.h
+ *  \brief      Shared-memory event transport between RKH processes running 
+ *              on the same host (Linux).
+ *
+ *  A link is a single-producer/single-consumer ring of fixed-size slots 
+ *  placed in a POSIX shared memory object. The producer process posts to a 
+ *  proxy active object, which copies the event into a slot, and the 
+ *  consumer process runs a bridge thread that takes it out into a dynamic 
+ *  event and forwards it to a local active object or publishes it on a 
+ *  channel. An idle consumer sleeps on a futex placed in the ring, thus no 
+ *  socket, syscall or serialization is involved in the fast path.
+ *
+ *  \ingroup    port
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.16  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/* --------------------------------- Module -------------------------------- */
+#ifndef __RKHIPC_H__
+#define __RKHIPC_H__
+
+/* ----------------------------- Include files ----------------------------- */
+#include <pthread.h>
+#include "rkhsma.h"
+
+/* ---------------------- External C language linkage ---------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------------- Macros -------------------------------- */
+/* -------------------------------- Constants ------------------------------ */
+/* ------------------------------- Data types ------------------------------ */
+/**
+ *  \brief
+ *  Shared ring of a link. It lives in the shared memory object and it is 
+ *  followed by its slots. Each slot starts with the event size followed by 
+ *  the event itself.
+ */
+typedef struct RKHIpcRing RKHIpcRing;
+
+/**
+ *  \brief
+ *  Process-local handle of a link.
+ */
+typedef struct RKHIpcLink RKHIpcLink;
+struct RKHIpcLink
+{
+    /** Mapped ring */
+    RKHIpcRing *ring;
+
+    /** Mapped size in bytes */
+    rui32_t size;
+
+    /** The creator removes the shared memory object when closing */
+    rbool_t owner;
+
+    /** Name of the shared memory object */
+    char name[32];
+};
+
+/**
+ *  \brief
+ *  Returns the number of bytes of an event to be copied into the link. 
+ *  RKH events do not carry their size, thus the proxy asks the application 
+ *  for it, usually from the event signal.
+ */
+typedef rui32_t (*RKHIpcEvtSize)(const RKH_EVT_T *e);
+
+/**
+ *  \brief
+ *  Proxy active object. It stands for a remote active object, or a remote 
+ *  publish-subscribe channel, in the producer process. It has no queue nor 
+ *  state machine, its post operations copy the event into the link. 
+ *  Since it is registered as any other active object, it can also be 
+ *  subscribed to local channels by means of rkh_pubsub_subscribe().
+ *
+ *  It must be created by RKH_SMA_CREATE() with no states, constructed by 
+ *  rkh_ipc_proxyCtor() and then activated by RKH_SMA_ACTIVATE().
+ */
+typedef struct RKHIpcProxy RKHIpcProxy;
+struct RKHIpcProxy
+{
+    /** Base class */
+    RKH_SMA_T sma;
+
+    /** Link to the consumer process */
+    RKHIpcLink *link;
+
+    /** Size of the events to copy, NULL means sizeof(RKH_EVT_T) */
+    RKHIpcEvtSize evtSize;
+};
+
+/**
+ *  \brief
+ *  Bridge of the consumer process. Its thread takes the events out of a 
+ *  link and forwards them to the target active object or, if there is no 
+ *  target, it publishes them on a channel.
+ */
+typedef struct RKHIpcBridge RKHIpcBridge;
+struct RKHIpcBridge
+{
+    /** Link from the producer process */
+    RKHIpcLink *link;
+
+    /** Local active object receiving the events, or NULL */
+    RKH_SMA_T *target;
+
+    /** Channel on which the events are published when target is NULL */
+    rui8_t channel;
+
+    /** Running flag */
+    volatile rbool_t running;
+
+    /** Bridge thread */
+    pthread_t thread;
+};
+
+/* -------------------------- External variables --------------------------- */
+/* -------------------------- Function prototypes -------------------------- */
+/**
+ *  \brief
+ *  Creates or attaches to a link.
+ *
+ *  \param[in] me       pointer to the link handle.
+ *  \param[in] name     name of the shared memory object, e.g. "/rkh.gw".
+ *  \param[in] nSlots   number of slots, a power of two. It is only used by 
+ *                      the creator, otherwise it is taken from the ring.
+ *  \param[in] slotSize maximum event size in bytes. It is only used by the 
+ *                      creator, otherwise it is taken from the ring.
+ *  \param[in] create   RKH_TRUE to create the link, RKH_FALSE to attach to 
+ *                      an existing one.
+ *
+ *  \return
+ *  RKH_TRUE if the link is ready, otherwise RKH_FALSE. The creation fails 
+ *  when the name is in use, unless it was left by a process that does not 
+ *  exist anymore. The attachment fails when the object is not a complete 
+ *  ring, i.e. it is smaller than its slots.
+ */
+rbool_t rkh_ipc_open(RKHIpcLink *me, const char *name, rui32_t nSlots, 
+                     rui32_t slotSize, rbool_t create);
+
+/**
+ *  \brief
+ *  Detaches from a link. The creator also removes the shared memory 
+ *  object, although it remains mapped by the other side until it closes.
+ */
+void rkh_ipc_close(RKHIpcLink *me);
+
+/**
+ *  \brief
+ *  Copies an event into the link and wakes up the consumer if it sleeps.
+ *  A link has a single producer, the caller is serialized with the other 
+ *  producer threads of the same process by the port critical section.
+ *
+ *  \param[in] me       pointer to the link handle.
+ *  \param[in] e        pointer to the event to send.
+ *  \param[in] size     event size in bytes, including RKH_EVT_T.
+ *
+ *  \return
+ *  RKH_TRUE if the event was sent, RKH_FALSE if the ring is full, in which 
+ *  case the event is counted as lost.
+ */
+rbool_t rkh_ipc_send(RKHIpcLink *me, const RKH_EVT_T *e, rui32_t size);
+
+/**
+ *  \brief
+ *  Takes the next event out of the link into a new dynamic event. When 
+ *  the ring is empty it spins for a while and then sleeps on the ring's 
+ *  futex.
+ *
+ *  \param[in] me       pointer to the link handle.
+ *  \param[in] sender   sender of the new event.
+ *
+ *  \return
+ *  Pointer to the event or NULL if the consumer was woken up with no 
+ *  event, or the event cannot be allocated, in which case it is counted 
+ *  as lost.
+ */
+RKH_EVT_T *rkh_ipc_recv(RKHIpcLink *me, const void *const sender);
+
+/**
+ *  \brief
+ *  Retrieves the number of events lost by a link, either because its ring 
+ *  was full or because no event pool could hold them.
+ */
+rui32_t rkh_ipc_getNumLost(RKHIpcLink *me);
+
+/**
+ *  \brief
+ *  Constructs a proxy active object.
+ *
+ *  \param[in] me       pointer to the proxy.
+ *  \param[in] link     pointer to a link opened by the producer process.
+ *  \param[in] evtSize  event size callback, NULL if every event is a plain 
+ *                      RKH_EVT_T.
+ */
+void rkh_ipc_proxyCtor(RKHIpcProxy *me, RKHIpcLink *link, 
+                       RKHIpcEvtSize evtSize);
+
+/**
+ *  \brief
+ *  Starts the bridge thread of a consumer process.
+ *
+ *  \param[in] me       pointer to the bridge.
+ *  \param[in] link     pointer to a link opened by the consumer process.
+ *  \param[in] target   local active object receiving the events, or NULL 
+ *                      to publish them on \a channel.
+ *  \param[in] channel  publish-subscribe channel, used if \a target is NULL.
+ *
+ *  \return
+ *  RKH_TRUE if the thread was started, otherwise RKH_FALSE.
+ */
+rbool_t rkh_ipc_startBridge(RKHIpcBridge *me, RKHIpcLink *link, 
+                            RKH_SMA_T *target, rui8_t channel);
+
+/**
+ *  \brief
+ *  Stops the bridge thread and waits for it.
+ */
+void rkh_ipc_stopBridge(RKHIpcBridge *me);
+
+/* -------------------- External C language linkage end -------------------- */
+#ifdef __cplusplus
+}
+#endif
+
+/* ------------------------------ Module end ------------------------------- */
+#endif
+
+/* ------------------------------ End of file ------------------------------ */
@@ -51,16 +51,27 @@
 
 /* --------------------------------- Notes --------------------------------- */
 /* ----------------------------- Include files ----------------------------- */
+#define _GNU_SOURCE                     /* MAP_ANONYMOUS, MAP_HUGETLB, ... */
 #include <pthread.h>
 #include <semaphore.h>
+#include <sys/mman.h>
 
 #include "rkh.h"
 #include "rkhfwk_dynevt.h"
 
 /* ----------------------------- Local macros ------------------------------ */
 /* (1) Function macro defines */
+#define RKHPORT_ROUNDUP(x_, a_)     (((x_) + ((a_) - 1)) & ~((a_) - 1))
 
 /* ------------------------------- Constants ------------------------------- */
+#ifndef RKHPORT_HUGEPAGE_SIZE
+#define RKHPORT_HUGEPAGE_SIZE       (2UL * 1024UL * 1024UL)
+#endif
+
+#ifndef MAP_POPULATE
+#define MAP_POPULATE                0
+#endif
+
 RKH_MODULE_NAME(rkhport)
 RKH_MODULE_VERSION(rkhport, 1.00)
 RKH_MODULE_DESC(rkhport, "Linux 32-bits (single thread)")
@@ -119,6 +130,54 @@ rkhport_wait_for_events(void)
     ((void)sem_wait(&sma_is_rdy));
 }
 
+void *
+rkhport_mapPoolSto(rui32_t ssize, rbool_t huge)
+{
+    void *sto;
+    size_t len;
+
+    sto = MAP_FAILED;
+    len = (size_t)ssize;
+#if defined(MAP_HUGETLB)
+    if (huge)
+    {
+        len = RKHPORT_ROUNDUP(len, RKHPORT_HUGEPAGE_SIZE);
+        sto = mmap((void *)0, len, PROT_READ | PROT_WRITE, 
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, 
+                   -1, 0);
+    }
+#endif
+    if (sto == MAP_FAILED)        /* no reserved huge pages, use base pages */
+    {
+        sto = mmap((void *)0, len, PROT_READ | PROT_WRITE, 
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        if (sto == MAP_FAILED)
+        {
+            return (void *)0;
+        }
+#if defined(MADV_HUGEPAGE)
+        if (huge)
+        {
+            (void)madvise(sto, len, MADV_HUGEPAGE);  /* transparent ones */
+        }
+#endif
+    }
+    return sto;
+}
+
+void
+rkhport_unmapPoolSto(void *sto, rui32_t ssize, rbool_t huge)
+{
+    size_t len;
+
+    len = (size_t)ssize;
+    if (huge)
+    {
+        len = RKHPORT_ROUNDUP(len, RKHPORT_HUGEPAGE_SIZE);
+    }
+    (void)munmap(sto, len);
+}
+
 void
 rkh_sma_block(RKH_SMA_T *const me)
 {
@@ -174,6 +233,7 @@ rkh_fwk_enter(void)
             e = rkh_sma_get(sma);
             RKH_SMA_DISPATCH(sma, e);
             RKH_FWK_GC(e, sma);
+            RKH_SMA_SCRATCH_RESET(sma);
         }
         else
         {
@@ -191,6 +191,31 @@ void rkhport_enter_critical(void);
 void rkhport_exit_critical(void);
 void rkhport_wait_for_events(void);
 
+/**
+ *  \brief
+ *  Allocates a page-aligned and prefaulted storage for a large memory or 
+ *  event pool, so that it can be passed to rkh_memPool_init() or 
+ *  rkh_fwk_registerEvtPool(). When \a huge is true it is first backed by 
+ *  explicit huge pages (MAP_HUGETLB), then it falls back to base pages 
+ *  advised as transparent huge pages. Thus, large pools avoid the TLB 
+ *  misses. Remember to set RKH_CFG_MP_SIZEOF_SSIZE and 
+ *  RKH_CFG_MP_SIZEOF_NBLOCK to 32 for pools greater than 64 KB.
+ *
+ *  \param[in] ssize	storage size in bytes.
+ *  \param[in] huge 	requests huge pages.
+ *
+ *  \return
+ *  Pointer to the storage or NULL if it cannot be mapped.
+ */
+void *rkhport_mapPoolSto(rui32_t ssize, rbool_t huge);
+
+/**
+ *  \brief
+ *  Releases a storage previously returned by rkhport_mapPoolSto(). 
+ *  The arguments \a ssize and \a huge must match that call.
+ */
+void rkhport_unmapPoolSto(void *sto, rui32_t ssize, rbool_t huge);
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
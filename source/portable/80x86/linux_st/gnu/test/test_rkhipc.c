@@ -0,0 +1,222 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       test_rkhipc.c
+ *  \ingroup    test_port
+ *  \brief      Unit test for the shared-memory transport of the Linux port.
+ *
+ *  \addtogroup test
+ *  @{
+ *  \addtogroup test_port Port
+ *  @{
+ *  \brief      Unit test for the shared-memory transport of the Linux port.
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/*
+ *  The links are real POSIX shared memory objects, thus these tests run on
+ *  a Linux host only.
+ */
+
+/* ----------------------------- Include files ----------------------------- */
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "unity.h"
+#include "rkhipc.h"
+#include "Mock_rkhport.h"
+#include "Mock_rkhassert.h"
+#include "Mock_rkhsma.h"
+#include "Mock_rkhfwk_dynevt.h"
+#include "Mock_rkhfwk_pubsub.h"
+
+/* ----------------------------- Local macros ------------------------------ */
+/* ------------------------------- Constants ------------------------------- */
+#define NUM_SLOTS           8u
+
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+static RKHIpcLink creator, peer;
+static char name[32];
+static RKH_EVT_T evt;
+
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+/* ---------------------------- Global functions --------------------------- */
+void
+setUp(void)
+{
+    rkh_enter_critical_Ignore();
+    rkh_exit_critical_Ignore();
+    snprintf(name, sizeof(name), "/rkh.test.%d", (int)getpid());
+    (void)shm_unlink(name);
+    creator.ring = peer.ring = (RKHIpcRing *)0;
+    evt.e = 1;
+}
+
+void
+tearDown(void)
+{
+    if (peer.ring != (RKHIpcRing *)0)
+    {
+        rkh_ipc_close(&peer);
+    }
+    if (creator.ring != (RKHIpcRing *)0)
+    {
+        rkh_ipc_close(&creator);
+    }
+    (void)shm_unlink(name);
+}
+
+/**
+ *  \addtogroup test_ipc Shared-memory transport test group
+ *  @{
+ *  \name Test cases of shared-memory transport test group
+ *  @{
+ */
+void
+test_CreateAndAttachLink(void)
+{
+    TEST_ASSERT_TRUE(rkh_ipc_open(&creator, name, NUM_SLOTS,
+                                  sizeof(RKH_EVT_T), RKH_TRUE));
+    TEST_ASSERT_TRUE(rkh_ipc_open(&peer, name, 0, 0, RKH_FALSE));
+    TEST_ASSERT_EQUAL(creator.size, peer.size);
+    TEST_ASSERT_FALSE(peer.owner);
+}
+
+void
+test_FailsCreateLinkInUse(void)
+{
+    TEST_ASSERT_TRUE(rkh_ipc_open(&creator, name, NUM_SLOTS,
+                                  sizeof(RKH_EVT_T), RKH_TRUE));
+    TEST_ASSERT_FALSE(rkh_ipc_open(&peer, name, NUM_SLOTS,
+                                   sizeof(RKH_EVT_T), RKH_TRUE));
+    TEST_ASSERT_NULL(peer.ring);
+
+    /* the link in use is left untouched */
+    TEST_ASSERT_TRUE(rkh_ipc_send(&creator, &evt, sizeof(RKH_EVT_T)));
+    TEST_ASSERT_TRUE(rkh_ipc_open(&peer, name, 0, 0, RKH_FALSE));
+    TEST_ASSERT_EQUAL(0, rkh_ipc_getNumLost(&peer));
+}
+
+void
+test_FailsCreateLinkOfUnknownObject(void)
+{
+    int fd;
+
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    TEST_ASSERT_TRUE(fd >= 0);
+    (void)close(fd);
+
+    TEST_ASSERT_FALSE(rkh_ipc_open(&creator, name, NUM_SLOTS,
+                                   sizeof(RKH_EVT_T), RKH_TRUE));
+}
+
+void
+test_CreateLinkLeftByDeadProcess(void)
+{
+    pid_t pid;
+    int status;
+
+    pid = fork();
+    TEST_ASSERT_TRUE(pid >= 0);
+    if (pid == 0)
+    {
+        _exit(rkh_ipc_open(&creator, name, NUM_SLOTS, sizeof(RKH_EVT_T),
+                           RKH_TRUE) ? 0 : 1);
+    }
+    TEST_ASSERT_EQUAL(pid, waitpid(pid, &status, 0));
+    TEST_ASSERT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+    TEST_ASSERT_TRUE(rkh_ipc_open(&creator, name, NUM_SLOTS,
+                                  sizeof(RKH_EVT_T), RKH_TRUE));
+    TEST_ASSERT_TRUE(creator.owner);
+}
+
+void
+test_FailsAttachMissingLink(void)
+{
+    TEST_ASSERT_FALSE(rkh_ipc_open(&peer, name, 0, 0, RKH_FALSE));
+}
+
+void
+test_FailsAttachTruncatedRing(void)
+{
+    int fd;
+
+    TEST_ASSERT_TRUE(rkh_ipc_open(&creator, name, NUM_SLOTS,
+                                  sizeof(RKH_EVT_T), RKH_TRUE));
+    fd = shm_open(name, O_RDWR, 0);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL(0, ftruncate(fd, (off_t)(creator.size - 1)));
+    (void)close(fd);
+
+    TEST_ASSERT_FALSE(rkh_ipc_open(&peer, name, 0, 0, RKH_FALSE));
+    TEST_ASSERT_NULL(peer.ring);
+}
+
+void
+test_CountsLostEventsWhenRingIsFull(void)
+{
+    rui32_t i;
+
+    TEST_ASSERT_TRUE(rkh_ipc_open(&creator, name, NUM_SLOTS,
+                                  sizeof(RKH_EVT_T), RKH_TRUE));
+    for (i = 0; i < NUM_SLOTS; ++i)
+    {
+        TEST_ASSERT_TRUE(rkh_ipc_send(&creator, &evt, sizeof(RKH_EVT_T)));
+    }
+    TEST_ASSERT_FALSE(rkh_ipc_send(&creator, &evt, sizeof(RKH_EVT_T)));
+    TEST_ASSERT_EQUAL(1, rkh_ipc_getNumLost(&creator));
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/* ------------------------------ End of file ------------------------------ */
@@ -69,6 +69,11 @@ static CRITICAL_SECTION csection;
 static DWORD tick_msec = 10u;
 static rui8_t running;
 static HANDLE idle_thread;
+#if ((RKH_CFG_MP_MAG_EN == RKH_ENABLED) || \
+     (RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED) || \
+     (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED))
+static DWORD magSlot;   /* TLS index of the magazine, affinity and lane */
+#endif
 #if defined(RKH_USE_TRC_SENDER)
 static rui8_t l_isr_tick;
 #endif
@@ -101,11 +106,20 @@ thread_function(LPVOID arg)
 {
     RKH_SR_ALLOC();
 
+#if ((RKH_CFG_MP_MAG_EN == RKH_ENABLED) || \
+     (RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED) || \
+     (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED))
+    /* the slot is stored as prio + 1, thus 0 means no magazine */
+    (void)TlsSetValue(magSlot, 
+                      (LPVOID)(DWORD_PTR)(RKH_GET_PRIO((RKH_SMA_T *)arg) + 1));
+#endif
+
     do
     {
         RKH_EVT_T *e = rkh_sma_get((RKH_SMA_T *)arg);
         rkh_sm_dispatch((RKH_SM_T *)arg, e);
         RKH_FWK_GC(e, arg);
+        RKH_SMA_SCRATCH_RESET(arg);
     }
     while (((RKH_SMA_T *)arg)->thread != (HANDLE)0);
 
@@ -171,6 +185,60 @@ rkh_sma_block(RKH_SMA_T *const me)
     }
 }
 
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+rbool_t
+rkh_sma_blockFull(RKH_SMA_T *const me, rui32_t tout)
+{
+    while (me->equeue.qty >= me->equeue.nelems)
+    {
+        if (tout == 0)
+        {
+            return RKH_FALSE;
+        }
+        --tout;
+        rkhport_exit_critical();
+        Sleep(tick_msec);                   /* wait for the consumer */
+        rkhport_enter_critical();
+    }
+    return RKH_TRUE;
+}
+#endif
+
+#if RKH_CFG_MP_MAG_EN == RKH_ENABLED
+rui8_t
+rkh_memPool_getMagSlot(void)
+{
+    DWORD_PTR slot;
+
+    slot = (DWORD_PTR)TlsGetValue(magSlot);
+    return (slot == 0) ? (rui8_t)RKH_MP_NO_MAG : (rui8_t)(slot - 1);
+}
+#endif
+
+#if RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED
+rui8_t
+rkh_fwk_getAffinity(void)
+{
+    DWORD_PTR slot;
+
+    /* the local event pools are bound to the priority of the AO */
+    slot = (DWORD_PTR)TlsGetValue(magSlot);
+    return (slot == 0) ? (rui8_t)RKH_EVT_NO_AFFINITY : (rui8_t)(slot - 1);
+}
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+rui8_t
+rkh_trc_getLane(void)
+{
+    DWORD_PTR slot;
+
+    /* each active object writes its trace records into its own lane */
+    slot = (DWORD_PTR)TlsGetValue(magSlot);
+    return (slot == 0) ? (rui8_t)RKH_TRC_NO_LANE : (rui8_t)(slot - 1);
+}
+#endif
+
 void
 rkh_sma_setReady(RKH_SMA_T *const me)
 {
@@ -187,6 +255,12 @@ void
 rkh_fwk_init(void)
 {
     InitializeCriticalSection(&csection);
+#if ((RKH_CFG_MP_MAG_EN == RKH_ENABLED) || \
+     (RKH_CFG_FWK_EVT_AFFINITY_EN == RKH_ENABLED) || \
+     (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED))
+    magSlot = TlsAlloc();
+    RKH_ASSERT(magSlot != TLS_OUT_OF_INDEXES);
+#endif
 }
 
 void
@@ -76,6 +76,9 @@ extern "C" {
 #define RKH_ENTER_CRITICAL(dummy)         rkhport_enter_critical()
 #define RKH_EXIT_CRITICAL(dummy)          rkhport_exit_critical()
 
+/* Orders the accesses to the trace lanes, see RKH_CFG_TRC_LOCAL_EN */
+#define RKH_TRC_MEMBAR()                  MemoryBarrier()
+
 /* ------------------------------- Constants ------------------------------- */
 /**
  *	If the #RKH_CFGPORT_SMA_THREAD_EN is set to 1,
@@ -166,6 +166,7 @@ rkh_fwk_enter(void)
             e = rkh_sma_get(sma);
             RKH_SMA_DISPATCH(sma, e);
             RKH_FWK_GC(e, sma);
+            RKH_SMA_SCRATCH_RESET(sma);
         }
         else
         {
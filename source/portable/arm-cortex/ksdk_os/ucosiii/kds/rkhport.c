@@ -287,7 +287,7 @@ rkh_sma_post_fifo(RKH_SMA_T *sma, const RKH_EVT_T *e)
     status = OSA_MsgQPut(&sma->equeue,                 /* event queue object */
                          (void *)&e);                 /* actual event posted */
     RKH_ALLEGE(status == kStatus_OSA_Success);
-    RKH_TR_SMA_FIFO(sma, e, sender, e->pool, e->nref, 
+    RKH_TR_SMA_FIFO(sma, e, sender, RKH_EVT_POOL_ID(e), e->nref, 
                         &sma->equeue.queue.MsgQ.NbrEntries, 0);
 
     RKH_EXIT_CRITICAL_();
@@ -313,7 +313,7 @@ rkh_sma_post_lifo(RKH_SMA_T *sma, const RKH_EVT_T *e)
     status = OSA_MsgQPutLifo(&sma->equeue,             /* event queue object */
                              (void *)&e);              /* actual event posted */
     RKH_ALLEGE(status == kStatus_OSA_Success);
-    RKH_TR_SMA_LIFO(sma, e, sender, e->pool, e->nref, 
+    RKH_TR_SMA_LIFO(sma, e, sender, RKH_EVT_POOL_ID(e), e->nref, 
                         &sma->equeue.queue.MsgQ.NbrEntries, 0);
 
     RKH_EXIT_CRITICAL_();
@@ -336,7 +336,7 @@ rkh_sma_get(RKH_SMA_T *sma)
     /* a race condition */
     /* Morever, OSA abstraction layer not implements the water mark in */
     /* the queue */
-    RKH_TR_SMA_GET(sma, e, e->pool, e->nref,
+    RKH_TR_SMA_GET(sma, e, RKH_EVT_POOL_ID(e), e->nref,
                         &sma->equeue.queue.MsgQ.NbrEntries, 0);
     return e;
 }
@@ -64,6 +64,13 @@ typedef unsigned char 	rui8_t;
 typedef unsigned short 	rui16_t;
 typedef unsigned long	rui32_t;
 
+/*
+ *  Only used by the 64 bits trace timestamp, see 
+ *  RKH_CFGPORT_TRC_SIZEOF_TSTAMP.
+ */
+
+__extension__ typedef unsigned long long rui64_t;
+
 /*
  * 	The 'ruint' and 'rInt' will normally be the natural size for a 
  * 	particular machine. These types designates an integer type that is 
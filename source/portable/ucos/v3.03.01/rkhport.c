@@ -233,7 +233,7 @@ rkh_sma_post_fifo(RKH_SMA_T *sma, const RKH_EVT_T *e)
             OS_OPT_POST_FIFO + OS_OPT_POST_NO_SCHED,
             &err);                          /* received error code */
     RKH_ALLEGE(err == OS_ERR_NONE);
-    RKH_TR_SMA_FIFO(sma, e, sender, e->pool, e->nref,
+    RKH_TR_SMA_FIFO(sma, e, sender, RKH_EVT_POOL_ID(e), e->nref,
                     &sma->equeue.MsgQ.NbrEntries,
                     &sma->equeue.MsgQ.NbrEntriesSize -
                     &sma->equeue.MsgQ.NbrEntriesMax);
@@ -265,7 +265,7 @@ rkh_sma_post_lifo(RKH_SMA_T *sma, const RKH_EVT_T *e)
             OS_OPT_POST_LIFO + OS_OPT_POST_NO_SCHED,
             &err);                          /* received error code */
     RKH_ALLEGE(err == OS_ERR_NONE);
-    RKH_TR_SMA_LIFO(sma, e, sender, e->pool, e->nref,
+    RKH_TR_SMA_LIFO(sma, e, sender, RKH_EVT_POOL_ID(e), e->nref,
                     &sma->equeue.MsgQ.NbrEntries,
                     &sma->equeue.MsgQ.NbrEntriesSize -
                     &sma->equeue.MsgQ.NbrEntriesMax);
@@ -292,7 +292,7 @@ rkh_sma_get(RKH_SMA_T *sma)
     /* minimum number of free elements is not a reliable manner in uC/OS */
     /* Because the variables are obtained outside critical section could be */
     /* a race condition */
-    RKH_TR_SMA_GET(sma, e, e->pool, e->nref,
+    RKH_TR_SMA_GET(sma, e, RKH_EVT_POOL_ID(e), e->nref,
                    &sma->equeue.MsgQ.NbrEntries,
                    &sma->equeue.MsgQ.NbrEntriesSize -
                    &sma->equeue.MsgQ.NbrEntriesMax);
@@ -112,6 +112,51 @@ typedef enum
     RKH_QUE_OK, RKH_QUE_EMPTY, RKH_QUE_FULL
 } RKH_QUECODE_T;
 
+/**
+ *  \brief
+ *  Overflow policies, i.e. what a queue does when an element is put on it 
+ *  while it is full. See rkh_queue_setOverflow() function.
+ */
+typedef enum
+{
+    /**
+     *  Raises an assertion. It is the default policy.
+     */
+    RKH_QUE_OVF_ASSERT,
+
+    /**
+     *  The element being put is discarded.
+     */
+    RKH_QUE_OVF_DROP_NEWEST,
+
+    /**
+     *  The element at the head of the queue, i.e. the next one to be 
+     *  retrieved, is evicted to make room for the new one.
+     */
+    RKH_QUE_OVF_DROP_OLDEST,
+
+    /**
+     *  The producer is blocked until the queue has room or the timeout 
+     *  expires, in which case the element being put is discarded. It is 
+     *  only supported by multi-thread ports, otherwise it behaves as 
+     *  RKH_QUE_OVF_DROP_NEWEST.
+     */
+    RKH_QUE_OVF_BLOCK
+} RKH_QUEOVF_T;
+
+struct RKH_QUEUE_T;
+
+/**
+ *  \brief
+ *  Callback invoked when the number of elements in a queue crosses one of 
+ *  its watermarks. It is called from within a critical section, thus it 
+ *  must be short and must not block.
+ *
+ *  \param[in] q		pointer to the queue.
+ *  \param[in] qty		number of elements currently in the queue.
+ */
+typedef void (*RKHQueueWmark)(struct RKH_QUEUE_T *q, RKH_QUENE_T qty);
+
 /**
  *  \brief
  *  Defines the data structure into which the performance information for
@@ -130,6 +175,14 @@ typedef struct RKH_QINFO_T
     rui16_t nreads;     /*	# of queue read requests */
     rui16_t nempty;     /*	# of queue empty retrieves */
     rui16_t nfull;      /*	# of queue full retrieves */
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    rui16_t ndropNew;   /*	# of elements discarded by drop-newest */
+    rui16_t ndropOld;   /*	# of elements evicted by drop-oldest */
+    rui16_t nblock;     /*	# of times a producer was blocked */
+    rui16_t ntout;      /*	# of blocked puts that timed out */
+    rui16_t nhwm;       /*	# of times the high-watermark was reached */
+    rui16_t nlwm;       /*	# of times the low-watermark was reached */
+#endif
 } RKH_QUEI_T;
 
 /**
@@ -224,6 +277,84 @@ typedef struct RKH_QUEUE_T
     RKH_QUENE_T nmin;
 #endif
 
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    /**
+     *  \brief
+     *  Overflow policy. See RKH_QUEOVF_T.
+     */
+    rui8_t ovf;
+
+    /**
+     *  \brief
+     *  Maximum number of ticks a producer is blocked on a full queue when 
+     *  the RKH_QUE_OVF_BLOCK policy is used.
+     */
+    rui32_t tout;
+
+    /**
+     *  \brief
+     *  Element discarded or evicted by the last put operation, or NULL. 
+     *  The producer must take it by means of rkh_queue_takeEvicted() to 
+     *  release it.
+     */
+    const void *evicted;
+
+    /**
+     *  \brief
+     *  Number of elements that signals the high-watermark. Zero disables 
+     *  the watermarks.
+     */
+    RKH_QUENE_T hwm;
+
+    /**
+     *  \brief
+     *  Number of elements that signals the low-watermark, once the 
+     *  high-watermark has been reached.
+     */
+    RKH_QUENE_T lwm;
+
+    /**
+     *  \brief
+     *  RKH_TRUE from the high-watermark is reached until the queue drains 
+     *  down to the low-watermark.
+     */
+    rui8_t above;
+
+    /**
+     *  \brief
+     *  High-watermark callback, used to apply backpressure on producers.
+     */
+    RKHQueueWmark hwmCb;
+
+    /**
+     *  \brief
+     *  Low-watermark callback, used to release the backpressure.
+     */
+    RKHQueueWmark lwmCb;
+
+    /**
+     *  \brief
+     *  Controller SMA (a.k.a Active Object) notified by means of \a hwmEvt 
+     *  and \a lwmEvt events when the watermarks are crossed, or NULL.
+     */
+    const struct RKH_SMA_T *ctrl;
+
+    /**
+     *  \brief
+     *  Events posted to \a ctrl when the high and low watermarks are 
+     *  crossed respectively.
+     */
+    const void *hwmEvt;
+    const void *lwmEvt;
+
+    /**
+     *  \brief
+     *  Watermark notification not yet posted to \a ctrl, or NULL. See 
+     *  rkh_queue_takeWmark().
+     */
+    const void *wmEvt;
+#endif
+
     /**
      *  \brief
      *  Performance information. This member is optional, thus it could be
@@ -340,7 +471,8 @@ void *rkh_queue_get(RKH_QUEUE_T *q);
  *  This function must be invoked within a critical section.
  *  \note
  *  The function raises an assertion if the queue becomes full and cannot
- *  accept the element.
+ *  accept the element, unless other overflow policy has been set by 
+ *  means of rkh_queue_setOverflow().
  *
  *  \ingroup apiQueue 
  */
@@ -359,7 +491,8 @@ void rkh_queue_put_fifo(RKH_QUEUE_T *q, const void *pe);
  *  This function must be invoked within a critical section.
  *  \note
  *  The function raises an assertion if the queue becomes full and cannot
- *  accept the element.
+ *  accept the element, unless other overflow policy has been set by 
+ *  means of rkh_queue_setOverflow().
  *  \note
  *  This function is optional, thus it could be eliminated in compile-time
  *  with RKH_CFG_QUE_PUT_LIFO_EN.
@@ -451,6 +584,143 @@ void rkh_queue_get_info(RKH_QUEUE_T *q, RKH_QUEI_T *pqi);
  */
 void rkh_queue_clear_info(RKH_QUEUE_T *q);
 
+/**
+ *  \brief
+ *  Sets the overflow policy of a queue, that is what a put operation does 
+ *  when the queue is full.
+ *
+ *  \param[in] q		pointer to previously created queue.
+ *  \param[in] policy	overflow policy. See RKH_QUEOVF_T.
+ *  \param[in] tout		maximum number of ticks a producer is blocked when
+ *                      \a policy is RKH_QUE_OVF_BLOCK. Otherwise it is 
+ *                      ignored.
+ *
+ *  \note
+ *  A discarded or evicted element is not lost, the producer must take it 
+ *  by means of rkh_queue_takeEvicted() to release it. The native event 
+ *  queue of an active object does it automatically, recycling the 
+ *  dynamic events.
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_QUE_OVF_POLICY_EN.
+ *
+ *  \ingroup apiQueue 
+ */
+void rkh_queue_setOverflow(RKH_QUEUE_T *q, RKH_QUEOVF_T policy, 
+                           rui32_t tout);
+
+/**
+ *  \brief
+ *  Sets the high-watermark of a queue. When a put operation makes the 
+ *  number of elements reach \a hwm the callback \a cb is invoked, thus 
+ *  the application could apply backpressure on the producers. It is not 
+ *  invoked again until the queue drains down to its low-watermark.
+ *
+ *  \param[in] q		pointer to previously created queue.
+ *  \param[in] hwm		number of elements that triggers the callback. It 
+ *                      must be greater than zero and less than or equal 
+ *                      to the queue size.
+ *  \param[in] cb		callback function. NULL disables it.
+ *
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_QUE_OVF_POLICY_EN.
+ *
+ *  \ingroup apiQueue 
+ */
+void rkh_queue_setHighWmark(RKH_QUEUE_T *q, RKH_QUENE_T hwm, 
+                            RKHQueueWmark cb);
+
+/**
+ *  \brief
+ *  Sets the low-watermark of a queue. When the high-watermark has been 
+ *  reached and a get operation makes the number of elements drop to 
+ *  \a lwm the callback \a cb is invoked, thus the application could 
+ *  release the backpressure on the producers. The gap between both 
+ *  watermarks provides hysteresis.
+ *
+ *  \param[in] q		pointer to previously created queue.
+ *  \param[in] lwm		number of elements that triggers the callback. It 
+ *                      must be less than the high-watermark. Default is 
+ *                      zero, i.e. the queue becomes empty.
+ *  \param[in] cb		callback function. NULL disables it.
+ *
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_QUE_OVF_POLICY_EN.
+ *
+ *  \ingroup apiQueue 
+ */
+void rkh_queue_setLowWmark(RKH_QUEUE_T *q, RKH_QUENE_T lwm, 
+                           RKHQueueWmark cb);
+
+/**
+ *  \brief
+ *  Registers a controller SMA (a.k.a Active Object) that receives an event 
+ *  every time the queue crosses one of its watermarks, thus upstream 
+ *  producers could be throttled before the queue becomes full.
+ *
+ *  \param[in] q		pointer to previously created queue.
+ *  \param[in] ctrl		pointer to controller SMA. NULL disables the 
+ *                      notifications.
+ *  \param[in] hwmEvt	event posted when the high-watermark is reached. 
+ *                      It should be a static event.
+ *  \param[in] lwmEvt	event posted when the low-watermark is reached. 
+ *                      It should be a static event.
+ *
+ *  \note
+ *  The notifications are posted by the SMA services once the critical 
+ *  section of the queue operation is left. See rkh_queue_takeWmark().
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_QUE_OVF_POLICY_EN.
+ *
+ *  \ingroup apiQueue 
+ */
+void rkh_queue_setWmarkCtrl(RKH_QUEUE_T *q, const struct RKH_SMA_T *ctrl,
+                            const void *hwmEvt, const void *lwmEvt);
+
+/**
+ *  \brief
+ *  Takes the watermark notification pending to be posted to the 
+ *  controller SMA of the queue.
+ *
+ *  \param[in] q		pointer to previously created queue.
+ *
+ *  \return
+ *  Pointer to the notification event, or NULL if there is not one.
+ *
+ *  \note
+ *  This function must be invoked within a critical section.
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_QUE_OVF_POLICY_EN.
+ *
+ *  \ingroup apiQueue 
+ */
+const void *rkh_queue_takeWmark(RKH_QUEUE_T *q);
+
+/**
+ *  \brief
+ *  Takes the element discarded or evicted by the last put operation on the 
+ *  queue, according to its overflow policy.
+ *
+ *  \param[in] q		pointer to previously created queue.
+ *
+ *  \return
+ *  Pointer to the discarded element, or NULL if there is not one.
+ *
+ *  \note
+ *  This function must be invoked within the same critical section of the 
+ *  put operation.
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_QUE_OVF_POLICY_EN.
+ *
+ *  \ingroup apiQueue 
+ */
+const void *rkh_queue_takeEvicted(RKH_QUEUE_T *q);
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
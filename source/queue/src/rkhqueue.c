@@ -69,12 +69,40 @@ RKH_MODULE_NAME(rkhqueue)
     #define RKH_IUPDT_EMPTY(q)        ++ q->rqi.nempty
     #define RKH_IUPDT_FULL(q)         ++ q->rqi.nfull
     #define RKH_IUPDT_READ(q)         ++ q->rqi.nreads
+    #define RKH_IUPDT_DROPNEW(q)      ++ q->rqi.ndropNew
+    #define RKH_IUPDT_DROPOLD(q)      ++ q->rqi.ndropOld
+    #define RKH_IUPDT_BLOCK(q)        ++ q->rqi.nblock
+    #define RKH_IUPDT_TOUT(q)         ++ q->rqi.ntout
+    #define RKH_IUPDT_HWM(q)          ++ q->rqi.nhwm
+    #define RKH_IUPDT_LWM(q)          ++ q->rqi.nlwm
 #else
     #define RKH_IUPDT_PUT(q)
     #define RKH_IUPDT_GET(q)
     #define RKH_IUPDT_EMPTY(q)
     #define RKH_IUPDT_FULL(q)
     #define RKH_IUPDT_READ(q)
+    #define RKH_IUPDT_DROPNEW(q)
+    #define RKH_IUPDT_DROPOLD(q)
+    #define RKH_IUPDT_BLOCK(q)
+    #define RKH_IUPDT_TOUT(q)
+    #define RKH_IUPDT_HWM(q)
+    #define RKH_IUPDT_LWM(q)
+#endif
+
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    #define RKH_QUE_CHK_HWM(q) \
+        if ((q->hwm != 0) && (q->above == RKH_FALSE) && (q->qty >= q->hwm)) \
+        { \
+            crossWmark(q, RKH_TRUE); \
+        }
+    #define RKH_QUE_CHK_LWM(q) \
+        if ((q->above == RKH_TRUE) && (q->qty <= q->lwm)) \
+        { \
+            crossWmark(q, RKH_FALSE); \
+        }
+#else
+    #define RKH_QUE_CHK_HWM(q)
+    #define RKH_QUE_CHK_LWM(q)
 #endif
 
 /* ------------------------------- Constants ------------------------------- */
@@ -93,8 +121,100 @@ static void (*cbRKHSmaSetReady)(RKH_SMA_T *const me) = &rkh_sma_setReady;
 static void (*cbRKHSmaSetUnready)(RKH_SMA_T *const me) = &rkh_sma_setUnready;
 #endif
 
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+#if ((RKH_CFGPORT_SMA_THREAD_EN == RKH_ENABLED) && \
+     (RKH_CFGPORT_NATIVE_EQUEUE_EN == RKH_ENABLED))
+static rbool_t (*cbRKHSmaBlockFull)(RKH_SMA_T *const me, rui32_t tout) = 
+                                                        &rkh_sma_blockFull;
+#else
+static rbool_t (*cbRKHSmaBlockFull)(RKH_SMA_T *const me, rui32_t tout);
+#endif
+#endif
+
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+/*
+ *  Notifies that a queue has crossed its high (up) or low (down) 
+ *  watermark. The event for the controller SMA is left pending, it is 
+ *  posted outside of the critical section.
+ */
+static void
+crossWmark(RKH_QUEUE_T *q, rbool_t up)
+{
+    RKHQueueWmark cb;
+
+    q->above = (rui8_t)up;
+    if (up == RKH_TRUE)
+    {
+        RKH_IUPDT_HWM(q);
+        cb = q->hwmCb;
+        q->wmEvt = q->hwmEvt;
+    }
+    else
+    {
+        RKH_IUPDT_LWM(q);
+        cb = q->lwmCb;
+        q->wmEvt = q->lwmEvt;
+    }
+
+    if (q->ctrl == CSMA(0))
+    {
+        q->wmEvt = (const void *)0;
+    }
+
+    if (cb != (RKHQueueWmark)0)
+    {
+        (*cb)(q, q->qty);
+    }
+}
+
+/*
+ *  Applies the overflow policy of a full queue. Returns RKH_TRUE if the 
+ *  queue has room for the element being put, otherwise it is discarded.
+ */
+static rbool_t
+overflow(RKH_QUEUE_T *q, const void *pe)
+{
+    RKH_IUPDT_FULL(q);
+    RKH_TR_QUE_FULL(q);
+
+    switch (q->ovf)
+    {
+        case RKH_QUE_OVF_DROP_OLDEST:
+            q->evicted = *q->pout++;
+            --q->qty;
+            if (q->pout == q->pend)
+            {
+                q->pout = (void * *)q->pstart;
+            }
+            RKH_IUPDT_DROPOLD(q);
+            return RKH_TRUE;
+        case RKH_QUE_OVF_BLOCK:
+            if ((q->sma != CSMA(0)) && (cbRKHSmaBlockFull != 0))
+            {
+                RKH_IUPDT_BLOCK(q);
+                if ((*cbRKHSmaBlockFull)((RKH_SMA_T *)(q->sma), q->tout) &&
+                    (q->qty < q->nelems))
+                {
+                    return RKH_TRUE;
+                }
+                RKH_IUPDT_TOUT(q);
+            }
+            q->evicted = pe;
+            RKH_IUPDT_DROPNEW(q);
+            return RKH_FALSE;
+        case RKH_QUE_OVF_DROP_NEWEST:
+            q->evicted = pe;
+            RKH_IUPDT_DROPNEW(q);
+            return RKH_FALSE;
+        default:
+            RKH_ASSERT(0);
+            return RKH_FALSE;
+    }
+}
+#endif
+
 /* ---------------------------- Global functions --------------------------- */
 void
 rkh_queue_init(RKH_QUEUE_T *q, const void * *sstart, RKH_QUENE_T ssize,
@@ -114,6 +234,21 @@ rkh_queue_init(RKH_QUEUE_T *q, const void * *sstart, RKH_QUENE_T ssize,
 #if RKH_CFG_QUE_GET_INFO_EN == RKH_ENABLED
     q->rqi.nputs = q->rqi.ngets = q->rqi.nreads = q->rqi.nempty = 
                                                   q->rqi.nfull = 0;
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    q->rqi.ndropNew = q->rqi.ndropOld = q->rqi.nblock = q->rqi.ntout = 
+                                                        q->rqi.nhwm = 
+                                                        q->rqi.nlwm = 0;
+#endif
+#endif
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    q->ovf = RKH_QUE_OVF_ASSERT;
+    q->tout = 0;
+    q->evicted = (const void *)0;
+    q->hwm = q->lwm = 0;
+    q->above = RKH_FALSE;
+    q->hwmCb = q->lwmCb = (RKHQueueWmark)0;
+    q->ctrl = CSMA(0);
+    q->hwmEvt = q->lwmEvt = q->wmEvt = (const void *)0;
 #endif
     RKH_TR_QUE_INIT(q, (const struct RKH_SMA_T *)sma, ssize);
 }
@@ -198,6 +333,7 @@ rkh_queue_get(RKH_QUEUE_T *q)
     }
 
     RKH_IUPDT_GET(q);
+    RKH_QUE_CHK_LWM(q);
 
     if ((q->sma != CSMA(0)) && (q->qty == 0))
     {
@@ -220,6 +356,14 @@ rkh_queue_put_fifo(RKH_QUEUE_T *q, const void *pe)
 
     RKH_ASSERT(q != CQ(0) && pe != (const void *)0);
     /*RKH_ENTER_CRITICAL_();*/
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    q->evicted = (const void *)0;
+    if ((q->qty >= q->nelems) && (overflow(q, pe) == RKH_FALSE))
+    {
+        /*RKH_EXIT_CRITICAL_();*/
+        return;
+    }
+#else
     RKH_ASSERT(q->qty < q->nelems);
 
     if (q->qty >= q->nelems)
@@ -229,6 +373,7 @@ rkh_queue_put_fifo(RKH_QUEUE_T *q, const void *pe)
         /*RKH_EXIT_CRITICAL_();*/
         return;
     }
+#endif
 
     *q->pin++ = (char *)pe;
     ++q->qty;
@@ -250,6 +395,7 @@ rkh_queue_put_fifo(RKH_QUEUE_T *q, const void *pe)
     }
 #endif
     RKH_IUPDT_PUT(q);
+    RKH_QUE_CHK_HWM(q);
     /*RKH_EXIT_CRITICAL_();*/
     RKH_TR_QUE_FIFO(q, q->qty, q->nmin);
 }
@@ -262,6 +408,14 @@ rkh_queue_put_lifo(RKH_QUEUE_T *q, const void *pe)
 
     RKH_ASSERT(q != CQ(0) && pe != (const void *)0);
     /*RKH_ENTER_CRITICAL_();*/
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    q->evicted = (const void *)0;
+    if ((q->qty >= q->nelems) && (overflow(q, pe) == RKH_FALSE))
+    {
+        /*RKH_EXIT_CRITICAL_();*/
+        return;
+    }
+#else
     RKH_ASSERT(q->qty < q->nelems);
 
     if (q->qty >= q->nelems)
@@ -271,6 +425,7 @@ rkh_queue_put_lifo(RKH_QUEUE_T *q, const void *pe)
         /*RKH_EXIT_CRITICAL_();*/
         return;
     }
+#endif
 
     if (q->pout == (void * *)q->pstart)
     {
@@ -294,6 +449,7 @@ rkh_queue_put_lifo(RKH_QUEUE_T *q, const void *pe)
         q->nmin = (RKH_QUENE_T)(q->nelems - q->qty);
     }
 #endif
+    RKH_QUE_CHK_HWM(q);
     /*RKH_EXIT_CRITICAL_();*/
     RKH_TR_QUE_LIFO(q, q->qty, q->nmin);
 }
@@ -303,18 +459,36 @@ rkh_queue_put_lifo(RKH_QUEUE_T *q, const void *pe)
 void
 rkh_queue_deplete(RKH_QUEUE_T *q)
 {
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    const RKH_EVT_T *wmEvt;
+    RKH_SMA_T *ctrl;
+#endif
     RKH_SR_ALLOC();
 
     RKH_ASSERT(q != CQ(0));
     RKH_ENTER_CRITICAL_();
     q->qty = 0;
     q->pin = q->pout = (void * *)q->pstart;
+    RKH_QUE_CHK_LWM(q);
     if (q->sma != CSMA(0))
     {
         cbRKHSmaSetUnready((RKH_SMA_T *)(q->sma));
     }
     RKH_TR_QUE_DPT(q);
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    wmEvt = (const RKH_EVT_T *)rkh_queue_takeWmark(q);
+    ctrl = (RKH_SMA_T *)(q->ctrl);
+#endif
     RKH_EXIT_CRITICAL_();
+
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    /* an emptied queue is below its low-watermark, thus its controller */
+    /* is notified once the critical section is left */
+    if (wmEvt != (const RKH_EVT_T *)0)
+    {
+        RKH_SMA_POST_FIFO(ctrl, wmEvt, q);
+    }
+#endif
 }
 #endif
 
@@ -363,8 +537,97 @@ rkh_queue_clear_info(RKH_QUEUE_T *q)
 
     RKH_ENTER_CRITICAL_();
     prqi->nputs = prqi->ngets = prqi->nreads = prqi->nempty = prqi->nfull = 0;
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    prqi->ndropNew = prqi->ndropOld = prqi->nblock = prqi->ntout = 
+                                                     prqi->nhwm = 
+                                                     prqi->nlwm = 0;
+#endif
+    RKH_EXIT_CRITICAL_();
+}
+#endif
+
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+void
+rkh_queue_setOverflow(RKH_QUEUE_T *q, RKH_QUEOVF_T policy, rui32_t tout)
+{
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((q != CQ(0)) && (policy <= RKH_QUE_OVF_BLOCK));
+
+    RKH_ENTER_CRITICAL_();
+    q->ovf = (rui8_t)policy;
+    q->tout = tout;
+    RKH_EXIT_CRITICAL_();
+}
+
+void
+rkh_queue_setHighWmark(RKH_QUEUE_T *q, RKH_QUENE_T hwm, RKHQueueWmark cb)
+{
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((q != CQ(0)) && (hwm != 0) && (hwm <= q->nelems) &&
+                (hwm > q->lwm));
+
+    RKH_ENTER_CRITICAL_();
+    q->hwm = hwm;
+    q->hwmCb = cb;
+    RKH_EXIT_CRITICAL_();
+}
+
+void
+rkh_queue_setLowWmark(RKH_QUEUE_T *q, RKH_QUENE_T lwm, RKHQueueWmark cb)
+{
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((q != CQ(0)) && (lwm < q->nelems) &&
+                ((q->hwm == 0) || (lwm < q->hwm)));
+
+    RKH_ENTER_CRITICAL_();
+    q->lwm = lwm;
+    q->lwmCb = cb;
     RKH_EXIT_CRITICAL_();
 }
+
+void
+rkh_queue_setWmarkCtrl(RKH_QUEUE_T *q, const struct RKH_SMA_T *ctrl,
+                       const void *hwmEvt, const void *lwmEvt)
+{
+    RKH_SR_ALLOC();
+
+    RKH_REQUIRE((q != CQ(0)) && 
+                ((ctrl == CSMA(0)) || 
+                 ((hwmEvt != (const void *)0) && 
+                  (lwmEvt != (const void *)0))));
+
+    RKH_ENTER_CRITICAL_();
+    q->ctrl = ctrl;
+    q->hwmEvt = hwmEvt;
+    q->lwmEvt = lwmEvt;
+    q->wmEvt = (const void *)0;
+    RKH_EXIT_CRITICAL_();
+}
+
+const void *
+rkh_queue_takeWmark(RKH_QUEUE_T *q)
+{
+    const void *pe;
+
+    RKH_ASSERT(q != CQ(0));
+    pe = q->wmEvt;
+    q->wmEvt = (const void *)0;
+    return pe;
+}
+
+const void *
+rkh_queue_takeEvicted(RKH_QUEUE_T *q)
+{
+    const void *pe;
+
+    RKH_ASSERT(q != CQ(0));
+    pe = q->evicted;
+    q->evicted = (const void *)0;
+    return pe;
+}
 #endif
 
 #endif
@@ -0,0 +1,428 @@
+/*
+ *  --------------------------------------------------------------------------
+ *
+ *                                Framework RKH
+ *                                -------------
+ *
+ *            State-machine framework for reactive embedded systems
+ *
+ *                      Copyright (C) 2010 Leandro Francucci.
+ *          All rights reserved. Protected by international copyright laws.
+ *
+ *
+ *  RKH is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Recycle Software
+ *  Foundation, either version 3 of the License, or (at your option) any
+ *  later version.
+ *
+ *  RKH is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ *  more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with RKH, see copying.txt file.
+ *
+ *  Contact information:
+ *  RKH site: http://vortexmakes.com/que-es/
+ *  RKH GitHub: https://github.com/vortexmakes/RKH
+ *  RKH Sourceforge: https://sourceforge.net/projects/rkh-reactivesys/
+ *  e-mail: lf@vortexmakes.com
+ *  ---------------------------------------------------------------------------
+ */
+
+/**
+ *  \file       test_rkhqueue.c
+ *  \ingroup    test_queue
+ *  \brief      Unit test for queue module.
+ *
+ *  \addtogroup test
+ *  @{
+ *  \addtogroup test_queue Queue
+ *  @{
+ *  \brief      Unit test for queue module.
+ */
+
+/* -------------------------- Development history -------------------------- */
+/*
+ *  2026.10.17  agnt  v3.2.03  Initial version
+ */
+
+/* -------------------------------- Authors -------------------------------- */
+/*
+ *  agnt  agent  agent@local
+ */
+
+/* --------------------------------- Notes --------------------------------- */
+/* ----------------------------- Include files ----------------------------- */
+#include "unity.h"
+#include "rkhqueue.h"
+#include "Mock_rkhassert.h"
+#include "Mock_rkhsma_sync.h"
+#include "Mock_rkhport.h"
+#include "Mock_rkhtrc_record.h"
+#include "Mock_rkhtrc_filter.h"
+
+/* ----------------------------- Local macros ------------------------------ */
+#define QUEUE_SIZE      4
+
+/* ------------------------------- Constants ------------------------------- */
+/* ---------------------------- Local data types --------------------------- */
+/* ---------------------------- Global variables --------------------------- */
+/* ---------------------------- Local variables ---------------------------- */
+static RKH_QUEUE_T queue;
+static const void *queueSto[QUEUE_SIZE];
+static int elems[QUEUE_SIZE + 1];
+static RKH_SMA_T ao;
+static RKH_SMA_T ctrl;
+static RKHSmaVtbl ctrlVtbl;
+static RKH_EVT_T hwmEvt, lwmEvt;
+static const RKH_EVT_T *ctrlPosted;
+static int nHwm, nLwm;
+
+/* ----------------------- Local function prototypes ----------------------- */
+/* ---------------------------- Local functions ---------------------------- */
+static void
+MockAssertCallback(const char* const file, int line, int cmock_num_calls)
+{
+    TEST_PASS();
+}
+
+static rbool_t
+MockBlockFullCallback(RKH_SMA_T *const me, rui32_t tout, int cmock_num_calls)
+{
+    /* the consumer takes the oldest element while the producer waits */
+    (void)rkh_queue_get(&queue);
+    return RKH_TRUE;
+}
+
+static void
+hwmCb(RKH_QUEUE_T *q, RKH_QUENE_T qty)
+{
+    ++nHwm;
+    TEST_ASSERT_EQUAL(3, qty);
+}
+
+static void
+lwmCb(RKH_QUEUE_T *q, RKH_QUENE_T qty)
+{
+    ++nLwm;
+}
+
+static void
+ctrlPostFifo(RKH_SMA_T *me, const RKH_EVT_T *e, const void *const sender)
+{
+    TEST_ASSERT_EQUAL_PTR(&ctrl, me);
+    ctrlPosted = e;
+}
+
+static void
+fill(void)
+{
+    int i;
+
+    for (i = 0; i < QUEUE_SIZE; ++i)
+    {
+        rkh_queue_put_fifo(&queue, &elems[i]);
+    }
+}
+
+/* ---------------------------- Global functions --------------------------- */
+void
+setUp(void)
+{
+    Mock_rkhassert_Init();
+    Mock_rkhsma_sync_Init();
+    Mock_rkhport_Init();
+    rkh_enter_critical_Ignore();
+    rkh_exit_critical_Ignore();
+    rkh_trc_isoff__IgnoreAndReturn(RKH_FALSE);
+    rkh_queue_init(&queue, queueSto, QUEUE_SIZE, (void *)0);
+    ctrlVtbl.post_fifo = ctrlPostFifo;
+    ctrl.vptr = &ctrlVtbl;
+    ctrlPosted = (const RKH_EVT_T *)0;
+    nHwm = nLwm = 0;
+}
+
+void
+tearDown(void)
+{
+    Mock_rkhassert_Verify();
+    Mock_rkhsma_sync_Verify();
+    Mock_rkhport_Verify();
+    Mock_rkhassert_Destroy();
+    Mock_rkhsma_sync_Destroy();
+    Mock_rkhport_Destroy();
+}
+
+/**
+ *  \addtogroup test_overflow Test cases of queue overflow policy group
+ *  @{
+ *  \name Test cases of queue overflow policy group
+ *  @{
+ */
+void
+test_DefaultPolicyRaisesAssertionOnFullQueue(void)
+{
+    rkh_assert_Expect("rkhqueue", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    fill();
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+    TEST_FAIL();
+}
+
+void
+test_Fails_SetWrongOverflowPolicy(void)
+{
+    rkh_assert_Expect("rkhqueue", 0);
+    rkh_assert_IgnoreArg_file();
+    rkh_assert_IgnoreArg_line();
+    rkh_assert_StubWithCallback(MockAssertCallback);
+
+    rkh_queue_setOverflow(&queue, (RKH_QUEOVF_T)(RKH_QUE_OVF_BLOCK + 1), 0);
+    TEST_FAIL();
+}
+
+void
+test_DropNewestDiscardsTheElementBeingPut(void)
+{
+    RKH_QUEI_T info;
+    int i;
+
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_DROP_NEWEST, 0);
+    fill();
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+
+    TEST_ASSERT_EQUAL_PTR(&elems[QUEUE_SIZE], rkh_queue_takeEvicted(&queue));
+    TEST_ASSERT_NULL(rkh_queue_takeEvicted(&queue));
+    TEST_ASSERT_EQUAL(QUEUE_SIZE, queue.qty);
+    for (i = 0; i < QUEUE_SIZE; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR(&elems[i], rkh_queue_get(&queue));
+    }
+
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(1, info.nfull);
+    TEST_ASSERT_EQUAL(1, info.ndropNew);
+    TEST_ASSERT_EQUAL(0, info.ndropOld);
+    TEST_ASSERT_EQUAL(QUEUE_SIZE, info.nputs);
+}
+
+void
+test_DropOldestEvictsTheHeadOfQueue(void)
+{
+    RKH_QUEI_T info;
+    int i;
+
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_DROP_OLDEST, 0);
+    fill();
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+
+    TEST_ASSERT_EQUAL_PTR(&elems[0], rkh_queue_takeEvicted(&queue));
+    TEST_ASSERT_EQUAL(QUEUE_SIZE, queue.qty);
+    for (i = 1; i <= QUEUE_SIZE; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR(&elems[i], rkh_queue_get(&queue));
+    }
+
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(1, info.nfull);
+    TEST_ASSERT_EQUAL(0, info.ndropNew);
+    TEST_ASSERT_EQUAL(1, info.ndropOld);
+}
+
+void
+test_DropOldestOnLifoPutIsRetrievedFirst(void)
+{
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_DROP_OLDEST, 0);
+    fill();
+    rkh_queue_put_lifo(&queue, &elems[QUEUE_SIZE]);
+
+    TEST_ASSERT_EQUAL_PTR(&elems[0], rkh_queue_takeEvicted(&queue));
+    TEST_ASSERT_EQUAL_PTR(&elems[QUEUE_SIZE], rkh_queue_get(&queue));
+    TEST_ASSERT_EQUAL_PTR(&elems[1], rkh_queue_get(&queue));
+}
+
+void
+test_PutOnQueueWithRoomDoesNotEvict(void)
+{
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_DROP_OLDEST, 0);
+    rkh_queue_put_fifo(&queue, &elems[0]);
+
+    TEST_ASSERT_NULL(rkh_queue_takeEvicted(&queue));
+    TEST_ASSERT_EQUAL(1, queue.qty);
+}
+
+void
+test_BlockWithoutActiveObjectBehavesAsDropNewest(void)
+{
+    RKH_QUEI_T info;
+
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_BLOCK, 10);
+    fill();
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+
+    TEST_ASSERT_EQUAL_PTR(&elems[QUEUE_SIZE], rkh_queue_takeEvicted(&queue));
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(0, info.nblock);
+    TEST_ASSERT_EQUAL(1, info.ndropNew);
+}
+
+void
+test_BlockPutsTheElementWhenQueueGetsRoom(void)
+{
+    RKH_QUEI_T info;
+    int i;
+
+    rkh_sma_setReady_Ignore();
+    rkh_sma_block_Ignore();
+    rkh_sma_setUnready_Ignore();
+    rkh_queue_init(&queue, queueSto, QUEUE_SIZE, &ao);
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_BLOCK, 10);
+    fill();
+    rkh_sma_blockFull_ExpectAndReturn(&ao, 10, RKH_TRUE);
+    rkh_sma_blockFull_StubWithCallback(MockBlockFullCallback);
+
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+
+    TEST_ASSERT_NULL(rkh_queue_takeEvicted(&queue));
+    for (i = 1; i <= QUEUE_SIZE; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR(&elems[i], rkh_queue_get(&queue));
+    }
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(1, info.nblock);
+    TEST_ASSERT_EQUAL(0, info.ntout);
+    TEST_ASSERT_EQUAL(0, info.ndropNew);
+}
+
+void
+test_BlockDiscardsTheElementOnTimeout(void)
+{
+    RKH_QUEI_T info;
+
+    rkh_sma_setReady_Ignore();
+    rkh_queue_init(&queue, queueSto, QUEUE_SIZE, &ao);
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_BLOCK, 10);
+    fill();
+    rkh_sma_blockFull_ExpectAndReturn(&ao, 10, RKH_FALSE);
+
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+
+    TEST_ASSERT_EQUAL_PTR(&elems[QUEUE_SIZE], rkh_queue_takeEvicted(&queue));
+    TEST_ASSERT_EQUAL(QUEUE_SIZE, queue.qty);
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(1, info.nblock);
+    TEST_ASSERT_EQUAL(1, info.ntout);
+    TEST_ASSERT_EQUAL(1, info.ndropNew);
+}
+
+void
+test_ClearInfoResetsOverflowCounters(void)
+{
+    RKH_QUEI_T info;
+
+    rkh_queue_setOverflow(&queue, RKH_QUE_OVF_DROP_OLDEST, 0);
+    fill();
+    rkh_queue_put_fifo(&queue, &elems[QUEUE_SIZE]);
+    rkh_queue_clear_info(&queue);
+
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(0, info.nfull);
+    TEST_ASSERT_EQUAL(0, info.ndropOld);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+
+/**
+ *  \addtogroup test_wmark Test cases of queue watermarks group
+ *  @{
+ *  \name Test cases of queue watermarks group
+ *  @{
+ */
+void
+test_HighWmarkIsNotifiedOnceUntilLowWmark(void)
+{
+    rkh_queue_setHighWmark(&queue, 3, hwmCb);
+    rkh_queue_setLowWmark(&queue, 1, lwmCb);
+
+    fill();
+    TEST_ASSERT_EQUAL(1, nHwm);
+    TEST_ASSERT_EQUAL(0, nLwm);
+
+    (void)rkh_queue_get(&queue);
+    (void)rkh_queue_get(&queue);
+    TEST_ASSERT_EQUAL(0, nLwm);
+    (void)rkh_queue_get(&queue);
+    TEST_ASSERT_EQUAL(1, nLwm);
+
+    (void)rkh_queue_get(&queue);
+    rkh_queue_put_fifo(&queue, &elems[0]);
+    TEST_ASSERT_EQUAL(1, nHwm);
+    TEST_ASSERT_EQUAL(1, nLwm);
+}
+
+void
+test_WmarkNotificationIsLeftPendingForCtrl(void)
+{
+    rkh_queue_setHighWmark(&queue, 3, (RKHQueueWmark)0);
+    rkh_queue_setLowWmark(&queue, 1, (RKHQueueWmark)0);
+    rkh_queue_setWmarkCtrl(&queue, &ctrl, &hwmEvt, &lwmEvt);
+
+    rkh_queue_put_fifo(&queue, &elems[0]);
+    rkh_queue_put_fifo(&queue, &elems[1]);
+    TEST_ASSERT_NULL(rkh_queue_takeWmark(&queue));
+    rkh_queue_put_fifo(&queue, &elems[2]);
+    TEST_ASSERT_EQUAL_PTR(&hwmEvt, rkh_queue_takeWmark(&queue));
+    TEST_ASSERT_NULL(rkh_queue_takeWmark(&queue));
+
+    (void)rkh_queue_get(&queue);
+    (void)rkh_queue_get(&queue);
+    TEST_ASSERT_EQUAL_PTR(&lwmEvt, rkh_queue_takeWmark(&queue));
+    TEST_ASSERT_NULL(ctrlPosted);
+}
+
+void
+test_DepletePostsLowWmarkNotificationToCtrl(void)
+{
+    RKH_QUEI_T info;
+
+    rkh_queue_setHighWmark(&queue, 3, (RKHQueueWmark)0);
+    rkh_queue_setLowWmark(&queue, 1, (RKHQueueWmark)0);
+    rkh_queue_setWmarkCtrl(&queue, &ctrl, &hwmEvt, &lwmEvt);
+    fill();
+    TEST_ASSERT_EQUAL_PTR(&hwmEvt, rkh_queue_takeWmark(&queue));
+
+    rkh_queue_deplete(&queue);
+
+    TEST_ASSERT_EQUAL_PTR(&lwmEvt, ctrlPosted);
+    TEST_ASSERT_NULL(rkh_queue_takeWmark(&queue));
+    rkh_queue_get_info(&queue, &info);
+    TEST_ASSERT_EQUAL(1, info.nhwm);
+    TEST_ASSERT_EQUAL(1, info.nlwm);
+}
+
+void
+test_DepleteBelowHighWmarkDoesNotNotify(void)
+{
+    rkh_queue_setHighWmark(&queue, 3, hwmCb);
+    rkh_queue_setLowWmark(&queue, 1, lwmCb);
+    rkh_queue_setWmarkCtrl(&queue, &ctrl, &hwmEvt, &lwmEvt);
+    rkh_queue_put_fifo(&queue, &elems[0]);
+    rkh_queue_put_fifo(&queue, &elems[1]);
+
+    rkh_queue_deplete(&queue);
+
+    TEST_ASSERT_NULL(ctrlPosted);
+    TEST_ASSERT_EQUAL(0, nLwm);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/* ------------------------------ End of file ------------------------------ */
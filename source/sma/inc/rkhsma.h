@@ -527,6 +527,68 @@ extern "C" {
         rkh_sma_dispatch((me_), (arg_))
 #endif
 
+/**
+ *  \brief
+ *  Releases every event allocated from the scratch arena of an active 
+ *  object. The scheduler loops invoke it after each RTC step, that is 
+ *  after RKH_SMA_DISPATCH() returns, but the arena is actually released 
+ *  only when the event queue of the active object becomes empty. Thus, 
+ *  a scratch event self-posted by means of RKH_SMA_POST_LIFO() or 
+ *  RKH_SMA_POST_FIFO() survives until it is dispatched.
+ *
+ *  \param[in] me_	    pointer to previously created state machine
+ *                      application.
+ *
+ *  \ingroup apiAO
+ */
+#if RKH_CFG_SMA_SCRATCH_EN == RKH_ENABLED
+    #define RKH_SMA_SCRATCH_RESET(me_) \
+        rkh_sma_scratchReset((RKH_SMA_T *)(me_))
+#else
+    #define RKH_SMA_SCRATCH_RESET(me_)      (void)0
+#endif
+
+/**
+ *  \brief
+ *  This macro allocates a short-lived event of type \a et from the scratch 
+ *  arena of the active object \a me_. The allocation is a pointer 
+ *  increment, and the event is never recycled individually, it is released 
+ *  along with the whole arena (see RKH_SMA_SCRATCH_RESET()).
+ *
+ *  A scratch event behaves as a static event, so it is ignored by 
+ *  rkh_fwk_gc(). It must only be posted to the active object that owns 
+ *  the arena, and it must not be deferred, published or retained beyond 
+ *  the RTC steps of its owner.
+ *
+ *  \param[in] et		type of event
+ *  \param[in] e		event signal
+ *  \param[in] me_		pointer to the active object that owns the arena
+ *
+ *  \return
+ *  Pointer to the event or NULL if the arena runs out of memory.
+ *
+ *  \usage
+ *	\code
+ *	void
+ *	my_action(ME_T *me, RKH_EVT_T *pe)
+ *	{
+ *	    STEP_T *step = RKH_ALLOC_SCRATCH_EVT(STEP_T, NEXT_STEP, me);
+ *
+ *	    if (step != (STEP_T *)0)
+ *	    {
+ *	        step->n = me->n + 1;
+ *	        RKH_SMA_POST_LIFO(RKH_UPCAST(RKH_SMA_T, me), 
+ *	                          RKH_UPCAST(RKH_EVT_T, step), me);
+ *	    }
+ *	}
+ *	\endcode
+ *
+ *  \ingroup apiAO
+ */
+#define RKH_ALLOC_SCRATCH_EVT(et, e, me_) \
+    (et *)rkh_sma_scratchAe((RKH_SMA_T *)(me_), (RKH_ES_T)sizeof(et), \
+                            (RKH_SIG_T)(e))
+
 /**
  *  \brief
  *  Declares a opaque pointer to previously created array of state machine
@@ -729,6 +791,22 @@ typedef struct RKH_SMAI_T
     rui16_t exectr;         /**< # of executed transitions */
 } RKH_SMAI_T;
 
+/**
+ *  \brief
+ *  Scratch arena of an active object, from which short-lived events are 
+ *  allocated by bumping a pointer, and released all at once when the 
+ *  active object completes its run-to-completion steps.
+ *
+ *  This member is optional, thus it could be eliminated in compile-time 
+ *  with RKH_CFG_SMA_SCRATCH_EN = 0.
+ */
+typedef struct RKH_SCRATCH_T
+{
+    rui8_t *sto;            /**< storage start of the arena */
+    rui32_t size;           /**< storage size [in bytes] */
+    rui32_t used;           /**< # of allocated bytes */
+} RKH_SCRATCH_T;
+
 /**
  *  \brief
  *  Describes the SMA (active object in UML).
@@ -850,6 +928,15 @@ struct RKH_SMA_T
 #if RKH_CFG_SMA_GET_INFO_EN == RKH_ENABLED
     RKH_SMAI_T sinfo;
 #endif
+
+    /**
+     *  \brief
+     *  Scratch arena of the active object. This member is optional, thus it 
+     *  could be eliminated in compile-time with RKH_CFG_SMA_SCRATCH_EN = 0.
+     */
+#if RKH_CFG_SMA_SCRATCH_EN == RKH_ENABLED
+    RKH_SCRATCH_T scratch;
+#endif
 };
 
 /** \copydetails RKHSmaVtbl::activate */
@@ -1254,6 +1341,73 @@ void rkh_sma_clear_info(RKH_SMA_T *me);
  */
 void rkh_sma_get_info(RKH_SMA_T *me, RKH_SMAI_T *psi);
 
+/**
+ *  \brief
+ *  Assigns the storage of the scratch arena of an active object. It must 
+ *  be invoked before the active object is activated.
+ *
+ *  \param[in] me      pointer to previously created state machine 
+ *                      application.
+ *  \param[in] sto     pointer to the storage of the arena, which must be 
+ *                      aligned as a pointer.
+ *  \param[in] size    storage size [in bytes].
+ *
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_SMA_SCRATCH_EN = 0.
+ */
+void rkh_sma_setScratch(RKH_SMA_T *me, void *sto, rui32_t size);
+
+/**
+ *  \brief
+ *  Allocates a memory block from the scratch arena of an active object. 
+ *  It must only be invoked from the thread of control of \a me.
+ *
+ *  \param[in] me      pointer to previously created state machine 
+ *                      application.
+ *  \param[in] size    block size [in bytes].
+ *
+ *  \return
+ *  Pointer to the block or NULL if the arena runs out of memory.
+ *
+ *  \note
+ *  This function is optional, thus it could be eliminated in compile-time
+ *  with RKH_CFG_SMA_SCRATCH_EN = 0.
+ */
+void *rkh_sma_scratchAlloc(RKH_SMA_T *me, rui32_t size);
+
+/**
+ *  \brief
+ *  Allocates an event from the scratch arena of an active object.
+ *
+ *  \param[in] me      pointer to previously created state machine 
+ *                      application.
+ *  \param[in] esize   size of event [in bytes].
+ *  \param[in] e       event signal.
+ *
+ *  \return
+ *  Pointer to the event or NULL if the arena runs out of memory.
+ *
+ *  \note
+ *  This function is internal to RKH and the user application should not 
+ *  call it. Instead, use #RKH_ALLOC_SCRATCH_EVT() macro.
+ */
+RKH_EVT_T *rkh_sma_scratchAe(RKH_SMA_T *me, RKH_ES_T esize, RKH_SIG_T e);
+
+/**
+ *  \brief
+ *  Releases the scratch arena of an active object when its event queue 
+ *  is empty.
+ *
+ *  \param[in] me      pointer to previously created state machine 
+ *                      application.
+ *
+ *  \note
+ *  This function is internal to RKH and the user application should not 
+ *  call it. Instead, use #RKH_SMA_SCRATCH_RESET() macro.
+ */
+void rkh_sma_scratchReset(RKH_SMA_T *me);
+
 #ifdef __cplusplus
 }
 #endif
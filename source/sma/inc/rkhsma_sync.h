@@ -93,6 +93,21 @@ void rkh_sma_setReady(RKH_SMA_T *const me);
  */
 void rkh_sma_setUnready(RKH_SMA_T *const me);
 
+/**
+ *  \brief
+ *  Encapsulates the mechanism of blocking a producer on a full native
+ *  event queue, when its overflow policy is RKH_QUE_OVF_BLOCK. It is
+ *  invoked within a critical section and it must release it while
+ *  waiting. Only multi-thread ports must provide it.
+ *
+ *  \param[in] me 		pointer to active object that owns the full queue.
+ *  \param[in] tout		maximum number of ticks to wait for room.
+ *
+ *  \return
+ *  RKH_TRUE if the queue has room, otherwise RKH_FALSE (timeout).
+ */
+rbool_t rkh_sma_blockFull(RKH_SMA_T *const me, rui32_t tout);
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
@@ -56,6 +56,7 @@
 #include "rkhtrc_record.h"
 #include "rkhtrc_filter.h"
 #include "rkhfwk_hook.h"
+#include "rkhfwk_dynevt.h"
 
 RKH_MODULE_NAME(rkhsma)
 
@@ -66,6 +67,38 @@ RKH_MODULE_NAME(rkhsma)
     #define RKH_SMA_GET_NMIN(ao)    0
 #endif
 
+/*
+ *  An event discarded or evicted by the overflow policy of a queue must be 
+ *  recycled, and a watermark notification must be posted to the queue's 
+ *  controller, both outside of the critical section.
+ */
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    #define RKH_SMA_OVF_ALLOC() \
+        const RKH_EVT_T *evicted, *wmEvt; \
+        RKH_SMA_T *ctrl
+    #define RKH_SMA_OVF_TAKE(q) \
+        evicted = (const RKH_EVT_T *)rkh_queue_takeEvicted(q); \
+        wmEvt = (const RKH_EVT_T *)rkh_queue_takeWmark(q); \
+        ctrl = (RKH_SMA_T *)((q)->ctrl)
+    #define RKH_SMA_OVF_RELEASE(sender_) \
+        if (evicted != (const RKH_EVT_T *)0) \
+        { \
+            RKH_FWK_GC(CE(evicted), sender_); \
+        } \
+        if (wmEvt != (const RKH_EVT_T *)0) \
+        { \
+            RKH_SMA_POST_FIFO(ctrl, wmEvt, sender_); \
+        }
+#else
+    #define RKH_SMA_OVF_ALLOC()
+    #define RKH_SMA_OVF_TAKE(q)
+    #define RKH_SMA_OVF_RELEASE(sender_)
+#endif
+
+/* blocks of the scratch arena are aligned as a pointer */
+#define RKH_SCRATCH_ROUNDUP(size_) \
+    (((size_) + (rui32_t)sizeof(void *) - 1) & ~((rui32_t)sizeof(void *) - 1))
+
 /* ------------------------------- Constants ------------------------------- */
 #if R_TRC_AO_NAME_EN == RKH_DISABLED
 RKHROM char noname[] = "null";
@@ -170,6 +203,7 @@ rkh_sma_post_fifo(RKH_SMA_T *sma, const RKH_EVT_T *e,
 rkh_sma_post_fifo(RKH_SMA_T * sma, const RKH_EVT_T * e)
 #endif
 {
+    RKH_SMA_OVF_ALLOC();
     RKH_SR_ALLOC();
 
     RKH_HOOK_SIGNAL(e);
@@ -177,10 +211,12 @@ rkh_sma_post_fifo(RKH_SMA_T * sma, const RKH_EVT_T * e)
 
     RKH_INC_REF(e);
     rkh_queue_put_fifo(&sma->equeue, e);
-    RKH_TR_SMA_FIFO(sma, e, sender, e->pool, e->nref, sma->equeue.qty, 
-                    RKH_SMA_GET_NMIN(sma));
+    RKH_TR_SMA_FIFO(sma, e, sender, RKH_EVT_POOL_ID(e), e->nref, 
+                    sma->equeue.qty, RKH_SMA_GET_NMIN(sma));
+    RKH_SMA_OVF_TAKE(&sma->equeue);
 
     RKH_EXIT_CRITICAL_();
+    RKH_SMA_OVF_RELEASE(sma);
 }
 #endif
 
@@ -194,6 +230,7 @@ rkh_sma_post_lifo(RKH_SMA_T *sma, const RKH_EVT_T *e,
 rkh_sma_post_lifo(RKH_SMA_T * sma, const RKH_EVT_T * e)
 #endif
 {
+    RKH_SMA_OVF_ALLOC();
     RKH_SR_ALLOC();
 
     RKH_HOOK_SIGNAL(e);
@@ -201,10 +238,12 @@ rkh_sma_post_lifo(RKH_SMA_T * sma, const RKH_EVT_T * e)
 
     RKH_INC_REF(e);
     rkh_queue_put_lifo(&sma->equeue, e);
-    RKH_TR_SMA_LIFO(sma, e, sender, e->pool, e->nref, sma->equeue.qty, 
-                    RKH_SMA_GET_NMIN(sma));
+    RKH_TR_SMA_LIFO(sma, e, sender, RKH_EVT_POOL_ID(e), e->nref, 
+                    sma->equeue.qty, RKH_SMA_GET_NMIN(sma));
+    RKH_SMA_OVF_TAKE(&sma->equeue);
 
     RKH_EXIT_CRITICAL_();
+    RKH_SMA_OVF_RELEASE(sma);
 }
 #endif
 
@@ -213,6 +252,7 @@ RKH_EVT_T *
 rkh_sma_get(RKH_SMA_T *sma)
 {
     RKH_EVT_T *e;
+    RKH_SMA_OVF_ALLOC();
     RKH_SR_ALLOC();
 
     e = rkh_queue_get(&sma->equeue);
@@ -220,8 +260,19 @@ rkh_sma_get(RKH_SMA_T *sma)
     RKH_ASSERT(e != (RKH_EVT_T *)0);
     /* Because the variables are obtained outside critical section could be */
     /* a race condition */
-    RKH_TR_SMA_GET(sma, e, e->pool, e->nref, 
+    RKH_TR_SMA_GET(sma, e, RKH_EVT_POOL_ID(e), e->nref, 
                    sma->equeue.qty, RKH_SMA_GET_NMIN(sma));
+#if RKH_CFG_QUE_OVF_POLICY_EN == RKH_ENABLED
+    /* A watermark notification is seldom pending, thus the critical */
+    /* section is only entered to take it when there is one */
+    if (sma->equeue.wmEvt != (const void *)0)
+    {
+        RKH_ENTER_CRITICAL_();
+        RKH_SMA_OVF_TAKE(&sma->equeue);
+        RKH_EXIT_CRITICAL_();
+        RKH_SMA_OVF_RELEASE(sma);
+    }
+#endif
     return e;
 }
 #endif
@@ -236,6 +287,7 @@ rkh_sma_dispatch(RKH_SMA_T *me, void *arg)
 void
 rkh_sma_defer(RKH_QUEUE_T *q, const RKH_EVT_T *e)
 {
+    RKH_SMA_OVF_ALLOC();
     RKH_SR_ALLOC();
 
     RKH_ENTER_CRITICAL_();
@@ -243,14 +295,17 @@ rkh_sma_defer(RKH_QUEUE_T *q, const RKH_EVT_T *e)
     RKH_INC_REF(e);
     rkh_queue_put_fifo(q, e);
     RKH_TR_SMA_DEFER(q, e);
+    RKH_SMA_OVF_TAKE(q);
 
     RKH_EXIT_CRITICAL_();
+    RKH_SMA_OVF_RELEASE(q);
 }
 
 RKH_EVT_T *
 rkh_sma_recall(RKH_SMA_T *sma, RKH_QUEUE_T *q)
 {
     RKH_EVT_T *e;
+    RKH_SMA_OVF_ALLOC();
     RKH_SR_ALLOC();
 
     e = rkh_queue_get(q);          /* get an event from deferred queue */
@@ -276,10 +331,16 @@ rkh_sma_recall(RKH_SMA_T *sma, RKH_QUEUE_T *q)
              * We need to decrement the reference counter once, to account
              * for removing the event from the deferred event queue.
              */
+#if RKH_CFG_FWK_ATOMIC_NREF_EN == RKH_ENABLED
+            (void)RKH_NREF_DEC(&e->nref);
+#else
             --e->nref;
+#endif
         }
 #endif
+        RKH_SMA_OVF_TAKE(q);
         RKH_EXIT_CRITICAL_();
+        RKH_SMA_OVF_RELEASE(sma);
     }
     return e;
 }
@@ -310,4 +371,60 @@ rkh_sma_get_info(RKH_SMA_T *sma, RKH_SMAI_T *psi)
 }
 #endif
 
+#if RKH_CFG_SMA_SCRATCH_EN == RKH_ENABLED
+void
+rkh_sma_setScratch(RKH_SMA_T *me, void *sto, rui32_t size)
+{
+    RKH_REQUIRE((me != (RKH_SMA_T *)0) && 
+                ((sto != (void *)0) || (size == 0)));
+
+    me->scratch.sto = (rui8_t *)sto;
+    me->scratch.size = size;
+    me->scratch.used = 0;
+}
+
+void *
+rkh_sma_scratchAlloc(RKH_SMA_T *me, rui32_t size)
+{
+    rui8_t *blk;
+
+    size = RKH_SCRATCH_ROUNDUP(size);
+    if (size > (me->scratch.size - me->scratch.used))
+    {
+        return (void *)0;
+    }
+    blk = me->scratch.sto + me->scratch.used;
+    me->scratch.used += size;
+    return blk;
+}
+
+RKH_EVT_T *
+rkh_sma_scratchAe(RKH_SMA_T *me, RKH_ES_T esize, RKH_SIG_T e)
+{
+    RKH_EVT_T *evt;
+
+    evt = (RKH_EVT_T *)rkh_sma_scratchAlloc(me, (rui32_t)esize);
+    if (evt != (RKH_EVT_T *)0)
+    {
+        evt->e = e;                     /* a scratch event is handled as */
+        evt->nref = 0;                  /* a static one, thus it is never */
+        evt->pool = 0;                  /* recycled by rkh_fwk_gc() */
+    }
+    return evt;
+}
+
+void
+rkh_sma_scratchReset(RKH_SMA_T *me)
+{
+    /* 
+     * Scratch events are only posted by the owner to itself, thus this 
+     * unlocked read cannot miss a pending one. 
+     */
+    if (me->equeue.qty == 0)
+    {
+        me->scratch.used = 0;
+    }
+}
+#endif
+
 /* ------------------------------ End of file ------------------------------ */
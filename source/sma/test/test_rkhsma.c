@@ -283,6 +283,61 @@ test_Recall(void)
     TEST_ASSERT_EQUAL(NULL, e);
 }
 
+void
+test_AllocateScratchEvt(void)
+{
+    void *sto[8];
+    RKH_EVT_T *e;
+
+    rkh_sma_setScratch(&receiver, sto, sizeof(sto));
+    e = RKH_ALLOC_SCRATCH_EVT(RKH_EVT_T, 4, &receiver);
+
+    TEST_ASSERT_EQUAL_PTR(sto, e);
+    TEST_ASSERT_EQUAL(4, e->e);
+    TEST_ASSERT_EQUAL(0, e->nref);
+    TEST_ASSERT_EQUAL(0, e->pool);
+}
+
+void
+test_TriesAllocateScratchEvtFromFullArena(void)
+{
+    void *sto[1];
+    RKH_EVT_T *e;
+
+    rkh_sma_setScratch(&receiver, sto, sizeof(sto));
+    e = (RKH_EVT_T *)rkh_sma_scratchAlloc(&receiver, sizeof(sto) + 1);
+
+    TEST_ASSERT_NULL(e);
+}
+
+void
+test_ScratchResetKeepsArenaWithPendingEvts(void)
+{
+    void *sto[8];
+    RKH_EVT_T *e;
+
+    rkh_sma_setScratch(&receiver, sto, sizeof(sto));
+    e = RKH_ALLOC_SCRATCH_EVT(RKH_EVT_T, 4, &receiver);
+    receiver.equeue.qty = 1;
+    RKH_SMA_SCRATCH_RESET(&receiver);
+
+    TEST_ASSERT_TRUE(RKH_ALLOC_SCRATCH_EVT(RKH_EVT_T, 4, &receiver) != e);
+}
+
+void
+test_ScratchResetReleasesArena(void)
+{
+    void *sto[8];
+    RKH_EVT_T *e;
+
+    rkh_sma_setScratch(&receiver, sto, sizeof(sto));
+    e = RKH_ALLOC_SCRATCH_EVT(RKH_EVT_T, 4, &receiver);
+    receiver.equeue.qty = 0;
+    RKH_SMA_SCRATCH_RESET(&receiver);
+
+    TEST_ASSERT_EQUAL_PTR(e, RKH_ALLOC_SCRATCH_EVT(RKH_EVT_T, 4, &receiver));
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 
@@ -144,6 +144,26 @@
  *	The transmitter computes the checksum over the sequence number, the
  *	trace event ID, and all data bytes before performing any byte stuffing.
  *
+ *  <em>Compact encoding</em>
+ *
+ *  If the #RKH_CFG_TRC_COMPACT_EN is set to 1 then some fields of the 
+ *  frame are encoded as LEB128 varints, that is, 7 bits per byte starting 
+ *  from the least significant ones, where the most significant bit of a 
+ *  byte is set when another byte follows.
+ *
+ *	-	The <B>timestamp</B> is the varint of its difference from the 
+ *	    timestamp of the previous frame, modulo the size of the timestamp.
+ *	    The frames whose sequence number is 0 and the RKH_TE_FWK_TRCLOST 
+ *	    ones carry the absolute timestamp instead, thus the trazer tool 
+ *	    resynchronizes the timestamp after a data discontinuity.
+ *	-	The <B>signals</B> are varints.
+ *	-	The <B>objects</B> are the varint of their interned ID. The symbol 
+ *	    records, such as RKH_TE_FWK_OBJ or RKH_TE_FWK_STATE, intern the 
+ *	    object and carry its ID followed by the varint of its address. An 
+ *	    object without ID, either because it was not sent as a symbol or 
+ *	    the symbol table is full, see #RKH_CFG_TRC_SIZEOF_SYMTBL, is the ID 
+ *	    0 followed by the varint of its address.
+ *
  *  <em>User trace events</em>
  *
  *  The user application could defined its own trace events to be placed
@@ -134,6 +134,69 @@ extern "C" {
     #define RKH_TRC_SIG_ISOFF(sig)
 #endif
 
+#if RKH_CFG_TRC_PROFILE_EN == RKH_ENABLED
+    /*
+     *  The filter profile of the application, rkhtrcprof.h, may define:
+     *
+     *  RKH_TRC_PROF_GROUPS         bit mask of the groups whose events are 
+     *                              all on, e.g. RKH_BIT(RKH_TG_SMA).
+     *  RKH_TRC_PROF_EVENT(eid_)    true if the event eid_ is on, regardless 
+     *                              of its group, e.g. 
+     *                              ((eid_) == RKH_TE_SM_TRN).
+     *  RKH_TRC_PROF_AO(prio_)      true if the active object of priority 
+     *                              prio_ is on.
+     *  RKH_TRC_PROF_SIG(sig_)      true if the signal sig_ is on.
+     *
+     *  By default, every event is off and every active object and signal 
+     *  is on. The profile is usually generated by a build script from the 
+     *  list of the trace points to keep.
+     */
+    #include "rkhtrcprof.h"
+
+    #ifndef RKH_TRC_PROF_GROUPS
+        #define RKH_TRC_PROF_GROUPS         0
+    #endif
+
+    #ifndef RKH_TRC_PROF_EVENT
+        #define RKH_TRC_PROF_EVENT(eid_)    RKH_FALSE
+    #endif
+
+    #ifndef RKH_TRC_PROF_AO
+        #define RKH_TRC_PROF_AO(prio_)      RKH_TRUE
+    #endif
+
+    #ifndef RKH_TRC_PROF_SIG
+        #define RKH_TRC_PROF_SIG(sig_)      RKH_TRUE
+    #endif
+
+    /**
+     *  \brief
+     *  Test the event eid_ against the filter profile, see 
+     *  #RKH_CFG_TRC_PROFILE_EN.
+     *
+     *  Since the event ID of a record is a constant, the test is resolved 
+     *  at compile time and the compiler removes the records left out by 
+     *  the profile, including their runtime filter lookups.
+     *
+     *	\note
+     *  This macro is internal to RKH and the user application should not 
+     *  call it.
+     */
+    #define RKH_TRC_PROFILE_ISON(eid_) \
+            ((((rui32_t)(RKH_TRC_PROF_GROUPS) >> GETGRP(eid_)) & 1u) || \
+             RKH_TRC_PROF_EVENT(eid_))
+
+    #define RKH_TRC_AO_ISON(prio_) \
+            && RKH_TRC_PROF_AO(prio_)
+
+    #define RKH_TRC_SIG_ISON(sig_) \
+            && (RKH_TRC_IS_RESERVED_SIG(sig_) || RKH_TRC_PROF_SIG(sig_))
+#else
+    #define RKH_TRC_PROFILE_ISON(eid_)      RKH_TRUE
+    #define RKH_TRC_AO_ISON(prio_)
+    #define RKH_TRC_SIG_ISON(sig_)
+#endif
+
 /* -------------------------------- Constants ------------------------------ */
 #if RKH_CFG_TRC_SIZEOF_TE_ID == 8
         #define RKH_NBITS_GROUP             3
@@ -480,7 +543,11 @@ extern "C" {
 #define RKH_TE_FWK_QUEUE        (RKH_TE_FWK_EPOOL + 1)
 /** \copybrief RKH_TR_FWK_ACTOR */
 #define RKH_TE_FWK_ACTOR        (RKH_TE_FWK_QUEUE + 1)
-#define RKH_FWK_END             RKH_TE_FWK_ACTOR
+/** \copybrief RKH_TR_FWK_TRCLOST */
+#define RKH_TE_FWK_TRCLOST      (RKH_TE_FWK_ACTOR + 1)
+/** \copybrief RKH_TR_FWK_SYMDICT */
+#define RKH_TE_FWK_SYMDICT      (RKH_TE_FWK_TRCLOST + 1)
+#define RKH_FWK_END             RKH_TE_FWK_SYMDICT
 
 /* --- User events (USR group) --------------------------------------------- */
 #define RKH_TE_USER             RKH_USR_START
@@ -547,6 +614,18 @@ extern "C" {
     #error  "by RKH_TOT_NUM_TRC_EVTS must be <= RKH_TRC_MAX_EVENTS"
 #endif
 
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+    /* 
+     * The records are written into the lane of the caller without locking, 
+     * see rkh_trc_begin(), thus the record macros do not lock.
+     */
+    #define RKH_TRC_ENTER_CRITICAL_()
+    #define RKH_TRC_EXIT_CRITICAL_()
+#else
+    #define RKH_TRC_ENTER_CRITICAL_()   RKH_ENTER_CRITICAL_()
+    #define RKH_TRC_EXIT_CRITICAL_()    RKH_EXIT_CRITICAL_()
+#endif
+
 #if RKH_CFG_TRC_RTFIL_EN == RKH_ENABLED
         /**
          *	Each trace event always begins with the macro RKH_TRC_BEGIN()
@@ -569,31 +648,39 @@ extern "C" {
          *  This macro always invokes the rkh_trc_begin() function.
          */
         #define RKH_TRC_BEGIN(eid_, prio_, sig_)  \
-            if (rkh_trc_isoff_(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_) \
+                RKH_TRC_SIG_ISON(sig_) \
+                && rkh_trc_isoff_(eid_) \
                 RKH_TRC_AO_ISOFF(prio_) \
                 RKH_TRC_SIG_ISOFF(sig_)) \
             { \
-                RKH_ENTER_CRITICAL_(); \
+                RKH_TRC_ENTER_CRITICAL_(); \
                 rkh_trc_begin(eid_);
 
         #define RKH_TRC_BEGIN_WOAO(eid_, sig_) \
-            if (rkh_trc_isoff_(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_SIG_ISON(sig_) \
+                && rkh_trc_isoff_(eid_) \
                 RKH_TRC_SIG_ISOFF(sig_)) \
             { \
-                RKH_ENTER_CRITICAL_(); \
+                RKH_TRC_ENTER_CRITICAL_(); \
                 rkh_trc_begin(eid_);
 
         #define RKH_TRC_BEGIN_WOSIG(eid_, prio_) \
-            if (rkh_trc_isoff_(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_) \
+                && rkh_trc_isoff_(eid_) \
                 RKH_TRC_AO_ISOFF(prio_)) \
             { \
-                RKH_ENTER_CRITICAL_(); \
+                RKH_TRC_ENTER_CRITICAL_(); \
                 rkh_trc_begin(eid_);
 
         #define RKH_TRC_BEGIN_WOAOSIG(eid_) \
-            if (rkh_trc_isoff_(eid_)) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                && rkh_trc_isoff_(eid_)) \
             { \
-                RKH_ENTER_CRITICAL_(); \
+                RKH_TRC_ENTER_CRITICAL_(); \
                 rkh_trc_begin(eid_);
 
         /**
@@ -608,7 +695,7 @@ extern "C" {
          */
         #define RKH_TRC_END() \
             rkh_trc_end(); \
-            RKH_EXIT_CRITICAL_(); \
+            RKH_TRC_EXIT_CRITICAL_(); \
             }
 
         /**
@@ -620,7 +707,10 @@ extern "C" {
          *	\param[in] sig_		signal.
          */
         #define RKH_TRC_BEGIN_NOCRIT(eid_, prio_, sig_) \
-            if (rkh_trc_isoff_(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_) \
+                RKH_TRC_SIG_ISON(sig_) \
+                && rkh_trc_isoff_(eid_) \
                 RKH_TRC_AO_ISOFF(prio_) \
                 RKH_TRC_SIG_ISOFF(sig_)) \
             { \
@@ -635,7 +725,9 @@ extern "C" {
          *	\param[in] sig_		signal.
          */
         #define RKH_TRC_BEGIN_WOAO_NOCRIT(eid_, sig_) \
-            if (rkh_trc_isoff_(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_SIG_ISON(sig_) \
+                && rkh_trc_isoff_(eid_) \
                 RKH_TRC_SIG_ISOFF(sig_)) \
             { \
                 rkh_trc_begin(eid_);
@@ -649,7 +741,9 @@ extern "C" {
          *	\param[in] prio_	priority of active object.
          */
         #define RKH_TRC_BEGIN_WOSIG_NOCRIT(eid_, prio_) \
-            if (rkh_trc_isoff_(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_) \
+                && rkh_trc_isoff_(eid_) \
                 RKH_TRC_AO_ISOFF(prio_)) \
             { \
                 rkh_trc_begin(eid_);
@@ -662,7 +756,8 @@ extern "C" {
          *	                    See RKH_TE_<group>_<event> definitions.
          */
         #define RKH_TRC_BEGIN_WOAOSIG_NOCRIT(eid_) \
-            if (rkh_trc_isoff_(eid_)) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                && rkh_trc_isoff_(eid_)) \
             { \
                 rkh_trc_begin(eid_);
 
@@ -672,26 +767,91 @@ extern "C" {
         #define RKH_TRC_END_NOCRIT() \
             rkh_trc_end(); \
             }
+#elif RKH_CFG_TRC_PROFILE_EN == RKH_ENABLED
+        /*
+         *  Without runtime filter, the records are only filtered by the 
+         *  profile, which is evaluated at compile time.
+         */
+        #define RKH_TRC_BEGIN(eid_, prio_, sig_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_) \
+                RKH_TRC_SIG_ISON(sig_)) \
+            { \
+                RKH_TRC_ENTER_CRITICAL_(); \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_BEGIN_WOAO(eid_, sig_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_SIG_ISON(sig_)) \
+            { \
+                RKH_TRC_ENTER_CRITICAL_(); \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_BEGIN_WOSIG(eid_, prio_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_)) \
+            { \
+                RKH_TRC_ENTER_CRITICAL_(); \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_BEGIN_WOAOSIG(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_)) \
+            { \
+                RKH_TRC_ENTER_CRITICAL_(); \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_END() \
+            rkh_trc_end(); \
+            RKH_TRC_EXIT_CRITICAL_(); \
+            }
+
+        #define RKH_TRC_BEGIN_NOCRIT(eid_, prio_, sig_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_) \
+                RKH_TRC_SIG_ISON(sig_)) \
+            { \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_BEGIN_WOAO_NOCRIT(eid_, sig_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_SIG_ISON(sig_)) \
+            { \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_BEGIN_WOSIG_NOCRIT(eid_, prio_) \
+            if (RKH_TRC_PROFILE_ISON(eid_) \
+                RKH_TRC_AO_ISON(prio_)) \
+            { \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_BEGIN_WOAOSIG_NOCRIT(eid_) \
+            if (RKH_TRC_PROFILE_ISON(eid_)) \
+            { \
+                rkh_trc_begin(eid_);
+
+        #define RKH_TRC_END_NOCRIT() \
+            rkh_trc_end(); \
+            }
 #else
         #define RKH_TRC_BEGIN(eid_, prio_, sig_) \
-            RKH_ENTER_CRITICAL_(); \
+            RKH_TRC_ENTER_CRITICAL_(); \
             rkh_trc_begin(eid_);
 
         #define RKH_TRC_BEGIN_WOAO(eid_, sig_) \
-            RKH_ENTER_CRITICAL_(); \
+            RKH_TRC_ENTER_CRITICAL_(); \
             rkh_trc_begin(eid_);
 
         #define RKH_TRC_BEGIN_WOSIG(eid_, prio_) \
-            RKH_ENTER_CRITICAL_(); \
+            RKH_TRC_ENTER_CRITICAL_(); \
             rkh_trc_begin(eid_);
 
         #define RKH_TRC_BEGIN_WOAOSIG(eid_) \
-            RKH_ENTER_CRITICAL_(); \
+            RKH_TRC_ENTER_CRITICAL_(); \
             rkh_trc_begin(eid_);
 
         #define RKH_TRC_END() \
             rkh_trc_end();  \
-            RKH_EXIT_CRITICAL_();
+            RKH_TRC_EXIT_CRITICAL_();
 
         #define RKH_TRC_BEGIN_NOCRIT(eid_, prio_, sig_) \
             rkh_trc_begin(eid_);
@@ -715,7 +875,7 @@ extern "C" {
  */
 #define RKH_TRC_BEGIN_WOFIL(eid_) \
         RKH_SR_ALLOC(); \
-        RKH_ENTER_CRITICAL_(); \
+        RKH_TRC_ENTER_CRITICAL_(); \
         rkh_trc_begin(eid_);
 
 /**
@@ -724,7 +884,7 @@ extern "C" {
  */
 #define RKH_TRC_END_WOFIL() \
         rkh_trc_end(); \
-        RKH_EXIT_CRITICAL_();
+        RKH_TRC_EXIT_CRITICAL_();
 
 /**
  *  Idem RKH_TRC_BEGIN_WOFIL() macro but without entering critical section.
@@ -745,7 +905,7 @@ extern "C" {
  */
 #define RKH_TRC_BEGIN_DFT(eid_) \
         RKH_SR_ALLOC(); \
-        RKH_ENTER_CRITICAL_(); \
+        RKH_TRC_ENTER_CRITICAL_(); \
         rkh_trc_clear_chk(); \
         RKH_TRC_TE_ID(eid_);
 
@@ -755,7 +915,7 @@ extern "C" {
  */
 #define RKH_TRC_END_DFT() \
         rkh_trc_end(); \
-        RKH_EXIT_CRITICAL_();
+        RKH_TRC_EXIT_CRITICAL_();
 
 /**
  *  \brief
@@ -800,7 +960,7 @@ extern "C" {
             RKH_SR_ALLOC(); \
             if (rkh_trc_isoff_(eid_)) \
             { \
-                RKH_ENTER_CRITICAL_(); \
+                RKH_TRC_ENTER_CRITICAL_(); \
                 rkh_trc_begin(eid_);
 
         /**
@@ -808,7 +968,7 @@ extern "C" {
          */
         #define RKH_TRC_USR_END() \
             rkh_trc_end(); \
-            RKH_EXIT_CRITICAL_(); \
+            RKH_TRC_EXIT_CRITICAL_(); \
             }
 
         /**
@@ -967,8 +1127,14 @@ extern "C" {
 /**
  *  \brief
  *  Insert a object address as trace record argument.
+ *
+ *  The compact encoding sends the interned ID of the object instead, see 
+ *  rkh_trc_sym().
  */
-#if RKH_CFGPORT_TRC_SIZEOF_PTR == 16
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+        #define RKH_TRC_SYM(sym)  \
+            rkh_trc_sym((rui32_t)sym)
+#elif RKH_CFGPORT_TRC_SIZEOF_PTR == 16
         #define RKH_TRC_SYM(sym)  \
             RKH_TRC_UI16((rui16_t)sym)
 #elif RKH_CFGPORT_TRC_SIZEOF_PTR == 32
@@ -994,7 +1160,10 @@ extern "C" {
  *  \brief
  *  Insert a function address as trace record argument.
  */
-#if RKH_CFGPORT_TRC_SIZEOF_FUN_PTR == 16
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+        #define RKH_TRC_FUN(sym)  \
+            rkh_trc_sym((rui32_t)sym)
+#elif RKH_CFGPORT_TRC_SIZEOF_FUN_PTR == 16
         #define RKH_TRC_FUN(sym)  \
             RKH_TRC_UI16((rui16_t)sym)
 #elif RKH_CFGPORT_TRC_SIZEOF_FUN_PTR == 32
@@ -1063,6 +1232,23 @@ extern "C" {
         #endif
 #endif
 
+/**
+ *  Insert the reference counter of a dynamic event as trace record argument.
+ */
+#if RKH_CFG_FWK_SIZEOF_NREF == 8
+        #define RKH_TRC_NREF(nr) \
+            RKH_TRC_UI8(nr)
+#elif RKH_CFG_FWK_SIZEOF_NREF == 16
+        #define RKH_TRC_NREF(nr) \
+            RKH_TRC_UI16(nr)
+#elif RKH_CFG_FWK_SIZEOF_NREF == 32
+        #define RKH_TRC_NREF(nr) \
+            RKH_TRC_UI32(nr)
+#else
+        #define RKH_TRC_NREF(nr) \
+            RKH_TRC_UI8(nr)
+#endif
+
 /**
  *  Insert the block size value as trace record argument.
  */
@@ -1124,7 +1310,10 @@ extern "C" {
 /**
  *  Insert a signal number as trace record argument.
  */
-#if RKH_CFG_FWK_SIZEOF_EVT == 8
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+        #define RKH_TRC_SIG(e) \
+            rkh_trc_varint((rui32_t)(e))
+#elif RKH_CFG_FWK_SIZEOF_EVT == 8
         #define RKH_TRC_SIG(e) \
             RKH_TRC_UI8(e)
 #elif RKH_CFG_FWK_SIZEOF_EVT == 16
@@ -1225,8 +1414,10 @@ enum RKH_TRC_FMT
  *  \brief
  *  Defines the size of trace timestamp.
  *
- *  The valid values [in bits] are 8, 16 or 32. Default is 16. This type is
- *  configurable via the RKH_CFGPORT_TRC_SIZEOF_TSTAMP preprocessor option.
+ *  The valid values [in bits] are 8, 16, 32 or 64. Default is 16. This type 
+ *  is configurable via the RKH_CFGPORT_TRC_SIZEOF_TSTAMP preprocessor 
+ *  option. The 64 bits timestamp requires the port to define the rui64_t 
+ *  data type.
  */
 #if RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED
     #if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 8
@@ -1235,6 +1426,8 @@ enum RKH_TRC_FMT
         typedef rui16_t RKH_TS_T;
     #elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 32
         typedef rui32_t RKH_TS_T;
+    #elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+        typedef rui64_t RKH_TS_T;
     #else
         typedef rui16_t RKH_TS_T;
     #endif
@@ -1244,8 +1437,10 @@ enum RKH_TRC_FMT
 
 #if RKH_CFG_TRC_SIZEOF_STREAM < 255u
     typedef rui8_t TRCQTY_T;
-#else
+#elif RKH_CFG_TRC_SIZEOF_STREAM <= 65535u
     typedef rui16_t TRCQTY_T;
+#else
+    typedef rui32_t TRCQTY_T;
 #endif
 
 /**
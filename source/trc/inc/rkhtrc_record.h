@@ -356,7 +356,7 @@ extern "C" {
                 RKH_TRC_SYM(actObj_); \
                 RKH_TRC_SIG((evt_)->e); \
                 RKH_TRC_UI8(poolID_); \
-                RKH_TRC_UI8(refCntr_); \
+                RKH_TRC_NREF(refCntr_); \
                 RKH_TRC_NE(nElem_); \
                 RKH_TRC_QUE_NMIN(nMin_); \
             RKH_TRC_END()
@@ -388,7 +388,7 @@ extern "C" {
                 RKH_TRC_SIG((evt_)->e); \
                 RKH_TRC_SNDR(sender_); \
                 RKH_TRC_UI8(poolID_); \
-                RKH_TRC_UI8(refCntr_); \
+                RKH_TRC_NREF(refCntr_); \
                 RKH_TRC_NE(nElem_); \
                 RKH_TRC_QUE_NMIN(nMin_); \
             RKH_TRC_END_NOCRIT()
@@ -420,7 +420,7 @@ extern "C" {
                 RKH_TRC_SIG((evt_)->e); \
                 RKH_TRC_SNDR(sender_); \
                 RKH_TRC_UI8(poolID_); \
-                RKH_TRC_UI8(refCntr_); \
+                RKH_TRC_NREF(refCntr_); \
                 RKH_TRC_NE(nElem_); \
                 RKH_TRC_QUE_NMIN(nMin_); \
             RKH_TRC_END_NOCRIT()
@@ -1087,8 +1087,13 @@ extern "C" {
          *  \description    Initialize the RKH framework
          *  \trcGroup       RKH_TG_FWK
          *  \trcEvent       RKH_TE_FWK_EN
+         *
+         *  \note
+         *  The symbols collected so far are sent just before, see 
+         *  RKH_TR_FWK_SYMDICT().
          */
         #define RKH_TR_FWK_EN() \
+            RKH_TR_FWK_SYMDICT(); \
             RKH_TRC_BEGIN_WOAOSIG(RKH_TE_FWK_EN) \
             RKH_TRC_END()
 
@@ -1150,8 +1155,8 @@ extern "C" {
             RKH_TRC_BEGIN_WOAOSIG(RKH_TE_FWK_AE) \
                 RKH_TRC_ES(evtSize_); \
                 RKH_TRC_SIG((evt_)->e); \
-                RKH_TRC_UI8((evt_)->pool - 1); \
-                RKH_TRC_UI8((evt_)->nref); \
+                RKH_TRC_UI8(RKH_EVT_POOL_ID(evt_) - 1); \
+                RKH_TRC_NREF((evt_)->nref); \
                 RKH_TRC_NBLK(nUsed_); \
                 RKH_TRC_MP_NMIN(nMin_); \
                 RKH_TRC_SYM(sender_); \
@@ -1173,7 +1178,7 @@ extern "C" {
             RKH_TRC_BEGIN_WOAOSIG_NOCRIT(RKH_TE_FWK_GC) \
                 RKH_TRC_SIG((evt_)->e); \
                 RKH_TRC_UI8(poolID_); \
-                RKH_TRC_UI8(refCnt_); \
+                RKH_TRC_NREF(refCnt_); \
             RKH_TRC_END_NOCRIT()
 
         /**
@@ -1198,8 +1203,8 @@ extern "C" {
         #define RKH_TR_FWK_GCR(evt_, nUsed_, nMin_, sender_) \
             RKH_TRC_BEGIN_WOAOSIG_NOCRIT(RKH_TE_FWK_GCR) \
                 RKH_TRC_SIG((evt_)->e); \
-                RKH_TRC_UI8((evt_)->pool - 1); \
-                RKH_TRC_UI8((evt_)->nref); \
+                RKH_TRC_UI8(RKH_EVT_POOL_ID(evt_) - 1); \
+                RKH_TRC_NREF((evt_)->nref); \
                 RKH_TRC_NBLK(nUsed_); \
                 RKH_TRC_MP_NMIN(nMin_); \
                 RKH_TRC_SYM(sender_); \
@@ -1466,6 +1471,16 @@ extern "C" {
 
         /* --- Trace configuration ------------------------------------- */
 
+        /** Version of the extension of the RKH_TE_FWK_TCFG record */
+        #define RKH_TRC_TCFG_VERSION    1u
+
+        /** 
+         *  True if the RKH_TE_FWK_TCFG record carries its extension, see 
+         *  RKH_TR_FWK_TCFG()
+         */
+        #define RKH_TRC_TCFG_EXT(timeStamp_) \
+            (((timeStamp_) > 0xFFFFul) || (RKH_CFG_FWK_SIZEOF_NREF != 8))
+
         /**
          *  \brief
          *	Send trace configuration to Trazer.
@@ -1503,7 +1518,8 @@ extern "C" {
          *  [ 3,15: 1] - RKH_CFG_TRC_NSEQ_EN \n
          *  [ 4,16: 1] - RKH_CFG_TRC_TSTAMP_EN \n
          *  [ 4,17: 1] - RKH_CFG_TRC_CHK_EN \n
-         *  [ 4,18:14] - 0 (Reserved) \n
+         *  [ 4,18: 1] - Extension, see below \n
+         *  [ 4,19:13] - 0 (Reserved) \n
          *  [ 6, 0: 4] - RKH_CFG_FWK_SIZEOF_EVT \n
          *  [ 6, 4: 4] - RKH_CFGPORT_TRC_SIZEOF_TSTAMP \n
          *  [ 7, 0: 4] - RKH_CFGPORT_TRC_SIZEOF_PTR \n
@@ -1514,7 +1530,20 @@ extern "C" {
          *  [ 9, 4: 4] - 0 (Reserved) \n
          *  [10, 0: 4] - RKH_CFG_MP_SIZEOF_BSIZE \n
          *  [10, 4: 4] - RKH_CFG_FWK_MAX_EVT_POOL \n
-         *  [11, 0:16] - Timestamp HZ (ticks per second)
+         *  [11, 0:16] - Timestamp HZ (ticks per second), 0 if it does not 
+         *               fit in 16 bits \n
+         *
+         *  The extension follows only if its flag is set, that is, if the 
+         *  timestamp rate does not fit in 16 bits or #RKH_CFG_FWK_SIZEOF_NREF 
+         *  is not 8. Otherwise, the record keeps its original layout.
+         *
+         *  [13, 0: 8] - Version of the extension, RKH_TRC_TCFG_VERSION \n
+         *  [14, 0: 4] - RKH_CFG_FWK_SIZEOF_NREF \n
+         *  [14, 4: 4] - 0 (Reserved) \n
+         *  [15, 0:64] - Timestamp HZ (ticks per second), starting from the 
+         *               least significant word
+         *
+         *  A later version of the extension only appends fields to it.
          */
         #define RKH_TR_FWK_TCFG(timeStamp_) \
             RKH_TRC_BEGIN_DFT(RKH_TE_FWK_TCFG) \
@@ -1538,7 +1567,8 @@ extern "C" {
                         ((rui32_t)RKH_CFG_TRC_RTFIL_SIGNAL_EN << 14) | \
                         ((rui32_t)RKH_CFG_TRC_NSEQ_EN << 15) | \
                         ((rui32_t)RKH_CFG_TRC_TSTAMP_EN << 16) | \
-                        ((rui32_t)RKH_CFG_TRC_CHK_EN << 17))); \
+                        ((rui32_t)RKH_CFG_TRC_CHK_EN << 17) | \
+                        ((rui32_t)RKH_TRC_TCFG_EXT(timeStamp_) << 18))); \
                 RKH_TRC_UI8( \
                     (rui8_t)((RKH_CFG_FWK_SIZEOF_EVT / 8 << 4) | \
                              RKH_CFGPORT_TRC_SIZEOF_TSTAMP / 8)); \
@@ -1554,7 +1584,15 @@ extern "C" {
                     (rui8_t)((RKH_CFG_MP_SIZEOF_BSIZE / 8 << 4) | \
                              RKH_CFG_FWK_MAX_EVT_POOL)); \
                 RKH_TRC_UI16( \
-                    (rui16_t)(timeStamp_)); \
+                    (rui16_t)(((timeStamp_) <= 0xFFFFul) ? \
+                              (timeStamp_) : 0)); \
+                if (RKH_TRC_TCFG_EXT(timeStamp_)) \
+                { \
+                    RKH_TRC_UI8(RKH_TRC_TCFG_VERSION); \
+                    RKH_TRC_UI8((rui8_t)(RKH_CFG_FWK_SIZEOF_NREF / 8)); \
+                    RKH_TRC_UI32((rui32_t)(timeStamp_)); \
+                    RKH_TRC_UI32((rui32_t)(((timeStamp_) >> 16) >> 16)); \
+                } \
             RKH_TRC_END_DFT() \
             RKH_TRC_FLUSH()
 
@@ -1832,6 +1870,63 @@ extern "C" {
             } \
             while (0)
 
+        /**
+         *  \brief
+         *	Number of trace records lost because of an overflow.
+         *
+         *  \description    Number of trace records lost because of an 
+         *                  overflow
+         *  \trcGroup       RKH_TG_FWK
+         *  \trcEvent       RKH_TE_FWK_TRCLOST
+         *
+         *  \param[in] nLost_   Number of records discarded since the trace 
+         *                      was initialized, see rkh_trc_get_lost().
+         *
+         *  \note
+         *  This record is inserted by the trace module itself, before the 
+         *  first record that follows an overflow, as soon as there is room 
+         *  enough for it. It is not filtered. Since the count is 
+         *  cumulative, the trace analyzer gets the number of records lost 
+         *  between two reports from their difference, even if the report 
+         *  in between was removed by an overflow.
+         */
+        #define RKH_TR_FWK_TRCLOST(nLost_) \
+            RKH_TRC_BEGIN_WOFIL(RKH_TE_FWK_TRCLOST) \
+                RKH_TRC_UI32(nLost_); \
+            RKH_TRC_END_WOFIL()
+
+        /**
+         *  \brief
+         *	Dictionary of symbols.
+         *
+         *  \description    Dictionary of symbols
+         *  \trcGroup       RKH_TG_FWK
+         *  \trcEvent       RKH_TE_FWK_SYMDICT
+         *
+         *  Sends the symbols collected since the trace was initialized, 
+         *  such as objects, signals, active objects and states, as 
+         *  RKH_TE_FWK_SYMDICT records, followed by a single flush. Each 
+         *  record holds as many symbols as fit into the trace stream, or 
+         *  into a lane (see #RKH_CFG_TRC_LOCAL_EN), even if all of its 
+         *  bytes were escaped. Each symbol is its trace 
+         *  event ID, i.e. RKH_TE_FWK_OBJ, RKH_TE_FWK_SIG, RKH_TE_FWK_FUN, 
+         *  RKH_TE_FWK_AO, RKH_TE_FWK_STATE, RKH_TE_FWK_PSTATE, 
+         *  RKH_TE_FWK_TIMER, RKH_TE_FWK_QUEUE or RKH_TE_FWK_ACTOR, followed 
+         *  by the arguments of its symbol record. From then on, each symbol 
+         *  is sent by its own record.
+         *
+         *  \note
+         *  It is called by RKH_TR_FWK_EN(), when the framework starts. The 
+         *  names of the collected symbols must be kept until then.
+         *  Only available if #RKH_CFG_TRC_SYMDICT_EN is set to 1.
+         */
+        #if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+            #define RKH_TR_FWK_SYMDICT() \
+                rkh_trc_symDict()
+        #else
+            #define RKH_TR_FWK_SYMDICT()                            (void)0
+        #endif
+
         /** @} doxygen end group definition */
         /** @} doxygen end group definition */
     #else
@@ -1859,6 +1954,8 @@ extern "C" {
         #define RKH_TR_FWK_EPOOL(evtPoolObj_)                       (void)0
         #define RKH_TR_FWK_QUEUE(queueObj_)                         (void)0
         #define RKH_TR_FWK_ACTOR(actObj_, nm_)                      (void)0
+        #define RKH_TR_FWK_TRCLOST(nLost_)                          (void)0
+        #define RKH_TR_FWK_SYMDICT()                                (void)0
     #endif
 #else
     /* --- Memory Pool (MP) -------------------------------------------- */
@@ -1939,9 +2036,18 @@ extern "C" {
     #define RKH_TR_FWK_EPOOL(__epo)                   (void)0
     #define RKH_TR_FWK_QUEUE(__qo)                    (void)0
     #define RKH_TR_FWK_ACTOR(actObj_, nm_)            (void)0
+    #define RKH_TR_FWK_TRCLOST(nLost_)                (void)0
+    #define RKH_TR_FWK_SYMDICT()                      (void)0
 #endif
 
 /* -------------------------------- Constants ------------------------------ */
+/**
+ *  \brief
+ *  Value returned by rkh_trc_getLane() when the caller is not an active 
+ *  object, thus its records are written into the shared lane.
+ */
+#define RKH_TRC_NO_LANE         0xFF
+
 /* ------------------------------- Data types ------------------------------ */
 /* -------------------------- External variables --------------------------- */
 /* -------------------------- Function prototypes -------------------------- */
@@ -1968,6 +2074,10 @@ void rkh_trc_init(void);
  *	- Timestamp [1, 2 or 4 bytes]. If the RKH_CFG_TRC_TSTAMP_EN is set to 1
  *	then RKH will add to the trace record a timestamp field. It's
  *	configurable by means of RKH_CFGPORT_TRC_SIZEOF_TSTAMP.
+ *	If the RKH_CFG_TRC_COMPACT_EN is set to 1 then it is the varint of 
+ *	the difference from the timestamp of the previous record, except in 
+ *	the records whose sequence number is 0 and in RKH_TE_FWK_TRCLOST, 
+ *	which carry the absolute one.
  *
  *	\param[in] eid		trace event ID. The available events are
  *                      enumerated in RKH_TE_<group>_<event> definitions.
@@ -2048,7 +2158,9 @@ void rkh_trc_str(const char *s);
  *
  *  \note
  *  This function is internal to RKH and the user application should
- *  not call it.
+ *  not call it. If the #RKH_CFG_TRC_SYMDICT_EN is enabled, the symbols 
+ *  of rkh_trc_obj(), rkh_trc_sig(), rkh_trc_ao() and rkh_trc_state() 
+ *  are collected until RKH_TR_FWK_SYMDICT() sends them.
  */
 void rkh_trc_obj(RKH_TE_ID_T tre, rui8_t *obj, const char *obj_name);
 
@@ -2090,6 +2202,78 @@ void rkh_trc_ao(void *ao);
  */
 void rkh_trc_state(void *ao, rui8_t *state);
 
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Output the collected symbols as dictionary records and stop collecting 
+ *  them, see RKH_TR_FWK_SYMDICT().
+ *
+ *  \note
+ *  This function should be called indirectly through the macro 
+ *  RKH_TR_FWK_SYMDICT().
+ */
+void rkh_trc_symDict(void);
+#endif
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Store a 32-bit data as a LEB128 varint, that is, 7 bits per byte 
+ *  starting from the least significant ones. The most significant bit of 
+ *  each byte is set when another byte follows.
+ *
+ *  \param[in] d		data
+ */
+void rkh_trc_varint(rui32_t d);
+
+/**
+ *  \brief
+ *  Store an object address by means of its interned ID, that is, the 
+ *  varint ID sent by the symbol record of the object. An object without 
+ *  ID is sent as the ID 0 followed by the varint of its address.
+ *
+ *  \param[in] sym		address of the object.
+ *
+ *  \note
+ *  This function should be called indirectly through the macros 
+ *  RKH_TRC_SYM() and RKH_TRC_FUN().
+ */
+void rkh_trc_sym(rui32_t sym);
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Moves the trace records from the lanes to the trace stream, in 
+ *  timestamp order, encoding them as usual.
+ *
+ *  Each active object writes its records into its own lane without 
+ *  locking, whereas the remaining threads share a lane protected by the 
+ *  critical section. A record is merged once it is complete, thus a 
+ *  record still being written is merged by the next call. The merge 
+ *  stops when the trace stream has no room for the next record, which 
+ *  stays in its lane.
+ *
+ *  \note
+ *  It must be called by only one thread at a time, usually from 
+ *  rkh_trc_flush() before calling rkh_trc_get_block(), within the same 
+ *  critical section.
+ */
+void rkh_trc_merge(void);
+
+/**
+ *  \brief
+ *  Returns the trace lane of the caller, that is, the priority of the 
+ *  active object that runs on the calling thread, or RKH_TRC_NO_LANE 
+ *  when the caller is not an active object.
+ *
+ *  \note
+ *  Platform-dependent function. Only the win32_mt port provides it, thus 
+ *  #RKH_CFG_TRC_LOCAL_EN cannot be enabled on the other ones.
+ */
+rui8_t rkh_trc_getLane(void);
+#endif
+
 /**
  *  \brief
  *  Store a 8-bit data into the current trace event buffer with format
@@ -62,7 +62,43 @@ extern "C" {
 
 /* --------------------------------- Macros -------------------------------- */
 /* -------------------------------- Constants ------------------------------ */
+/**
+ *  \brief
+ *  Value of the magic field of a mapped trace stream, "RKHM", once 
+ *  rkh_trcStream_init() has initialized it.
+ */
+#define RKH_TRC_MAP_MAGIC       0x524B484Dul
+
 /* ------------------------------- Data types ------------------------------ */
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Layout of the memory of a mapped trace stream, see 
+ *  RKH_CFG_TRC_STREAM_MAP_EN.
+ *
+ *  The header is updated as the stream is written and read, thus it 
+ *  always describes the stream, even if the program stops suddenly. The 
+ *  most recent bytes of the stream are those before \a head, up to 
+ *  \a size bytes if \a lap is not 0, otherwise from the beginning of the 
+ *  stream. Since the oldest of them could be a part of a record, the 
+ *  recovered stream begins at their first RKH_FLG byte.
+ *
+ *  \note
+ *  The fields have the size and byte order of rui32_t in the port, thus 
+ *  a mapped stream is read by a program built for the same platform.
+ */
+typedef struct RKH_TRC_MAP_T
+{
+    rui32_t magic;      /** RKH_TRC_MAP_MAGIC if initialized */
+    rui32_t size;       /** Size of the stream in bytes */
+    rui32_t head;       /** Offset of the next byte to be written */
+    rui32_t tail;       /** Offset of the next byte to be retrieved */
+    rui32_t lap;        /** Number of times the head wrapped around */
+    rui32_t lost;       /** Number of lost records, see rkh_trc_get_lost() */
+    rui8_t stream[RKH_CFG_TRC_SIZEOF_STREAM];   /** Trace stream */
+} RKH_TRC_MAP_T;
+#endif
+
 /* -------------------------- External variables --------------------------- */
 /* -------------------------- Function prototypes -------------------------- */
 /**
@@ -74,6 +110,19 @@ extern "C" {
  */
 void rkh_trcStream_init(void);
 
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+/**
+ *  \brief
+ *  Sets the memory of the trace stream, when RKH_CFG_TRC_STREAM_MAP_EN is 
+ *  enabled. It must be called before rkh_trcStream_init(), which 
+ *  initializes its header.
+ *
+ *  \param[in] map	pointer to the memory of the trace stream, such as a 
+ *                  file mapped into memory.
+ */
+void rkh_trcStream_map(RKH_TRC_MAP_T *map);
+#endif
+
 /**
  *  \brief
  *	Retrieves a pointer to oldest stored byte in the trace stream.
@@ -123,6 +172,13 @@ rui8_t *rkh_trc_get_block(TRCQTY_T *nget);
  *  \brief
  *  Put a data byte into the trace stream.
  *
+ *  The stream keeps whole records, which end with the raw flag byte 
+ *  RKH_FLG. When a record does not fit, either the oldest records are 
+ *  removed to make room for it, or the record itself is discarded if 
+ *  RKH_CFG_TRC_OVF_DROP_NEWEST_EN is enabled. A record longer than the 
+ *  stream is always discarded. Every removed or discarded record is counted 
+ *  as a lost record, see rkh_trc_get_lost().
+ *
  *  \param[in] b	data to be written in the trace stream.
  *
  *  \note
@@ -132,6 +188,49 @@ rui8_t *rkh_trc_get_block(TRCQTY_T *nget);
  */
 void rkh_trc_put(rui8_t b);
 
+/**
+ *  \brief
+ *  Put a block of data bytes into the trace stream, in at most two runs 
+ *  (before and after wrapping around), with the same result as calling 
+ *  rkh_trc_put() for each byte. The block holds at most one flag byte, 
+ *  which must be its last one. Records are admitted or discarded as a 
+ *  whole, as explained in rkh_trc_put().
+ *
+ *  \param[in] blk	pointer to the data to be written in the trace stream.
+ *  \param[in] n	number of bytes.
+ *
+ *  \note
+ *  rkh_trc_put_block() is NOT protected with a critical section.
+ */
+void rkh_trc_put_block(const rui8_t *blk, TRCQTY_T n);
+
+/**
+ *  \brief
+ *  Get the number of free bytes in the trace stream, that is, the bytes 
+ *  that can be put into it without overwriting the oldest ones.
+ *
+ *  \return
+ *  Number of free bytes.
+ *
+ *  \note
+ *  rkh_trc_get_room() is NOT protected with a critical section.
+ */
+TRCQTY_T rkh_trc_get_room(void);
+
+/**
+ *  \brief
+ *  Get the number of records lost because of an overflow of the trace 
+ *  stream since it was initialized. The count wraps around, thus the 
+ *  number of records lost between two readings is their difference.
+ *
+ *  \return
+ *  Number of lost records.
+ *
+ *  \note
+ *  rkh_trc_get_lost() is NOT protected with a critical section.
+ */
+rui32_t rkh_trc_get_lost(void);
+
 /* -------------------- External C language linkage end -------------------- */
 #ifdef __cplusplus
 }
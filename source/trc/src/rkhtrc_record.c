@@ -49,6 +49,7 @@
 
 /* --------------------------------- Notes --------------------------------- */
 /* ----------------------------- Include files ----------------------------- */
+#include <string.h>
 #include "rkhtrc_record.h"
 #include "rkhtrc_stream.h"
 #include "rkhtrc_filter.h"
@@ -75,6 +76,9 @@ RKH_MODULE_NAME(rkhtrc_record)
     #elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 32
         #define RKH_TRC_TSTAMP() \
             RKH_TRC_UI32(rkh_trc_getts())
+    #elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+        #define RKH_TRC_TSTAMP() \
+            tsPut(rkh_trc_getts())
     #else
         #define RKH_TRC_TSTAMP() \
             RKH_TRC_UI16(rkh_trc_getts())
@@ -83,15 +87,753 @@ RKH_MODULE_NAME(rkhtrc_record)
     #define RKH_TRC_TSTAMP()
 #endif
 
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+    /* Makes room for n_ bytes, committing the record encoded so far */
+    #define RKH_TRC_ROOM(n_) \
+        if ((recIn + (n_)) > &rec[RKH_TRC_SIZEOF_RECORD]) \
+        { \
+            rkh_trc_put_block(enc, encode()); \
+        }
+
+    /* 
+     * The fields are stored into the record buffer as whole words on 
+     * little-endian targets, whose byte order is the one of the trace 
+     * stream, otherwise byte by byte.
+     */
+    #ifndef RKH_TRC_WORD_STORE
+        #if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && \
+            (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+            #define RKH_TRC_WORD_STORE  1
+        #else
+            #define RKH_TRC_WORD_STORE  0
+        #endif
+    #endif
+#endif
+
+/* Size [in bytes] of the event ID and the timestamp in a record */
+#if RKH_CFG_TRC_SIZEOF_TE_ID == 16
+    #define RKH_TRC_SIZEOF_EID      2u
+#elif RKH_CFG_TRC_SIZEOF_TE_ID == 32
+    #define RKH_TRC_SIZEOF_EID      4u
+#else
+    #define RKH_TRC_SIZEOF_EID      1u
+#endif
+
+#if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 8
+    #define RKH_TRC_SIZEOF_TS       1u
+#elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 32
+    #define RKH_TRC_SIZEOF_TS       4u
+#elif RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+    #define RKH_TRC_SIZEOF_TS       8u
+#else
+    #define RKH_TRC_SIZEOF_TS       2u
+#endif
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+    /* The varint of a timestamp takes 7 bits per byte */
+    #define RKH_TRC_SIZEOF_TSFLD    (((8u * RKH_TRC_SIZEOF_TS) + 6u) / 7u)
+
+    /* The varint of a 64 bits timestamp does not fit in rkh_trc_varint() */
+    #if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+        #define RKH_TRC_TS_VARINT(d_)   tsVarint(d_)
+    #else
+        #define RKH_TRC_TS_VARINT(d_)   rkh_trc_varint(d_)
+    #endif
+
+    /* Slot of the symbol table where the lookup of the address s_ starts */
+    #define RKH_TRC_SYM_HASH(s_) \
+        ((rui16_t)(((rui32_t)(s_) * 0x9E3779B1ul) >> 24) & \
+         (RKH_CFG_TRC_SIZEOF_SYMTBL - 1))
+#else
+    #define RKH_TRC_SIZEOF_TSFLD    RKH_TRC_SIZEOF_TS
+#endif
+
+/* 
+ * Worst case size of the RKH_TE_FWK_TRCLOST record, whose bytes could be 
+ * all escaped: event ID, nseq, timestamp, count and checksum, plus the flag
+ */
+#define RKH_TRC_SIZEOF_LOST \
+    ((2u * (RKH_TRC_SIZEOF_EID + 1u + RKH_TRC_SIZEOF_TSFLD + 4u + 1u)) + 1u)
+
+/* 
+ * Inserts the address of an object into its symbol record. The compact 
+ * encoding also interns the object, see symDef().
+ */
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+    #define RKH_TRC_SYM_DEF(sym) \
+        symDef((rui32_t)sym)
+#else
+    #define RKH_TRC_SYM_DEF(sym) \
+        RKH_TRC_SYM(sym)
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+    /* Lane written by the callers that are not active objects */
+    #define RKH_TRC_SHARED_LANE     RKH_CFG_FWK_MAX_SMA
+
+    /* Header of a record in a lane: size, kind, event ID and timestamp */
+    #define RKH_TRC_LANE_HDR        (3u + RKH_TRC_SIZEOF_EID + \
+                                     RKH_TRC_SIZEOF_TS)
+
+    /* Kinds of record, see rkh_trc_begin() and rkh_trc_clear_chk() */
+    #define RKH_TRC_LANE_FULL       0u  /* event ID, nseq and timestamp */
+    #define RKH_TRC_LANE_RAW        1u  /* only the stored fields */
+
+    #define RKH_TRC_TS_MASK \
+        ((rui32_t)0xFFFFFFFFul >> (32 - (8 * RKH_TRC_SIZEOF_TS)))
+
+    /* True if the timestamp a_ is older than b_, even if it wrapped */
+    #define RKH_TRC_TS_DIFF(a_, b_) \
+        (((rui32_t)(b_) - (rui32_t)(a_)) & RKH_TRC_TS_MASK)
+    #define RKH_TRC_TS_BEFORE(a_, b_) \
+        ((RKH_TRC_TS_DIFF(a_, b_) != 0) && \
+         (RKH_TRC_TS_DIFF(a_, b_) <= (RKH_TRC_TS_MASK >> 1)))
+
+    /* 
+     * Orders the accesses to a lane between its writer and the merge. The 
+     * port defines it when its CPU does not keep the order of the stores.
+     */
+    #ifndef RKH_TRC_MEMBAR
+    #define RKH_TRC_MEMBAR()        (void)0
+    #endif
+#endif
+
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+    /* 
+     * Worst case size of the arguments of a symbol in the dictionary, see 
+     * symbol(), without its name
+     */
+    #if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+        #define RKH_TRC_SIZEOF_SYMARG   (2u * (3u + 5u))    /* ID, address */
+    #else
+        #define RKH_TRC_SIZEOF_SYMARG   (2u * 4u)
+    #endif
+
+    /* 
+     * Byte budget of the symbols of a RKH_TE_FWK_SYMDICT record, so that 
+     * the record fits into the trace stream even if all of its bytes are 
+     * escaped, and into a lane, whose bytes are escaped while merging
+     */
+    #define RKH_TRC_SYMDICT_STREAM \
+        (((RKH_CFG_TRC_SIZEOF_STREAM - 1u) / 2u) - \
+         (RKH_TRC_SIZEOF_EID + 1u + RKH_TRC_SIZEOF_TSFLD + 1u))
+    #if (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED) && \
+        ((RKH_CFG_TRC_SIZEOF_LOCAL_STREAM - 1u - RKH_TRC_LANE_HDR) < \
+         RKH_TRC_SYMDICT_STREAM)
+        #define RKH_TRC_SYMDICT_BUDGET \
+            (RKH_CFG_TRC_SIZEOF_LOCAL_STREAM - 1u - RKH_TRC_LANE_HDR)
+    #else
+        #define RKH_TRC_SYMDICT_BUDGET  RKH_TRC_SYMDICT_STREAM
+    #endif
+#endif
+
 /* ------------------------------- Constants ------------------------------- */
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+/* 
+ * Size of the record buffer. It holds the usual records entirely, longer 
+ * ones, such as the symbol strings, are committed in pieces.
+ */
+#ifndef RKH_TRC_SIZEOF_RECORD
+#define RKH_TRC_SIZEOF_RECORD   32u
+#endif
+#endif
+
 /* ---------------------------- Local data types --------------------------- */
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+/*
+ * Single-producer single-consumer ring of trace records. The writer owns 
+ * 'in' and the record being written, whereas the merge owns 'out'. Each 
+ * record is stored as a header, see RKH_TRC_LANE_HDR, followed by its raw 
+ * fields, which are escaped while merging.
+ */
+typedef struct TrcLane
+{
+    rui8_t stm[RKH_CFG_TRC_SIZEOF_LOCAL_STREAM];
+    volatile rui16_t in;    /* end of the published records */
+    volatile rui16_t out;   /* start of the records to be merged */
+    rui16_t start;          /* start of the record being written */
+    rui16_t wr;             /* next byte of the record being written */
+    rui16_t room;           /* free bytes left for the record */
+    rui8_t drop;            /* the record does not fit, discard it */
+    volatile rui32_t lost;  /* count of discarded records */
+    rui8_t kind;
+    RKH_TE_ID_T eid;
+    RKH_TS_T ts;
+} TrcLane;
+#endif
+
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+/* Symbol collected into the dictionary, see rkh_trc_symDict() */
+typedef struct TrcSym
+{
+    RKH_TE_ID_T eid;        /* event ID of its symbol record */
+    rui32_t ao;             /* active object of a state */
+    rui32_t sym;            /* address of the object or signal */
+    const char *name;
+} TrcSym;
+#endif
+
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
 static rui8_t chk;
 static rui8_t nseq;
+static rui32_t lostSent;    /* count of lost records already reported */
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+static rui32_t syms[RKH_CFG_TRC_SIZEOF_SYMTBL]; /* interned addresses */
+#endif
+#if ((RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED) && \
+     (RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED)) || \
+    (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED)
+static RKH_TS_T tsLast;     /* timestamp of the previous record */
+#endif
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+static rui8_t rec[RKH_TRC_SIZEOF_RECORD];   /* raw fields of the record */
+static rui8_t *recIn;
+static rui8_t enc[(2 * RKH_TRC_SIZEOF_RECORD) + 3]; /* escaped, chk and flag */
+#endif
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+static TrcLane lanes[RKH_CFG_FWK_MAX_SMA + 1];
+#endif
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+static TrcSym dict[RKH_CFG_TRC_SIZEOF_SYMDICT];
+static rui8_t ndict;
+static rbool_t dictOpen;    /* the symbols are collected into dict[] */
+#endif
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+#if (RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED) && \
+    (RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64) && \
+    (RKH_CFG_TRC_COMPACT_EN == RKH_DISABLED)
+/* Inserts a 64 bits timestamp, starting from the least significant word */
+static void
+tsPut(RKH_TS_T ts)
+{
+    RKH_TRC_UI32((rui32_t)ts);
+    RKH_TRC_UI32((rui32_t)(ts >> 32));
+}
+#endif
+
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+/*
+ * Escapes the buffered fields into enc[] and accumulates them into the 
+ * checksum in a single pass, then empties the record buffer. Returns the 
+ * number of encoded bytes.
+ *
+ * The pass has no branches: every byte is written as the pair 
+ * (escape or byte, escaped byte), and the output only advances over the 
+ * second one when the byte had to be escaped.
+ */
+static TRCQTY_T
+encode(void)
+{
+    const rui8_t *src, *end;
+    rui8_t *out;
+    rui8_t d, sum, esc;
+
+    /* locals, so that the byte stores do not force to reload the globals */
+    sum = chk;
+    end = recIn;
+    for (src = rec, out = enc; src < end; ++src)
+    {
+        d = *src;
+        sum = (rui8_t)(sum + d);
+        esc = (rui8_t)((d == RKH_FLG) | (d == RKH_ESC));
+        out[0] = (esc != 0) ? RKH_ESC : d;
+        out[1] = (rui8_t)(d ^ RKH_XOR);
+        out += 1 + esc;
+    }
+    chk = sum;
+    recIn = rec;
+    return (TRCQTY_T)(out - enc);
+}
+#endif
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+#if RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED
+/*
+ * Returns the timestamp field of a record, that is, the difference from 
+ * the timestamp of the previous record. The decoder resynchronizes by 
+ * the records that carry the absolute timestamp, see rkh_trc_begin().
+ */
+static RKH_TS_T
+tsField(RKH_TS_T ts, rbool_t sync)
+{
+    RKH_TS_T d;
+
+    d = sync ? ts : (RKH_TS_T)(ts - tsLast);
+    tsLast = ts;
+    return d;
+}
+
+#if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+static void
+tsVarint(RKH_TS_T d)
+{
+    for (; d > 0x7F; d >>= 7)
+    {
+        rkh_trc_u8((rui8_t)((d & 0x7F) | 0x80));
+    }
+    rkh_trc_u8((rui8_t)d);
+}
+#endif
+#endif
+
+/*
+ * Looks for an address in the symbol table by open addressing, adding it 
+ * if required. Returns its interned ID, that is, the slot plus one, or 0 
+ * when it is not there and it could not be added.
+ */
+static rui16_t
+symFind(rui32_t sym, rbool_t add)
+{
+    rui16_t ix, n;
+
+    if (sym == 0)
+    {
+        return 0;
+    }
+    ix = RKH_TRC_SYM_HASH(sym);
+    for (n = RKH_CFG_TRC_SIZEOF_SYMTBL; n != 0; --n)
+    {
+        if (syms[ix] == sym)
+        {
+            return (rui16_t)(ix + 1);
+        }
+        if (syms[ix] == 0)
+        {
+            if (add)
+            {
+                syms[ix] = sym;
+                return (rui16_t)(ix + 1);
+            }
+            break;
+        }
+        ix = (rui16_t)((ix + 1) & (RKH_CFG_TRC_SIZEOF_SYMTBL - 1));
+    }
+    return 0;
+}
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+static TrcLane *
+getLane(void)
+{
+    rui8_t ix;
+
+    ix = rkh_trc_getLane();
+    return &lanes[(ix < RKH_CFG_FWK_MAX_SMA) ? ix : RKH_TRC_SHARED_LANE];
+}
+
+static rui16_t
+laneNext(rui16_t pos, rui16_t n)
+{
+    pos = (rui16_t)(pos + n);
+    if (pos >= RKH_CFG_TRC_SIZEOF_LOCAL_STREAM)
+    {
+        pos -= RKH_CFG_TRC_SIZEOF_LOCAL_STREAM;
+    }
+    return pos;
+}
+
+static rui16_t
+laneStore(TrcLane *lane, rui16_t pos, rui32_t d, rui8_t n)
+{
+    for (; n != 0; --n, d >>= 8)
+    {
+        lane->stm[pos] = (rui8_t)d;
+        pos = laneNext(pos, 1);
+    }
+    return pos;
+}
+
+static rui32_t
+laneLoad(const TrcLane *lane, rui16_t pos, rui8_t n)
+{
+    rui32_t d;
+    rui8_t i;
+
+    for (d = 0, i = 0; i < n; ++i)
+    {
+        d |= (rui32_t)lane->stm[pos] << (8 * i);
+        pos = laneNext(pos, 1);
+    }
+    return d;
+}
+
+/*
+ * Starts a record in the lane of the caller. The writers of the shared 
+ * lane are serialized by means of the critical section, which is held 
+ * until the record is closed.
+ */
+static void
+laneOpen(TrcLane *lane, rui8_t kind, RKH_TE_ID_T eid)
+{
+    rui16_t in, out, room;
+    RKH_SR_ALLOC();
+
+    if (lane == &lanes[RKH_TRC_SHARED_LANE])
+    {
+        RKH_ENTER_CRITICAL_();
+    }
+
+    lane->kind = kind;
+    lane->eid = eid;
+    lane->ts = rkh_trc_getts();
+
+    /* one byte is kept free to tell a full lane from an empty one */
+    in = lane->in;
+    out = lane->out;
+    if (out > in)
+    {
+        room = (rui16_t)(out - in - 1);
+    }
+    else
+    {
+        room = (rui16_t)(RKH_CFG_TRC_SIZEOF_LOCAL_STREAM - (in - out) - 1);
+    }
+
+    lane->start = in;
+    if (room < RKH_TRC_LANE_HDR)
+    {
+        lane->drop = 1;
+        lane->room = 0;
+    }
+    else
+    {
+        lane->drop = 0;
+        lane->room = (rui16_t)(room - RKH_TRC_LANE_HDR);
+        lane->wr = laneNext(in, RKH_TRC_LANE_HDR);
+    }
+}
+
+static void
+lanePut(TrcLane *lane, rui8_t d)
+{
+    if (lane->room != 0)
+    {
+        lane->stm[lane->wr] = d;
+        lane->wr = laneNext(lane->wr, 1);
+        --lane->room;
+    }
+    else
+    {
+        lane->drop = 1;
+    }
+}
+
+/* Publishes the record, unless it did not fit in the lane */
+static void
+laneClose(TrcLane *lane)
+{
+    rui16_t pos, size;
+    RKH_SR_ALLOC();
+
+    if (lane->drop == 0)
+    {
+        size = (rui16_t)(laneNext(lane->wr, 
+                                  RKH_CFG_TRC_SIZEOF_LOCAL_STREAM - 
+                                  lane->start) - RKH_TRC_LANE_HDR);
+        pos = laneStore(lane, lane->start, size, 2);
+        pos = laneStore(lane, pos, lane->kind, 1);
+        pos = laneStore(lane, pos, (rui32_t)lane->eid, RKH_TRC_SIZEOF_EID);
+        (void)laneStore(lane, pos, (rui32_t)lane->ts, RKH_TRC_SIZEOF_TS);
+
+        RKH_TRC_MEMBAR();       /* the record is complete before its use */
+        lane->in = lane->wr;
+    }
+    else
+    {
+        ++lane->lost;
+    }
+
+    if (lane == &lanes[RKH_TRC_SHARED_LANE])
+    {
+        RKH_EXIT_CRITICAL_();
+    }
+}
+
+/* Escapes and puts a field of n bytes into the trace stream */
+static void
+mergeField(rui32_t d, rui8_t n)
+{
+    rui8_t b;
+
+    for (; n != 0; --n, d >>= 8)
+    {
+        b = (rui8_t)d;
+        chk = (rui8_t)(chk + b);
+        if ((b == RKH_FLG) || (b == RKH_ESC))
+        {
+            rkh_trc_put(RKH_ESC);
+            rkh_trc_put((rui8_t)(b ^ RKH_XOR));
+        }
+        else
+        {
+            rkh_trc_put(b);
+        }
+    }
+}
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+/* Escapes and puts a varint field into the trace stream */
+static void
+mergeVarint(rui32_t d)
+{
+    for (; d > 0x7F; d >>= 7)
+    {
+        mergeField((d & 0x7F) | 0x80, 1);
+    }
+    mergeField(d, 1);
+}
+#endif
+
+/*
+ *  Reports the count of records discarded by the lanes and the trace 
+ *  stream, when it changed, as a RKH_TE_FWK_TRCLOST record. It is inserted 
+ *  only if it fits into the trace stream. Its timestamp is the one of the 
+ *  last merged record, since the records still in the lanes are older 
+ *  than the current time.
+ */
+static void
+mergeLost(void)
+{
+    TrcLane *lane;
+    rui32_t nLost;
+
+    nLost = rkh_trc_get_lost();
+    for (lane = lanes; lane < &lanes[RKH_CFG_FWK_MAX_SMA + 1]; ++lane)
+    {
+        nLost += lane->lost;
+    }
+    if ((nLost == lostSent) || (rkh_trc_get_room() < RKH_TRC_SIZEOF_LOST))
+    {
+        return;
+    }
+    lostSent = nLost;
+
+    chk = 0;
+    mergeField(RKH_TE_FWK_TRCLOST, RKH_TRC_SIZEOF_EID);
+#if RKH_CFG_TRC_NSEQ_EN == RKH_ENABLED
+    mergeField(nseq, 1);
+    ++nseq;
+#endif
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+    mergeVarint(tsField(tsLast, RKH_TRUE));
+#else
+    mergeField((rui32_t)tsLast, RKH_TRC_SIZEOF_TS);
+#endif
+    mergeField(nLost, 4);
+#if RKH_CFG_TRC_CHK_EN == RKH_ENABLED
+    chk = (rui8_t)(~chk + 1);
+    mergeField(chk, 1);
+#endif
+    rkh_trc_put(RKH_FLG);
+}
+#endif
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+/*
+ * Interns the object of a symbol record, then inserts its ID followed by 
+ * its address, so that the decoder maps the ID to the symbol. The ID 0 
+ * means that the symbol table is full. A symbol record of the shared lane 
+ * already holds the critical section.
+ */
+static void
+symDef(rui32_t sym)
+{
+    rui16_t id;
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+    rbool_t lock;
+    RKH_SR_ALLOC();
+
+    lock = (rbool_t)(getLane() != &lanes[RKH_TRC_SHARED_LANE]);
+    if (lock)
+    {
+        RKH_ENTER_CRITICAL_();
+    }
+#endif
+    id = symFind(sym, RKH_TRUE);
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+    if (lock)
+    {
+        RKH_EXIT_CRITICAL_();
+    }
+#endif
+    rkh_trc_varint(id);
+    rkh_trc_varint(sym);
+}
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_DISABLED
+/* Inserts the event ID, the sequence number and the timestamp */
+static void
+header(RKH_TE_ID_T eid)
+{
+#if (RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED) && \
+    (RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED)
+    rbool_t sync;
+
+    sync = (rbool_t)((nseq == 0) || (eid == RKH_TE_FWK_TRCLOST));
+#endif
+    chk = 0;            /* Initialize the trace record checksum */
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+    recIn = rec;
+#endif
+    RKH_TRC_TE_ID(eid); /* Insert the event ID */
+#if RKH_CFG_TRC_NSEQ_EN == RKH_ENABLED
+    rkh_trc_u8((rui8_t)(nseq)); /* Insert the sequence number */
+    ++nseq;
+#endif
+#if (RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED) && \
+    (RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED)
+    RKH_TRC_TS_VARINT(tsField(rkh_trc_getts(), sync));
+#else
+    RKH_TRC_TSTAMP();   /* Insert the timestamp */
+#endif
+}
+
+/*
+ *  Reports the count of records lost because of an overflow of the trace 
+ *  stream as a RKH_TE_FWK_TRCLOST record, only when it fits into the 
+ *  stream. The count is cumulative, thus a report removed by a later 
+ *  overflow does not hide any loss.
+ */
+static void
+putLost(void)
+{
+    if (rkh_trc_get_room() >= RKH_TRC_SIZEOF_LOST)
+    {
+        lostSent = rkh_trc_get_lost();
+        header(RKH_TE_FWK_TRCLOST);
+        rkh_trc_u32(lostSent);
+        rkh_trc_end();
+    }
+}
+#endif
+
+/* Inserts the arguments of the symbol record eid */
+static void
+symbol(RKH_TE_ID_T eid, rui32_t ao, rui32_t sym, const char *name)
+{
+    if (eid == RKH_TE_FWK_SIG)
+    {
+        RKH_TRC_SIG((RKH_SIG_T)sym);
+    }
+    else
+    {
+        if ((eid == RKH_TE_FWK_STATE) || (eid == RKH_TE_FWK_PSTATE))
+        {
+            RKH_TRC_SYM(ao);
+        }
+        RKH_TRC_SYM_DEF(sym);
+    }
+    RKH_TRC_STR(name);
+}
+
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+/* Worst case size of a symbol in the dictionary, see symbol() */
+static rui32_t
+dictEntrySize(const TrcSym *entry)
+{
+    const char *p;
+
+    for (p = entry->name; *p != '\0'; ++p)
+    {
+    }
+    return RKH_TRC_SIZEOF_EID + RKH_TRC_SIZEOF_SYMARG + 
+           (rui32_t)(p - entry->name) + 1u;
+}
+
+/*
+ * Sends the first n collected symbols in as many records as needed to fit 
+ * into the trace stream, each one within its own critical section. A 
+ * symbol longer than the budget is sent alone. Then, the dictionary is 
+ * emptied.
+ */
+static void
+dictSend(rui8_t n)
+{
+    const TrcSym *entry, *end;
+    rui32_t size, esize;
+
+    end = &dict[n];
+    for (entry = dict; entry < end; )
+    {
+        RKH_TRC_BEGIN_WOFIL(RKH_TE_FWK_SYMDICT)
+            for (size = 0; entry < end; ++entry)
+            {
+                esize = dictEntrySize(entry);
+                if ((size != 0) && ((size + esize) > RKH_TRC_SYMDICT_BUDGET))
+                {
+                    break;
+                }
+                size += esize;
+                RKH_TRC_TE_ID(entry->eid);
+                symbol(entry->eid, entry->ao, entry->sym, entry->name);
+            }
+        RKH_TRC_END_WOFIL()
+    }
+    RKH_TRC_FLUSH();
+
+    {
+        RKH_SR_ALLOC();
+
+        RKH_ENTER_CRITICAL_();
+        ndict = 0;
+        RKH_EXIT_CRITICAL_();
+    }
+}
+
+/*
+ * Collects a symbol into the dictionary, which is sent when it gets full. 
+ * Returns false if the dictionary was already sent or it is being sent, 
+ * since no symbol is collected until it is emptied.
+ */
+static rbool_t
+dictAdd(RKH_TE_ID_T eid, rui32_t ao, rui32_t sym, const char *name)
+{
+    TrcSym *entry;
+    rbool_t added, full;
+    RKH_SR_ALLOC();
+
+    full = RKH_FALSE;
+    RKH_ENTER_CRITICAL_();
+    added = (rbool_t)(dictOpen && (ndict < RKH_CFG_TRC_SIZEOF_SYMDICT));
+    if (added)
+    {
+        entry = &dict[ndict++];
+        entry->eid = eid;
+        entry->ao = ao;
+        entry->sym = sym;
+        entry->name = name;
+        full = (rbool_t)(ndict == RKH_CFG_TRC_SIZEOF_SYMDICT);
+    }
+    RKH_EXIT_CRITICAL_();
+
+    if (full)
+    {
+        dictSend(RKH_CFG_TRC_SIZEOF_SYMDICT);
+    }
+    return added;
+}
+#endif
+
+/* Sends a symbol by its own record, unless it is collected */
+static void
+putSymbol(RKH_TE_ID_T eid, rui32_t ao, rui32_t sym, const char *name)
+{
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+    if (dictAdd(eid, ao, sym, name) == RKH_FALSE)
+#endif
+    {
+        RKH_TRC_BEGIN_WOFIL(eid)
+            symbol(eid, ao, sym, name);
+        RKH_TRC_END_WOFIL()
+        RKH_TRC_FLUSH();
+    }
+}
+
 /* ---------------------------- Global functions --------------------------- */
 void
 rkh_trc_init(void)
@@ -99,20 +841,262 @@ rkh_trc_init(void)
     rkh_trcStream_init();
     nseq = 0;
     chk = 0;
+    lostSent = 0;
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+    recIn = rec;
+#endif
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+    ndict = 0;
+    dictOpen = RKH_TRUE;
+#endif
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+    {
+        rui32_t *sym;
+
+        for (sym = syms; sym < &syms[RKH_CFG_TRC_SIZEOF_SYMTBL]; ++sym)
+        {
+            *sym = 0;
+        }
+    }
+#endif
+#if ((RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED) && \
+     (RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED)) || \
+    (RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED)
+    tsLast = 0;
+#endif
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+    {
+        TrcLane *lane;
+
+        for (lane = lanes; lane < &lanes[RKH_CFG_FWK_MAX_SMA + 1]; ++lane)
+        {
+            lane->in = lane->out = 0;
+            lane->lost = 0;
+        }
+    }
+#endif
 }
 
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
 void
 rkh_trc_begin(RKH_TE_ID_T eid)
 {
-    chk = 0;            /* Initialize the trace record checksum */
-    RKH_TRC_TE_ID(eid); /* Insert the event ID */
+    /* the sequence number and the timestamp are inserted while merging */
+    laneOpen(getLane(), RKH_TRC_LANE_FULL, eid);
+}
+
+void
+rkh_trc_end(void)
+{
+    laneClose(getLane());
+    RKH_HOOK_PUT_TRCEVT();
+}
+
+void
+rkh_trc_clear_chk(void)
+{
+    laneOpen(getLane(), RKH_TRC_LANE_RAW, 0);
+}
+
+void
+rkh_trc_u8(rui8_t d)
+{
+    lanePut(getLane(), d);
+}
+
+void
+rkh_trc_u16(rui16_t d)
+{
+    TrcLane *lane;
+
+    lane = getLane();
+    lanePut(lane, (rui8_t)d);
+    lanePut(lane, (rui8_t)(d >> 8));
+}
+
+void
+rkh_trc_u32(rui32_t d)
+{
+    TrcLane *lane;
+
+    lane = getLane();
+    lanePut(lane, (rui8_t)d);
+    lanePut(lane, (rui8_t)(d >> 8));
+    lanePut(lane, (rui8_t)(d >> 16));
+    lanePut(lane, (rui8_t)(d >> 24));
+}
+
+void
+rkh_trc_merge(void)
+{
+    TrcLane *lane, *oldest;
+    RKH_TS_T ts, tsOldest;
+    rui16_t pos, size;
+    rui32_t room;
+    rui8_t kind;
+
+    mergeLost();
+    FOREVER
+    {
+        /* looks for the oldest record at the head of the lanes */
+        oldest = (TrcLane *)0;
+        tsOldest = 0;
+        for (lane = lanes; lane < &lanes[RKH_CFG_FWK_MAX_SMA + 1]; ++lane)
+        {
+            if (lane->out != lane->in)
+            {
+                RKH_TRC_MEMBAR();   /* reads the record after its 'in' */
+                ts = (RKH_TS_T)laneLoad(lane, 
+                                        laneNext(lane->out, 
+                                                 RKH_TRC_LANE_HDR - 
+                                                 RKH_TRC_SIZEOF_TS),
+                                        RKH_TRC_SIZEOF_TS);
+                if ((oldest == (TrcLane *)0) || 
+                    RKH_TRC_TS_BEFORE(ts, tsOldest))
+                {
+                    oldest = lane;
+                    tsOldest = ts;
+                }
+            }
+        }
+        if (oldest == (TrcLane *)0)
+        {
+            break;
+        }
+
+        /* 
+         * The worst case escapes every byte of the header, which is longer 
+         * than the sequence number and the checksum, and of the fields. A 
+         * record that never fits is merged into an empty stream anyway.
+         */
+        pos = oldest->out;
+        size = (rui16_t)laneLoad(oldest, pos, 2);
+        kind = (rui8_t)laneLoad(oldest, laneNext(pos, 2), 1);
+        room = (rui32_t)rkh_trc_get_room();
+        if ((room < ((2u * (RKH_TRC_LANE_HDR + size)) + 1u)) &&
+            (room < RKH_CFG_TRC_SIZEOF_STREAM))
+        {
+            break;
+        }
+
+        chk = 0;
+        pos = laneNext(pos, 3);
+        if (kind == RKH_TRC_LANE_FULL)
+        {
+            mergeField(laneLoad(oldest, pos, RKH_TRC_SIZEOF_EID), 
+                       RKH_TRC_SIZEOF_EID);
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+            mergeField(nseq, 1);
+            mergeVarint(tsField(tsOldest, (rbool_t)(nseq == 0)));
+            ++nseq;
+#else
 #if RKH_CFG_TRC_NSEQ_EN == RKH_ENABLED
-    rkh_trc_u8((rui8_t)(nseq)); /* Insert the sequence number */
-    ++nseq;
+            mergeField(nseq, 1);
+            ++nseq;
 #endif
-    RKH_TRC_TSTAMP();   /* Insert the timestamp */
+            mergeField((rui32_t)tsOldest, RKH_TRC_SIZEOF_TS);
+            tsLast = tsOldest;
+#endif
+        }
+        pos = laneNext(pos, RKH_TRC_SIZEOF_EID + RKH_TRC_SIZEOF_TS);
+        for (; size != 0; --size)
+        {
+            mergeField(oldest->stm[pos], 1);
+            pos = laneNext(pos, 1);
+        }
+#if RKH_CFG_TRC_CHK_EN == RKH_ENABLED
+        chk = (rui8_t)(~chk + 1);
+        mergeField(chk, 1);
+#endif
+        rkh_trc_put(RKH_FLG);
+
+        RKH_TRC_MEMBAR();           /* releases the record once read */
+        oldest->out = pos;
+    }
+}
+#else
+void
+rkh_trc_begin(RKH_TE_ID_T eid)
+{
+    if (rkh_trc_get_lost() != lostSent)
+    {
+        putLost();
+    }
+    header(eid);
 }
 
+#if RKH_CFG_TRC_BLOCK_ENC_EN == RKH_ENABLED
+void
+rkh_trc_end(void)
+{
+    TRCQTY_T n;
+
+    n = encode();
+#if RKH_CFG_TRC_CHK_EN == RKH_ENABLED
+    chk = (rui8_t)(~chk + 1);
+    if ((chk == RKH_FLG) || (chk == RKH_ESC))
+    {
+        enc[n++] = RKH_ESC;
+        enc[n++] = (rui8_t)(chk ^ RKH_XOR);
+    }
+    else
+    {
+        enc[n++] = chk;
+    }
+#endif
+    enc[n++] = RKH_FLG;         /* the flag byte is not escaped */
+    rkh_trc_put_block(enc, n);  /* commits the whole record at once */
+    RKH_HOOK_PUT_TRCEVT();
+}
+
+void
+rkh_trc_clear_chk(void)
+{
+    chk = 0;
+    recIn = rec;
+}
+
+void
+rkh_trc_u8(rui8_t d)
+{
+    RKH_TRC_ROOM(1);
+    *recIn++ = d;
+}
+
+void
+rkh_trc_u16(rui16_t d)
+{
+    rui8_t *p;
+
+    RKH_TRC_ROOM(2);
+    p = recIn;
+    recIn = p + 2;
+#if RKH_TRC_WORD_STORE == 1
+    memcpy(p, &d, 2);
+#else
+    p[0] = (rui8_t)d;
+    p[1] = (rui8_t)(d >> 8);
+#endif
+}
+
+void
+rkh_trc_u32(rui32_t d)
+{
+    rui8_t *p;
+
+    RKH_TRC_ROOM(4);
+    p = recIn;
+    recIn = p + 4;
+#if RKH_TRC_WORD_STORE == 1
+    memcpy(p, &d, 4);
+#else
+    p[0] = (rui8_t)d;
+    p[1] = (rui8_t)(d >> 8);
+    p[2] = (rui8_t)(d >> 16);
+    p[3] = (rui8_t)(d >> 24);
+#endif
+}
+#else
 void
 rkh_trc_end(void)
 {
@@ -168,6 +1152,8 @@ rkh_trc_u32(rui32_t d)
     d >>= 8;
     rkh_trc_u8((rui8_t)d);
 }
+#endif
+#endif
 
 void
 rkh_trc_str(const char *s)
@@ -177,49 +1163,82 @@ rkh_trc_str(const char *s)
     rkh_trc_u8('\0');
 }
 
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+void
+rkh_trc_varint(rui32_t d)
+{
+    for (; d > 0x7F; d >>= 7)
+    {
+        rkh_trc_u8((rui8_t)((d & 0x7F) | 0x80));
+    }
+    rkh_trc_u8((rui8_t)d);
+}
+
+void
+rkh_trc_sym(rui32_t sym)
+{
+    rui16_t id;
+
+    /* 
+     * The lookup does not lock, a symbol being interned by another thread 
+     * is sent by its address
+     */
+    id = symFind(sym, RKH_FALSE);
+    rkh_trc_varint(id);
+    if (id == 0)
+    {
+        rkh_trc_varint(sym);
+    }
+}
+#endif
+
 void
 rkh_trc_obj(RKH_TE_ID_T tre, rui8_t *obj, const char *obj_name)
 {
-    RKH_TRC_BEGIN_WOFIL(tre)
-        RKH_TRC_SYM(obj);
-        RKH_TRC_STR(obj_name);
-    RKH_TRC_END_WOFIL()
-    RKH_TRC_FLUSH();
+    putSymbol(tre, 0, (rui32_t)obj, obj_name);
 }
 
 void
 rkh_trc_sig(RKH_SIG_T sig, const char *sig_name)
 {
-    RKH_TRC_BEGIN_WOFIL(RKH_TE_FWK_SIG)
-        RKH_TRC_SIG(sig);
-        RKH_TRC_STR(sig_name);
-    RKH_TRC_END_WOFIL()
-    RKH_TRC_FLUSH();
+    putSymbol(RKH_TE_FWK_SIG, 0, (rui32_t)sig, sig_name);
 }
 
 void
 rkh_trc_ao(void *ao)
 {
-    RKH_TRC_BEGIN_WOFIL(RKH_TE_FWK_AO)
-        RKH_TRC_SYM(ao);
-        RKH_TRC_STR(RKH_GET_AO_NAME((RKH_SMA_T *)ao));
-    RKH_TRC_END_WOFIL()
-    RKH_TRC_FLUSH();
+    putSymbol(RKH_TE_FWK_AO, 0, (rui32_t)ao, 
+              RKH_GET_AO_NAME((RKH_SMA_T *)ao));
 }
 
 void
 rkh_trc_state(void *ao, rui8_t *state)
 {
-    
-    RKH_TRC_BEGIN_WOFIL((CB((state))->type & RKH_REGULAR) == 0 ? 
-                                                        RKH_TE_FWK_PSTATE:
-                                                        RKH_TE_FWK_STATE)
-        RKH_TRC_SYM(ao);
-        RKH_TRC_SYM(state);
-        RKH_TRC_STR(RKH_GET_VERTEX_NAME(state));
-    RKH_TRC_END_WOFIL()
-    RKH_TRC_FLUSH();
+    putSymbol((CB((state))->type & RKH_REGULAR) == 0 ? RKH_TE_FWK_PSTATE :
+                                                       RKH_TE_FWK_STATE,
+              (rui32_t)ao, (rui32_t)state, RKH_GET_VERTEX_NAME(state));
+}
+
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+void
+rkh_trc_symDict(void)
+{
+    rui8_t n;
+    RKH_SR_ALLOC();
+
+    /* from now on, each symbol is sent by its own record */
+    RKH_ENTER_CRITICAL_();
+    dictOpen = RKH_FALSE;
+    n = ndict;
+    RKH_EXIT_CRITICAL_();
+
+    /* a full dictionary is being sent by the caller that filled it */
+    if ((n != 0) && (n < RKH_CFG_TRC_SIZEOF_SYMDICT))
+    {
+        dictSend(n);
+    }
 }
+#endif
 
 #if RKH_CFG_TRC_USER_TRACE_EN == RKH_ENABLED
 void
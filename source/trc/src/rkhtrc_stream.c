@@ -49,6 +49,7 @@
 
 /* --------------------------------- Notes --------------------------------- */
 /* ----------------------------- Include files ----------------------------- */
+#include <string.h>
 #include "rkhtrc_stream.h"
 #include "rkhfwk_bittbl.h"
 #include "rkhassert.h"
@@ -60,23 +61,174 @@
  */
 RKH_MODULE_NAME(rkhtrc_stream)
 
+/* Keeps the header of a mapped stream up to date */
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+#define MAP_HEAD()      (trcmap->head = (rui32_t)(trcin - trcstm))
+#define MAP_TAIL()      (trcmap->tail = (rui32_t)(trcout - trcstm))
+#define MAP_LAP()       (++trcmap->lap)
+#define MAP_LOST()      (trcmap->lost = nlost)
+#else
+#define MAP_HEAD()
+#define MAP_TAIL()
+#define MAP_LAP()
+#define MAP_LOST()
+#endif
+
 /* ------------------------------- Constants ------------------------------- */
 /* ---------------------------- Local data types --------------------------- */
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+static RKH_TRC_MAP_T *trcmap;
+static rui8_t *trcstm;
+#else
 static rui8_t trcstm[RKH_CFG_TRC_SIZEOF_STREAM];
+#endif
 static rui8_t *trcin, *trcout, *trcend;
 static TRCQTY_T trcqty;
+static TRCQTY_T recqty;     /* bytes of the record being written */
+static rui8_t recdrop;      /* the record being written is discarded */
+static rui8_t outsync;      /* the last byte retrieved was a record flag */
+static rui32_t nlost;
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+/*
+ *  Discards the bytes of the record being written, and the following ones 
+ *  until its flag byte is put, which closes it as a lost record.
+ */
+static void
+discard(void)
+{
+    if ((TRCQTY_T)(trcin - trcstm) < recqty)
+    {
+        trcin += RKH_CFG_TRC_SIZEOF_STREAM - recqty;
+    }
+    else
+    {
+        trcin -= recqty;
+    }
+    MAP_HEAD();
+    trcqty -= recqty;
+    recqty = 0;
+    recdrop = 1;
+}
+
+/* Closes the discarded record */
+static void
+lost(void)
+{
+    recdrop = 0;
+    ++nlost;
+    MAP_LOST();
+}
+
+#if RKH_CFG_TRC_OVF_DROP_NEWEST_EN == RKH_DISABLED
+/*
+ *  Removes the oldest record from the trace stream. When a record was 
+ *  partially retrieved its flag byte is kept, so that the trace analyzer 
+ *  receives it as a truncated record instead of joining it to the next one.
+ *  Returns false if there is no complete record to be removed.
+ */
+static rbool_t
+dropOldest(void)
+{
+    rui8_t *p;
+    TRCQTY_T n, ncommit;
+
+    ncommit = (TRCQTY_T)(trcqty - recqty);
+    n = (outsync != 0) ? 0 : 1;
+    for (p = trcout + n; n < ncommit; ++n, ++p)
+    {
+        if (p >= trcend)
+        {
+            p -= RKH_CFG_TRC_SIZEOF_STREAM;
+        }
+        if (*p == RKH_FLG)
+        {
+            break;
+        }
+    }
+    if (n >= ncommit)
+    {
+        return RKH_FALSE;
+    }
+
+    if ((outsync == 0) || (n != 0))     /* the first flag is no record */
+    {
+        ++nlost;
+        MAP_LOST();
+    }
+    if (outsync != 0)
+    {
+        ++n;                        /* the flag byte goes away too */
+    }
+    trcout += n;
+    if (trcout >= trcend)
+    {
+        trcout -= RKH_CFG_TRC_SIZEOF_STREAM;
+    }
+    MAP_TAIL();
+    trcqty -= n;
+    return RKH_TRUE;
+}
+#endif
+
+/*
+ *  Makes room for n bytes of the record being written. Whole records are 
+ *  either admitted or discarded, according to the overflow policy.
+ */
+static rbool_t
+admit(TRCQTY_T n)
+{
+    if (recdrop != 0)
+    {
+        return RKH_FALSE;
+    }
+
+    while ((TRCQTY_T)(RKH_CFG_TRC_SIZEOF_STREAM - trcqty) < n)
+    {
+#if RKH_CFG_TRC_OVF_DROP_NEWEST_EN == RKH_DISABLED
+        if (dropOldest() == RKH_FALSE)
+#endif
+        {
+            discard();
+            return RKH_FALSE;
+        }
+    }
+    return RKH_TRUE;
+}
+
 /* ---------------------------- Global functions --------------------------- */
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+void 
+rkh_trcStream_map(RKH_TRC_MAP_T *map)
+{
+    RKH_REQUIRE(map != (RKH_TRC_MAP_T *)0);
+    trcmap = map;
+    trcstm = map->stream;
+}
+#endif
+
 void 
 rkh_trcStream_init(void)
 {
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    RKH_REQUIRE(trcmap != (RKH_TRC_MAP_T *)0);
+
+    /* the header is valid once its magic number is written */
+    trcmap->magic = 0;
+    trcmap->size = RKH_CFG_TRC_SIZEOF_STREAM;
+    trcmap->head = trcmap->tail = trcmap->lap = trcmap->lost = 0;
+    trcmap->magic = RKH_TRC_MAP_MAGIC;
+#endif
     trcin = trcout = trcstm;
     trcqty = 0;
     trcend = &trcstm[RKH_CFG_TRC_SIZEOF_STREAM];
+    recqty = 0;
+    recdrop = 0;
+    outsync = 1;
+    nlost = 0;
     RKH_TRC_U8_RAW(RKH_FLG);
 }
 
@@ -92,11 +244,17 @@ rkh_trc_get(void)
 
     trByte = trcout++;
     --trcqty;
+    outsync = (rui8_t)(*trByte == RKH_FLG);
+    if (recqty > trcqty)
+    {
+        recqty = trcqty;
+    }
 
     if (trcout >= trcend)
     {
         trcout = trcstm;
     }
+    MAP_TAIL();
 
     return trByte;
 }
@@ -129,11 +287,20 @@ rkh_trc_get_block(TRCQTY_T *nget)
     *nget = n;
     trcout += n;
     trcqty -= n;
+    if (n != (TRCQTY_T)0)
+    {
+        outsync = (rui8_t)(trByte[n - 1] == RKH_FLG);
+        if (recqty > trcqty)
+        {
+            recqty = trcqty;
+        }
+    }
 
     if (trcout >= trcend)
     {
         trcout = trcstm;
     }
+    MAP_TAIL();
 
     return trByte;
 }
@@ -141,19 +308,86 @@ rkh_trc_get_block(TRCQTY_T *nget)
 void 
 rkh_trc_put(rui8_t b)
 {
+    if (((trcqty >= RKH_CFG_TRC_SIZEOF_STREAM) || (recdrop != 0)) &&
+        (admit(1) == RKH_FALSE))
+    {
+        if (b == RKH_FLG)
+        {
+            lost();
+        }
+        return;
+    }
+
     *trcin++ = b;
     ++trcqty;
+    recqty = (b == RKH_FLG) ? 0 : (TRCQTY_T)(recqty + 1);
 
     if (trcin == trcend)
     {
         trcin = trcstm;
+        MAP_LAP();
+    }
+    MAP_HEAD();
+}
+
+void 
+rkh_trc_put_block(const rui8_t *blk, TRCQTY_T n)
+{
+    TRCQTY_T nTail;
+    rbool_t end;
+
+    if (n == (TRCQTY_T)0)
+    {
+        return;
     }
 
-    if (trcqty >= RKH_CFG_TRC_SIZEOF_STREAM)
+    end = (rbool_t)(blk[n - 1] == RKH_FLG);
+    if (((TRCQTY_T)(RKH_CFG_TRC_SIZEOF_STREAM - trcqty) < n) || 
+        (recdrop != 0))
+    {
+        if (admit(n) == RKH_FALSE)
+        {
+            if (end)
+            {
+                lost();
+            }
+            return;
+        }
+    }
+
+    /* at most two runs, before and after wrapping around */
+    nTail = (TRCQTY_T)(trcend - trcin);
+    if (nTail >= n)
+    {
+        memcpy(trcin, blk, n);
+    }
+    else
     {
-        trcqty = RKH_CFG_TRC_SIZEOF_STREAM;
-        trcout = trcin;
+        memcpy(trcin, blk, nTail);
+        memcpy(trcstm, blk + nTail, (size_t)(n - nTail));
     }
+
+    trcin += n;
+    if (trcin >= trcend)
+    {
+        trcin -= RKH_CFG_TRC_SIZEOF_STREAM;
+        MAP_LAP();
+    }
+    MAP_HEAD();
+    trcqty += n;
+    recqty = end ? 0 : (TRCQTY_T)(recqty + n);
+}
+
+TRCQTY_T 
+rkh_trc_get_room(void)
+{
+    return (TRCQTY_T)(RKH_CFG_TRC_SIZEOF_STREAM - trcqty);
+}
+
+rui32_t 
+rkh_trc_get_lost(void)
+{
+    return nlost;
 }
 
 /* ------------------------------ End of file ------------------------------ */
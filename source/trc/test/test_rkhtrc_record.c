@@ -55,6 +55,7 @@
 
 /* --------------------------------- Notes --------------------------------- */
 /* ----------------------------- Include files ----------------------------- */
+#include <string.h>
 #include "unity.h"
 #include "rkhtrc_record.h"
 #include "Mock_rkhsm.h"
@@ -68,6 +69,11 @@
 
 /* ----------------------------- Local macros ------------------------------ */
 /* ------------------------------- Constants ------------------------------- */
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+/* Length of a symbol name, of which two but not three fit into a record */
+#define DICT_NAME_LEN       (RKH_CFG_TRC_SIZEOF_STREAM / 6)
+#endif
+
 /* ---------------------------- Local data types --------------------------- */
 /* ---------------------------- Global variables --------------------------- */
 /* ---------------------------- Local variables ---------------------------- */
@@ -78,9 +84,22 @@ static RKH_EVT_T event;
 static RKH_ST_T state = {{RKH_BASIC, "state"}};
 static RKH_ST_T pseudoState = {{RKH_CHOICE, "pseudoState"}};
 static rui8_t chk;
+static rui32_t nLost;       /* count of lost records of the stream */
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+static rui8_t laneId;
+#endif
 
 /* ----------------------- Local function prototypes ----------------------- */
+static void expectU32(rui32_t value);
+
 /* ---------------------------- Local functions ---------------------------- */
+static rui32_t
+getLost(int cmock_num_calls)
+{
+    (void)cmock_num_calls;
+    return nLost;
+}
+
 static void
 expectU8(rui8_t expectData)
 {
@@ -110,6 +129,9 @@ expectHeader(rui8_t evtId, rui8_t nSeq, rui32_t tStamp, int isCritical)
     expectU8((rui8_t)(tStamp >> 8));
     expectU8((rui8_t)(tStamp >> 16));
     expectU8((rui8_t)(tStamp >> 24));
+#if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+    expectU32(0);       /* most significant word */
+#endif
 }
 
 static void
@@ -165,6 +187,125 @@ expectU16(rui16_t value)
     expectU8((rui8_t)(value >> 8));
 }
 
+static void
+expectNref(RKH_NREF_T value)
+{
+#if RKH_CFG_FWK_SIZEOF_NREF == 32
+    expectU32(value);
+#elif RKH_CFG_FWK_SIZEOF_NREF == 16
+    expectU16(value);
+#else
+    expectU8(value);
+#endif
+}
+
+/* Trace configuration record up to its 16 bits timestamp rate */
+static void
+expectTcfg(rui16_t tsRate, int hasExt)
+{
+    rkh_enter_critical_Expect();
+    expectU8(RKH_TE_FWK_TCFG);
+    expectU16((rui16_t)RKH_VERSION_CODE);
+    expectU32((rui32_t)RKH_CFG_SMA_TRC_SNDR_EN | 
+              ((rui32_t)RKH_CFG_TRC_RTFIL_EN << 1) | 
+              ((rui32_t)RKH_CFG_TRC_USER_TRACE_EN << 2) | 
+              ((rui32_t)RKH_CFG_TRC_ALL_EN << 3) | 
+              ((rui32_t)RKH_CFG_TRC_MP_EN << 4) | 
+              ((rui32_t)RKH_CFG_TRC_QUE_EN << 5) | 
+              ((rui32_t)RKH_CFG_TRC_SMA_EN << 6) | 
+              ((rui32_t)RKH_CFG_TRC_TMR_EN << 7) | 
+              ((rui32_t)RKH_CFG_TRC_SM_EN << 8) | 
+              ((rui32_t)RKH_CFG_TRC_FWK_EN << 9) | 
+              ((rui32_t)RKH_CFG_TRC_ASSERT_EN << 10) | 
+              ((rui32_t)RKH_CFG_QUE_GET_LWMARK_EN << 11) | 
+              ((rui32_t)RKH_CFG_MP_GET_LWM_EN << 12) | 
+              ((rui32_t)RKH_CFG_TRC_RTFIL_SMA_EN << 13) | 
+              ((rui32_t)RKH_CFG_TRC_RTFIL_SIGNAL_EN << 14) | 
+              ((rui32_t)RKH_CFG_TRC_NSEQ_EN << 15) | 
+              ((rui32_t)RKH_CFG_TRC_TSTAMP_EN << 16) | 
+              ((rui32_t)RKH_CFG_TRC_CHK_EN << 17) | 
+              ((rui32_t)hasExt << 18));
+    expectU8((rui8_t)((RKH_CFG_FWK_SIZEOF_EVT / 8 << 4) | 
+                      RKH_CFGPORT_TRC_SIZEOF_TSTAMP / 8));
+    expectU8((rui8_t)((RKH_CFGPORT_TRC_SIZEOF_PTR / 8 << 4) | 
+                      RKH_CFG_TMR_SIZEOF_NTIMER / 8));
+    expectU8((rui8_t)((RKH_CFG_MP_SIZEOF_NBLOCK / 8 << 4) | 
+                      RKH_CFG_QUE_SIZEOF_NELEM / 8));
+    expectU8((rui8_t)(RKH_CFG_FWK_SIZEOF_EVT_SIZE / 8));
+    expectU8((rui8_t)((RKH_CFG_MP_SIZEOF_BSIZE / 8 << 4) | 
+                      RKH_CFG_FWK_MAX_EVT_POOL));
+    expectU16(tsRate);
+}
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+static void
+expectVarint(rui32_t value)
+{
+    for (; value > 0x7F; value >>= 7)
+    {
+        expectU8((rui8_t)((value & 0x7F) | 0x80));
+    }
+    expectU8((rui8_t)value);
+}
+
+static void
+expectCompactHeader(rui8_t evtId, rui8_t nSeq, rui32_t tStamp, 
+                    rui32_t tsField)
+{
+    expectU8(evtId);
+    expectU8(nSeq);
+    rkh_trc_getts_ExpectAndReturn(tStamp);
+    expectVarint(tsField);
+}
+
+/* Interned ID of the first symbol whose slot is not used yet */
+static rui32_t
+firstId(void *obj)
+{
+    return ((((rui32_t)obj * 0x9E3779B1ul) >> 24) & 
+            (RKH_CFG_TRC_SIZEOF_SYMTBL - 1)) + 1;
+}
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+/* Timestamp field of a merged record, see tsField() */
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+#define TS_FIELD(abs_, diff_)   (diff_)
+#else
+#define TS_FIELD(abs_, diff_)   (abs_)
+#endif
+
+rui8_t
+rkh_trc_getLane(void)
+{
+    return laneId;
+}
+
+static void
+expectMergedHeader(rui8_t evtId, rui8_t nSeq, rui32_t tsField)
+{
+    chk = 0;
+    expectU8(evtId);
+    expectU8(nSeq);
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+    expectVarint(tsField);
+#else
+    expectU32(tsField);
+#endif
+}
+
+/* Writes a record of the event evtId holding a byte into the lane ix */
+static void
+putLaneRecord(rui8_t ix, rui8_t evtId, RKH_TS_T tStamp, rui8_t data)
+{
+    laneId = ix;
+    rkh_trc_getts_ExpectAndReturn(tStamp);
+    rkh_trc_begin(evtId);
+    rkh_trc_u8(data);
+    rkh_trc_end();
+}
+#endif
+
 /* ---------------------------- Global functions --------------------------- */
 void
 setUp(void)
@@ -180,12 +321,17 @@ setUp(void)
     Mock_rkhtrc_out_Init();
     Mock_rkhtrc_stream_Init();
     Mock_rkhtrc_filter_Init();
+    nLost = 0;
+    rkh_trc_get_lost_StubWithCallback(getLost);
 
     receiver.sm.romrkh = &base;
     event.e = 3;
     event.pool = 5;
-    event.nref = 7;
+    event.nref = (RKH_NREF_T)0x107;
     chk = 0;
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+    laneId = 0;
+#endif
 }
 
 void
@@ -226,6 +372,9 @@ test_InsertRecordHeader(void)
     rkh_trc_put_Expect(0x45);
     rkh_trc_put_Expect(0x23);
     rkh_trc_put_Expect(0x01);
+#if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+    expectU32(0);
+#endif
 
     rkh_trc_begin(8);
 }
@@ -243,6 +392,30 @@ test_InsertRecordEnd(void)
     rkh_trc_end();
 }
 
+void
+test_InsertLostRecordBeforeHeader(void)
+{
+    nLost = 3;
+    rkh_trc_get_room_ExpectAndReturn(RKH_CFG_TRC_SIZEOF_STREAM);
+    expectHeader(RKH_TE_FWK_TRCLOST, 0, 0x01234567, 0);
+    expectU32(3);
+    expectTrailer(0);
+    chk = 0;
+    expectHeader(8, 1, 0x01234567, 0);
+
+    rkh_trc_begin(8);
+}
+
+void
+test_DeferLostRecordUntilThereIsRoom(void)
+{
+    nLost = 3;
+    rkh_trc_get_room_ExpectAndReturn(0);
+    expectHeader(8, 0, 0x01234567, 0);
+
+    rkh_trc_begin(8);
+}
+
 void
 test_InsertU8Value(void)
 {
@@ -430,7 +603,7 @@ test_InsertSmaGetRecord(void)
     expectObjectAddress(&receiver);
     expectU8(event.e);
     expectU8(event.pool);
-    expectU8(event.nref);
+    expectNref(event.nref);
     expectU8(nElem);
     expectU8(nMin);
     expectTrailer(1);
@@ -452,7 +625,7 @@ test_InsertSmaPostFifoRecord(void)
     expectU8(event.e);
     expectObjectAddress(&sender);
     expectU8(event.pool);
-    expectU8(event.nref);
+    expectNref(event.nref);
     expectU8(nElem);
     expectU8(nMin);
     expectTrailer(0);
@@ -475,7 +648,7 @@ test_InsertSmaPostLifoRecord(void)
     expectU8(event.e);
     expectObjectAddress(&sender);
     expectU8(event.pool);
-    expectU8(event.nref);
+    expectNref(event.nref);
     expectU8(nElem);
     expectU8(nMin);
     expectTrailer(0);
@@ -492,7 +665,7 @@ test_InsertFwkAeRecord(void)
     expectU16(16);
     expectU8(event.e);
     expectU8(event.pool - 1);
-    expectU8(event.nref);
+    expectNref(event.nref);
     expectU8(5);
     expectU8(2);
     expectObjectAddress(&receiver);
@@ -501,6 +674,19 @@ test_InsertFwkAeRecord(void)
     RKH_TR_FWK_AE(16, &event, 5, 2, &receiver);
 }
 
+void
+test_InsertFwkGcRecord(void)
+{
+    rkh_trc_isoff__ExpectAndReturn(RKH_TE_FWK_GC, RKH_TRUE);
+    expectHeader(RKH_TE_FWK_GC, 0, 0x12345678, 0);
+    expectU8(event.e);
+    expectU8(event.pool);
+    expectNref(event.nref);
+    expectTrailer(0);
+
+    RKH_TR_FWK_GC(&event, event.pool, event.nref);
+}
+
 void
 test_InsertFwkGcrRecord(void)
 {
@@ -508,7 +694,43 @@ test_InsertFwkGcrRecord(void)
     expectHeader(RKH_TE_FWK_GCR, 0, 0x12345678, 0);
     expectU8(event.e);
     expectU8(event.pool - 1);
-    expectU8(event.nref);
+    expectNref(event.nref);
+    expectU8(5);
+    expectU8(2);
+    expectObjectAddress(&receiver);
+    expectTrailer(0);
+
+    RKH_TR_FWK_GCR(&event, 5, 2, &receiver);
+}
+
+#if RKH_CFG_FWK_BUF_EN == RKH_ENABLED
+void
+test_InsertFwkAeRecordOfBufEvtWithoutItsFlag(void)
+{
+    event.pool |= RKH_BUFEVT_FLAG;
+    rkh_trc_isoff__ExpectAndReturn(RKH_TE_FWK_AE, RKH_TRUE);
+    expectHeader(RKH_TE_FWK_AE, 0, 0x12345678, 1);
+    expectU16(16);
+    expectU8(event.e);
+    expectU8(4);
+    expectNref(event.nref);
+    expectU8(5);
+    expectU8(2);
+    expectObjectAddress(&receiver);
+    expectTrailer(1);
+
+    RKH_TR_FWK_AE(16, &event, 5, 2, &receiver);
+}
+
+void
+test_InsertFwkGcrRecordOfBufEvtWithoutItsFlag(void)
+{
+    event.pool |= RKH_BUFEVT_FLAG;
+    rkh_trc_isoff__ExpectAndReturn(RKH_TE_FWK_GCR, RKH_TRUE);
+    expectHeader(RKH_TE_FWK_GCR, 0, 0x12345678, 0);
+    expectU8(event.e);
+    expectU8(4);
+    expectNref(event.nref);
     expectU8(5);
     expectU8(2);
     expectObjectAddress(&receiver);
@@ -516,6 +738,7 @@ test_InsertFwkGcrRecord(void)
 
     RKH_TR_FWK_GCR(&event, 5, 2, &receiver);
 }
+#endif
 
 void
 test_InsertFwkEpregRecord(void)
@@ -574,6 +797,411 @@ test_InsertDispatchRecordWithInvalidSignal(void)
     RKH_TR_SM_DCH(&receiver, &event, &state);
 }
 
+void
+test_InsertTcfgRecord(void)
+{
+#if RKH_CFG_FWK_SIZEOF_NREF == 8
+    expectTcfg(1000, 0);
+#else
+    expectTcfg(1000, 1);
+    expectU8(RKH_TRC_TCFG_VERSION);
+    expectU8(RKH_CFG_FWK_SIZEOF_NREF / 8);
+    expectU32(1000);
+    expectU32(0);
+#endif
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+
+    RKH_TR_FWK_TCFG(1000);
+}
+
+void
+test_InsertTcfgRecordWithWideRate(void)
+{
+    expectTcfg(0, 1);
+    expectU8(RKH_TRC_TCFG_VERSION);
+    expectU8(RKH_CFG_FWK_SIZEOF_NREF / 8);
+    expectU32(1000000000);
+    expectU32(0);
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+
+    RKH_TR_FWK_TCFG(1000000000ul);
+}
+
+void
+test_InsertTcfgRecordWithRateAbove32Bits(void)
+{
+    expectTcfg(0, 1);
+    expectU8(RKH_TRC_TCFG_VERSION);
+    expectU8(RKH_CFG_FWK_SIZEOF_NREF / 8);
+    expectU32(0x2A05F200);
+    expectU32(1);
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+
+    RKH_TR_FWK_TCFG((rui64_t)5000000000ull);
+}
+
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+void
+test_InsertVarint(void)
+{
+    rkh_trc_put_Expect(0xAC);
+    rkh_trc_put_Expect(0x02);
+    rkh_trc_put_Expect(0x7F);
+
+    rkh_trc_varint(300);
+    rkh_trc_varint(0x7F);
+}
+
+void
+test_InsertTimestampDifference(void)
+{
+    expectCompactHeader(8, 0, 0x01234567, 0x01234567);
+    expectCompactHeader(8, 1, 0x01234570, 9);
+    expectCompactHeader(8, 2, 0x01234560, 0xFFFFFFF0);
+
+    rkh_trc_begin(8);
+    rkh_trc_begin(8);
+    rkh_trc_begin(8);
+}
+
+void
+test_InsertAbsoluteTimestampInLostRecord(void)
+{
+    expectCompactHeader(8, 0, 1000, 1000);
+    rkh_trc_begin(8);
+
+    nLost = 3;
+    rkh_trc_get_room_ExpectAndReturn(RKH_CFG_TRC_SIZEOF_STREAM);
+    chk = 0;
+    expectCompactHeader(RKH_TE_FWK_TRCLOST, 1, 2000, 2000);
+    expectU32(3);
+    expectTrailer(0);
+    chk = 0;
+    expectCompactHeader(8, 2, 2005, 5);
+
+    rkh_trc_begin(8);
+}
+
+void
+test_InsertInternedSymbol(void)
+{
+    rui8_t obj;
+    rui32_t id;
+
+    id = firstId(&obj);
+    rkh_enter_critical_Expect();
+    expectCompactHeader(RKH_TE_FWK_OBJ, 0, 100, 100);
+    expectVarint(id);
+    expectVarint((rui32_t)&obj);
+    expectString("obj");
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+    rkh_trc_obj(RKH_TE_FWK_OBJ, &obj, "obj");
+
+    chk = 0;
+    expectVarint(id);
+    rkh_trc_sym((rui32_t)&obj);
+}
+
+void
+test_InsertSymbolWithoutIdByAddress(void)
+{
+    rui8_t obj;
+
+    expectVarint(0);
+    expectVarint((rui32_t)&obj);
+
+    rkh_trc_sym((rui32_t)&obj);
+}
+
+void
+test_InsertSignalAsVarint(void)
+{
+    rkh_enter_critical_Expect();
+    expectCompactHeader(RKH_TE_FWK_SIG, 0, 100, 100);
+    expectVarint(200);
+    expectString("sig");
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+
+    rkh_trc_sig(200, "sig");
+}
+#endif
+
+#if RKH_CFGPORT_TRC_SIZEOF_TSTAMP == 64
+#if RKH_CFG_TRC_COMPACT_EN == RKH_DISABLED
+void
+test_InsertWideTimestamp(void)
+{
+    rkh_trc_put_Expect(8);
+    rkh_trc_put_Expect(0);
+    rkh_trc_getts_ExpectAndReturn(0x0123456789ABCDEFull);
+    expectU32(0x89ABCDEF);
+    expectU32(0x01234567);
+
+    rkh_trc_begin(8);
+}
+#else
+void
+test_InsertWideTimestampAsVarint(void)
+{
+    RKH_TS_T ts;
+
+    expectU8(8);
+    expectU8(0);
+    rkh_trc_getts_ExpectAndReturn(0x0123456789ABCDEFull);
+    for (ts = 0x0123456789ABCDEFull; ts > 0x7F; ts >>= 7)
+    {
+        expectU8((rui8_t)((ts & 0x7F) | 0x80));
+    }
+    expectU8((rui8_t)ts);
+    expectU8(8);
+    expectU8(1);
+    rkh_trc_getts_ExpectAndReturn(0x0123456789ABCDF4ull);
+    expectU8(5);
+
+    rkh_trc_begin(8);
+    rkh_trc_begin(8);
+}
+#endif
+#endif
+
+#if RKH_CFG_TRC_LOCAL_EN == RKH_ENABLED
+void
+test_MergeLanesInTimestampOrder(void)
+{
+    putLaneRecord(0, 8, 200, 0x11);
+    putLaneRecord(1, 9, 100, 0x22);
+
+    rkh_trc_get_room_IgnoreAndReturn(RKH_CFG_TRC_SIZEOF_STREAM);
+    expectMergedHeader(9, 0, 100);
+    expectU8(0x22);
+    expectTrailer(0);
+    expectMergedHeader(8, 1, TS_FIELD(200, 100));
+    expectU8(0x11);
+    expectTrailer(0);
+
+    rkh_trc_merge();
+}
+
+void
+test_MergeSharedLaneUnderCriticalSection(void)
+{
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    putLaneRecord(RKH_TRC_NO_LANE, 8, 100, 0x11);
+
+    rkh_trc_get_room_IgnoreAndReturn(RKH_CFG_TRC_SIZEOF_STREAM);
+    expectMergedHeader(8, 0, 100);
+    expectU8(0x11);
+    expectTrailer(0);
+
+    rkh_trc_merge();
+}
+
+void
+test_MergeKeepsRecordsUntilThereIsRoom(void)
+{
+    putLaneRecord(0, 8, 100, 0x11);
+
+    rkh_trc_get_room_ExpectAndReturn(4);
+    rkh_trc_merge();
+
+    rkh_trc_get_room_ExpectAndReturn(RKH_CFG_TRC_SIZEOF_STREAM);
+    expectMergedHeader(8, 0, 100);
+    expectU8(0x11);
+    expectTrailer(0);
+    rkh_trc_merge();
+}
+
+void
+test_MergeLostRecordWithLastMergedTimestamp(void)
+{
+    int i;
+
+    rkh_trc_get_room_IgnoreAndReturn(RKH_CFG_TRC_SIZEOF_STREAM);
+    putLaneRecord(0, 8, 100, 0x11);
+    expectMergedHeader(8, 0, 100);
+    expectU8(0x11);
+    expectTrailer(0);
+    rkh_trc_merge();
+
+    /* the lane 0 drops a record, then an older one is written in lane 1 */
+    rkh_trc_getts_ExpectAndReturn(500);
+    rkh_trc_begin(8);
+    for (i = 0; i <= RKH_CFG_TRC_SIZEOF_LOCAL_STREAM; ++i)
+    {
+        rkh_trc_u8(0x11);
+    }
+    rkh_trc_end();
+    putLaneRecord(1, 9, 150, 0x22);
+
+    /* 
+     * The report carries the timestamp of the last merged record, which 
+     * is still the base of the next difference
+     */
+    expectMergedHeader(RKH_TE_FWK_TRCLOST, 1, 100);
+    expectU32(1);
+    expectTrailer(0);
+    expectMergedHeader(9, 2, TS_FIELD(150, 50));
+    expectU8(0x22);
+    expectTrailer(0);
+    rkh_trc_merge();
+}
+#endif
+
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+void
+test_CollectSymbolsIntoDictionary(void)
+{
+    rui8_t obj;
+
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_trc_obj(RKH_TE_FWK_OBJ, &obj, "obj");
+    rkh_trc_sig(8, "sig");
+
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    expectHeader(RKH_TE_FWK_SYMDICT, 0, 0x12345678, 1);
+    expectU8(RKH_TE_FWK_OBJ);
+    expectObjectAddress(&obj);
+    expectString("obj");
+    expectU8(RKH_TE_FWK_SIG);
+    expectU8(8);
+    expectString("sig");
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+
+    rkh_trc_symDict();
+}
+
+void
+test_SendFullDictionaryInRecordsThatFitTheStream(void)
+{
+    rui8_t obj;
+    char name[DICT_NAME_LEN + 1];
+    int i, nRecords;
+
+    memset(name, 'a', DICT_NAME_LEN);
+    name[DICT_NAME_LEN] = '\0';
+    for (i = 0; i < RKH_CFG_TRC_SIZEOF_SYMDICT; ++i)
+    {
+        rkh_enter_critical_Expect();
+        rkh_exit_critical_Expect();
+    }
+
+    /* two symbols fit into each record, see DICT_NAME_LEN */
+    nRecords = RKH_CFG_TRC_SIZEOF_SYMDICT / 2;
+    for (i = 0; i < nRecords; ++i)
+    {
+        chk = 0;
+        expectHeader(RKH_TE_FWK_SYMDICT, (rui8_t)i, 0x12345678, 1);
+        expectU8(RKH_TE_FWK_OBJ);
+        expectObjectAddress(&obj);
+        expectString(name);
+        expectU8(RKH_TE_FWK_OBJ);
+        expectObjectAddress(&obj);
+        expectString(name);
+        expectTrailer(1);
+    }
+    rkh_trc_flush_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+
+    for (i = 0; i < RKH_CFG_TRC_SIZEOF_SYMDICT; ++i)
+    {
+        rkh_trc_obj(RKH_TE_FWK_OBJ, &obj, name);
+    }
+}
+
+void
+test_SendSymbolLongerThanRecordBudgetAlone(void)
+{
+    rui8_t obj;
+    char name[(RKH_CFG_TRC_SIZEOF_STREAM / 2) + 1];
+
+    memset(name, 'a', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_trc_obj(RKH_TE_FWK_OBJ, &obj, "obj");
+    rkh_trc_obj(RKH_TE_FWK_OBJ, &obj, name);
+
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    expectHeader(RKH_TE_FWK_SYMDICT, 0, 0x12345678, 1);
+    expectU8(RKH_TE_FWK_OBJ);
+    expectObjectAddress(&obj);
+    expectString("obj");
+    expectTrailer(1);
+    chk = 0;
+    expectHeader(RKH_TE_FWK_SYMDICT, 1, 0x12345678, 1);
+    expectU8(RKH_TE_FWK_OBJ);
+    expectObjectAddress(&obj);
+    expectString(name);
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+
+    rkh_trc_symDict();
+}
+
+void
+test_SendSymbolByItsRecordAfterDictionary(void)
+{
+    rui8_t obj;
+
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    rkh_trc_symDict();
+
+    rkh_enter_critical_Expect();
+    rkh_exit_critical_Expect();
+    expectHeader(RKH_TE_FWK_OBJ, 0, 0x12345678, 1);
+    expectObjectAddress(&obj);
+    expectString("obj");
+    expectTrailer(1);
+    rkh_trc_flush_Expect();
+
+    rkh_trc_obj(RKH_TE_FWK_OBJ, &obj, "obj");
+}
+#endif
+
+#if RKH_CFG_TRC_PROFILE_EN == RKH_ENABLED
+void
+test_LeaveOutRecordByProfile(void)
+{
+    RKH_TR_SM_TRN(&receiver, &state, &state);
+    RKH_TR_SMA_LIFO(&receiver, &event, &sender, event.pool, event.nref, 
+                    2, 1);
+}
+
+void
+test_KeepRecordOfProfileGroup(void)
+{
+    rkh_trc_isoff__ExpectAndReturn(RKH_TE_FWK_EPREG, RKH_TRUE);
+    expectHeader(RKH_TE_FWK_EPREG, 0, 0x12345678, 1);
+    expectU8(1);
+    expectU32(128);
+    expectU16(32);
+    expectU8(4);
+    expectTrailer(1);
+
+    RKH_TR_FWK_EPREG(1, 128, 32, 4);
+}
+#endif
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -71,13 +71,28 @@ static RKH_SMA_T sender;
 static RKH_EVT_T event;
 static RKH_ST_T state = {{RKH_BASIC, "state"}};
 static RKH_ST_T pseudoState = {{RKH_CHOICE, "pseudoState"}};
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+static RKH_TRC_MAP_T map;
+#endif
 
 /* ----------------------- Local function prototypes ----------------------- */
 /* ---------------------------- Local functions ---------------------------- */
+static void
+putRecord(const rui8_t *record, int size)
+{
+    while (size-- > 0)
+    {
+        rkh_trc_put(*record++);
+    }
+}
+
 /* ---------------------------- Global functions --------------------------- */
 void
 setUp(void)
 {
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+    rkh_trcStream_map(&map);
+#endif
     rkh_trcStream_init();
 }
 
@@ -166,11 +181,15 @@ test_IsFull(void)
     int i;
     TRCQTY_T nData = RKH_CFG_TRC_SIZEOF_STREAM + 1;
 
-    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+    /* a record that takes the room left by the initial flag */
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 2); i++)
         rkh_trc_put((rui8_t)i);
+    rkh_trc_put(RKH_FLG);
 
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_room());
     rkh_trc_get_block(&nData);
     TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM, nData);    
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_lost());
 }
 
 void
@@ -179,17 +198,16 @@ test_EmptyToFullToEmpty(void)
     int i;
     TRCQTY_T nData = RKH_CFG_TRC_SIZEOF_STREAM + 1;
 
-    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 2); i++)
         rkh_trc_put((rui8_t)i);
+    rkh_trc_put(RKH_FLG);
 
     rkh_trc_get_block(&nData);
     TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM, nData);    
 
-    for (i = 0; i < RKH_CFG_TRC_SIZEOF_STREAM; i++)
-        rkh_trc_get();
-
     rkh_trc_get_block(&nData);
     TEST_ASSERT_EQUAL(0, nData);
+    TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM, rkh_trc_get_room());
 }
 
 void
@@ -198,19 +216,29 @@ test_WrapAround(void)
     int i;
     rui8_t *output;
 
-    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+    /* moves both ends to the middle of the stream */
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM / 2); i++)
         rkh_trc_put((rui8_t)i);
+    for (i = 0; i <= (RKH_CFG_TRC_SIZEOF_STREAM / 2); i++)
+        rkh_trc_get();
 
-    rkh_trc_get();
-    rkh_trc_put(128);
+    /* a record that wraps around and fills the stream */
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+        rkh_trc_put((rui8_t)i);
+    rkh_trc_put(RKH_FLG);
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_room());
 
-    for (i = 0; i < RKH_CFG_TRC_SIZEOF_STREAM; i++)
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
     {
         output = rkh_trc_get();
         TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_EQUAL((rui8_t)i, *output);
     }
-
-    TEST_ASSERT_EQUAL(128, *output);    
+    output = rkh_trc_get();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(RKH_FLG, *output);
+    TEST_ASSERT_NULL(rkh_trc_get());
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_lost());
 }
 
 void
@@ -240,6 +268,274 @@ test_GetContinuousBlock(void)
         TEST_ASSERT_EQUAL((rui8_t)i, *output);
 }
 
+void
+test_PutBlock(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t block[] = {1, 2, 3, 4};
+
+    rkh_trc_get();
+    rkh_trc_put_block(block, sizeof(block));
+
+    for (i = 0; i < (int)sizeof(block); i++)
+    {
+        output = rkh_trc_get();
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_EQUAL(block[i], *output);
+    }
+    TEST_ASSERT_NULL(rkh_trc_get());
+}
+
+void
+test_PutBlockWrapAround(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t block[] = {128, 129, 130};
+
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 2); i++)
+        rkh_trc_put((rui8_t)i);
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+        rkh_trc_get();
+
+    rkh_trc_put_block(block, sizeof(block));
+
+    for (i = 0; i < (int)sizeof(block); i++)
+    {
+        output = rkh_trc_get();
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_EQUAL(block[i], *output);
+    }
+    TEST_ASSERT_NULL(rkh_trc_get());
+}
+
+void
+test_RoomDecreasesUntilFull(void)
+{
+    int i;
+
+    TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM - 1, rkh_trc_get_room());
+
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+        rkh_trc_put((rui8_t)i);
+
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_room());
+    rkh_trc_get();
+    TEST_ASSERT_EQUAL(1, rkh_trc_get_room());
+}
+
+void
+test_RecordLongerThanStreamIsLost(void)
+{
+    int i;
+
+    rkh_trc_get();
+    for (i = 0; i < RKH_CFG_TRC_SIZEOF_STREAM; i++)
+        rkh_trc_put(1);
+    rkh_trc_put(RKH_FLG);
+
+    TEST_ASSERT_NULL(rkh_trc_get());
+    TEST_ASSERT_EQUAL(1, rkh_trc_get_lost());
+}
+
+void
+test_DiscardedRecordDoesNotJoinNextOne(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t record[] = {7, 8, RKH_FLG};
+
+    rkh_trc_get();
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM + 5); i++)
+        rkh_trc_put(1);
+    TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM, rkh_trc_get_room());
+    rkh_trc_put(RKH_FLG);   /* closes the discarded record */
+
+    putRecord(record, sizeof(record));
+
+    TEST_ASSERT_EQUAL(1, rkh_trc_get_lost());
+    for (i = 0; i < (int)sizeof(record); i++)
+    {
+        output = rkh_trc_get();
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_EQUAL(record[i], *output);
+    }
+    TEST_ASSERT_NULL(rkh_trc_get());
+}
+
+void
+test_DiscardsRecordInProgressWhenNoRecordCanBeRemoved(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t record[] = {1, 2, 3, RKH_FLG};
+
+    /* a retrieved record and a long one still in progress */
+    putRecord(record, sizeof(record));
+    for (i = 0; i < (int)sizeof(record) + 1; i++)
+        rkh_trc_get();
+    for (i = 0; i < RKH_CFG_TRC_SIZEOF_STREAM; i++)
+        rkh_trc_put(9);
+    rkh_trc_put(RKH_FLG);
+
+    TEST_ASSERT_EQUAL(1, rkh_trc_get_lost());
+    TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM, rkh_trc_get_room());
+
+    putRecord(record, sizeof(record));
+    output = rkh_trc_get();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(record[0], *output);
+}
+
+#if RKH_CFG_TRC_OVF_DROP_NEWEST_EN == RKH_DISABLED
+void
+test_OverflowRemovesOldestRecords(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t record[] = {1, 2, 3, RKH_FLG};
+    rui8_t newest[] = {4, 5, 6, 7, 8, RKH_FLG};
+
+    rkh_trc_get();
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM / sizeof(record)); i++)
+        rkh_trc_put_block(record, sizeof(record));
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_room());
+
+    rkh_trc_put_block(newest, sizeof(newest));
+
+    TEST_ASSERT_EQUAL(2, rkh_trc_get_lost());
+    TEST_ASSERT_EQUAL(2, rkh_trc_get_room());
+    for (i = 0; i < (int)sizeof(record); i++)
+    {
+        output = rkh_trc_get();
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_EQUAL(record[i], *output);
+    }
+}
+
+void
+test_OverflowKeepsFlagOfPartiallyRetrievedRecord(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t record[] = {1, 2, 3, RKH_FLG};
+
+    rkh_trc_get();
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM / sizeof(record)); i++)
+        rkh_trc_put_block(record, sizeof(record));
+    rkh_trc_get();      /* retrieves a piece of the oldest record */
+
+    rkh_trc_put_block(record, sizeof(record));
+
+    /* the retrieved record is truncated and the next one is removed */
+    TEST_ASSERT_EQUAL(2, rkh_trc_get_lost());
+    output = rkh_trc_get();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(RKH_FLG, *output);
+    output = rkh_trc_get();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(record[0], *output);
+}
+#else
+void
+test_OverflowDropsNewestRecord(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t record[] = {1, 2, 3, RKH_FLG};
+
+    rkh_trc_get();
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM / sizeof(record)); i++)
+        rkh_trc_put_block(record, sizeof(record));
+
+    rkh_trc_put(9);
+    rkh_trc_put(RKH_FLG);
+
+    TEST_ASSERT_EQUAL(1, rkh_trc_get_lost());
+    TEST_ASSERT_EQUAL(0, rkh_trc_get_room());
+    output = rkh_trc_get();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(record[0], *output);
+}
+
+void
+test_OverflowKeepsRecordsAfterDroppingNewest(void)
+{
+    int i;
+    rui8_t *output;
+    rui8_t record[] = {1, 2, 3, RKH_FLG};
+    rui8_t next[] = {4, RKH_FLG};
+
+    rkh_trc_get();
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM / sizeof(record)); i++)
+        putRecord(record, sizeof(record));
+    putRecord(next, sizeof(next));
+    for (i = 0; i < (int)sizeof(record); i++)
+        rkh_trc_get();
+
+    /* there is room again, the next record is not discarded */
+    putRecord(next, sizeof(next));
+
+    TEST_ASSERT_EQUAL(1, rkh_trc_get_lost());
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - sizeof(record)); i++)
+        rkh_trc_get();
+    for (i = 0; i < (int)sizeof(next); i++)
+    {
+        output = rkh_trc_get();
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_EQUAL(next[i], *output);
+    }
+    TEST_ASSERT_NULL(rkh_trc_get());
+}
+#endif
+
+#if RKH_CFG_TRC_STREAM_MAP_EN == RKH_ENABLED
+void
+test_MapHeaderAfterInit(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(RKH_TRC_MAP_MAGIC, map.magic);
+    TEST_ASSERT_EQUAL(RKH_CFG_TRC_SIZEOF_STREAM, map.size);
+    TEST_ASSERT_EQUAL(1, map.head);
+    TEST_ASSERT_EQUAL(0, map.tail);
+    TEST_ASSERT_EQUAL(0, map.lap);
+    TEST_ASSERT_EQUAL(RKH_FLG, map.stream[0]);
+}
+
+void
+test_MapKeepsHeadAndTail(void)
+{
+    rui8_t block[] = {1, 2, 3, RKH_FLG};
+
+    rkh_trc_get();
+    rkh_trc_put_block(block, sizeof(block));
+    rkh_trc_get();
+
+    TEST_ASSERT_EQUAL(1 + sizeof(block), map.head);
+    TEST_ASSERT_EQUAL(2, map.tail);
+    TEST_ASSERT_EQUAL(block[0], map.stream[1]);
+}
+
+void
+test_MapCountsLaps(void)
+{
+    int i;
+
+    for (i = 0; i < (RKH_CFG_TRC_SIZEOF_STREAM - 1); i++)
+    {
+        rkh_trc_put((rui8_t)i);
+    }
+    TEST_ASSERT_EQUAL(0, map.head);
+    TEST_ASSERT_EQUAL(1, map.lap);
+
+    rkh_trc_get();
+    rkh_trc_put(RKH_FLG);
+    TEST_ASSERT_EQUAL(1, map.head);
+    TEST_ASSERT_EQUAL(1, map.tail);
+    TEST_ASSERT_EQUAL(RKH_FLG, map.stream[0]);
+}
+#endif
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
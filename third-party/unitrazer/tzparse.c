@@ -23,7 +23,11 @@ static char fmt[1024];
 static rui8_t state = PARSER_WFLAG;
 static unsigned char tr[PARSER_MAX_SIZE_BUF], *ptr, trix;
 static char symstr[16];
-static unsigned long curr_tstamp;
+static RKH_TS_T curr_tstamp;
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+static unsigned long symtbl[RKH_CFG_TRC_SIZEOF_SYMTBL + 1];
+static rbool_t tsvalid;     /* curr_tstamp is known */
+#endif
 
 #define start_assemble()    \
     {                   \
@@ -55,6 +59,138 @@ assemble_str(void)
     return symstr;
 }
 
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+static
+unsigned long
+assemble_varint(void)
+{
+    int sh;
+    unsigned long d;
+
+    for (d = 0, sh = 0; *trb & 0x80; sh += 7)
+        d |= (unsigned long)(*trb++ & 0x7F) << sh;
+    d |= (unsigned long)*trb++ << sh;
+    return d;
+}
+
+#if RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED
+/* 
+ * The timestamp could be wider than unsigned long, its sum wraps around 
+ * as RKH_TS_T does
+ */
+static
+RKH_TS_T
+assemble_tsvarint(void)
+{
+    int sh;
+    RKH_TS_T d;
+
+    for (d = 0, sh = 0; *trb & 0x80; sh += 7)
+        d |= (RKH_TS_T)(*trb++ & 0x7F) << sh;
+    d |= (RKH_TS_T)*trb++ << sh;
+    return d;
+}
+#endif
+
+/*
+ *  The timestamp is the difference from the previous record, except in the 
+ *  records whose sequence number is 0 and in RKH_TE_FWK_TRCLOST, which 
+ *  carry the absolute one. It is unknown from a missing record, detected 
+ *  by a gap in the sequence numbers, up to the next absolute one.
+ */
+static
+void
+assemble_header(void)
+{
+    rui8_t nseq;
+#if RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED
+    RKH_TS_T d;
+#endif
+
+    start_assemble();
+    nseq = (rui8_t)assemble(1);
+    if (nseq != (rui8_t)(lastnseq + 1))
+        tsvalid = RKH_FALSE;
+    lastnseq = nseq;
+#if RKH_CFG_TRC_TSTAMP_EN == RKH_ENABLED
+    d = assemble_tsvarint();
+    if ((nseq == 0) || (tr[0] == RKH_TE_FWK_TRCLOST))
+    {
+        curr_tstamp = d;
+        tsvalid = RKH_TRUE;
+    }
+    else if (tsvalid)
+    {
+        curr_tstamp = (RKH_TS_T)(curr_tstamp + d);
+    }
+#endif
+}
+
+/* Address of an object, which is sent by its interned ID if it has one */
+static
+unsigned long
+assemble_sym(void)
+{
+    unsigned long id;
+
+    id = assemble_varint();
+    if ((id == 0) || (id > RKH_CFG_TRC_SIZEOF_SYMTBL))
+        return assemble_varint();
+    return symtbl[id];
+}
+
+/* The symbol records carry the interned ID followed by the address */
+static
+void
+assemble_symdef(void)
+{
+    unsigned long id;
+
+    id = assemble_varint();
+    if (id <= RKH_CFG_TRC_SIZEOF_SYMTBL)
+        symtbl[id] = assemble_varint();
+}
+
+/* Arguments of the symbol record eid, which are followed by its name */
+static
+void
+assemble_symbol(rui8_t eid)
+{
+    switch (eid)
+    {
+        case RKH_TE_FWK_SIG:
+            (void)assemble_varint();
+            break;
+        case RKH_TE_FWK_STATE:
+        case RKH_TE_FWK_PSTATE:
+            (void)assemble_sym();
+            assemble_symdef();
+            break;
+        default:
+            assemble_symdef();
+            break;
+    }
+}
+
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+/* Each entry of the dictionary is a symbol record without its header */
+static
+void
+assemble_symdict(void)
+{
+    rui8_t eid;
+
+    while (trb < tr + trix - 1)
+    {
+        eid = *trb++;
+        assemble_symbol(eid);
+        while (*trb++ != '\0')
+            ;
+    }
+}
+#endif
+#endif
+
 static
 void
 parser_init(void)
@@ -131,8 +267,31 @@ parser(UtrzProcessOut *p)
         case RKH_TE_UT_SUCCESS:
             utSuccess(p);
             break;
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+        case RKH_TE_FWK_STATE:
+        case RKH_TE_FWK_PSTATE:
+        case RKH_TE_FWK_OBJ:
+        case RKH_TE_FWK_FUN:
+        case RKH_TE_FWK_AO:
+        case RKH_TE_FWK_TIMER:
+        case RKH_TE_FWK_QUEUE:
+        case RKH_TE_FWK_ACTOR:
+            assemble_header();
+            assemble_symbol(tr[0]);
+            break;
+#if RKH_CFG_TRC_SYMDICT_EN == RKH_ENABLED
+        case RKH_TE_FWK_SYMDICT:
+            assemble_header();
+            assemble_symdict();
+            break;
+#endif
+        default:
+            assemble_header();
+            break;
+#else
         default:
             break;
+#endif
     }
 }
 
@@ -140,6 +299,9 @@ void
 trazer_init(void)
 {
     parser_init();
+#if RKH_CFG_TRC_COMPACT_EN == RKH_ENABLED
+    tsvalid = RKH_FALSE;
+#endif
     state = PARSER_COLLECT;
 }
 